@@ -36,7 +36,6 @@ typedef struct ParserRes
 typedef struct MsgRes
 {
    FIXMsg* msg;
-   pthread_rwlock_t* lock;
 } MsgRes;
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
@@ -65,9 +64,7 @@ static void free_fix_parser(ErlNifEnv* env, void* obj)
 static void free_fix_msg(ErlNifEnv* env, void* obj)
 {
    MsgRes* msgRes = (MsgRes*)obj;
-   pthread_rwlock_wrlock(msgRes->lock);
-   fix_msg_free(msgRes->msg);
-   pthread_rwlock_unlock(msgRes->lock);
+   fix_msg_free(msgRes->msg); // parser pools are thread safe, so parser lock is not needed
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
@@ -333,9 +330,7 @@ static ERL_NIF_TERM create_msg(ErlNifEnv* env, int32_t argc, ERL_NIF_TERM const
       return make_error(env, FIX_FAILED, "Wrong msgType.");
    }
    FIXError* error = NULL;
-   pthread_rwlock_wrlock(&parser->lock);
    FIXMsg* msg = fix_msg_create(parser->ptr, msgType, &error);
-   pthread_rwlock_unlock(&parser->lock);
    if (!msg)
    {
       ERL_NIF_TERM ret = make_parser_error(env, fix_error_get_code(error), fix_error_get_text(error));
@@ -344,7 +339,6 @@ static ERL_NIF_TERM create_msg(ErlNifEnv* env, int32_t argc, ERL_NIF_TERM const
    }
    MsgRes* msg_res = (MsgRes*)enif_alloc_resource(message_res, sizeof(MsgRes));
    msg_res->msg = msg;
-   msg_res->lock = &parser->lock;
    ERL_NIF_TERM msg_term = enif_make_resource(env, msg_res);
    enif_release_resource(msg_res);
    return enif_make_tuple2(
@@ -1000,9 +994,7 @@ static ERL_NIF_TERM binary_to_msg(ErlNifEnv* env, int32_t argc, ERL_NIF_TERM con
    }
    char const* stop = NULL;
    FIXError* error = NULL;
-   pthread_rwlock_wrlock(&parser->lock);
    FIXMsg* fix_msg = fix_parser_str_to_msg(parser->ptr, (char const*)bin.data, bin.size, delimiter, &stop, &error);
-   pthread_rwlock_unlock(&parser->lock);
    if (!fix_msg)
    {
       ERL_NIF_TERM ret = make_parser_error(env, fix_error_get_code(error), fix_error_get_text(error));
@@ -1011,7 +1003,6 @@ static ERL_NIF_TERM binary_to_msg(ErlNifEnv* env, int32_t argc, ERL_NIF_TERM con
    }
    MsgRes* msg_res = (MsgRes*)enif_alloc_resource(message_res, sizeof(MsgRes));
    msg_res->msg = fix_msg;
-   msg_res->lock = &parser->lock;
    ERL_NIF_TERM msg_term = enif_make_resource(env, msg_res);
    enif_release_resource(msg_res);
    uint32_t pos = stop - (char const*)bin.data + 1;
@@ -0,0 +1,52 @@
+/**
+ * @file   fix_compiler.c
+ * @author Dmitry S. Melnikov, dmitryme@gmail.com
+ * @date   Created on: 10/16/2026 07:02:11 PM
+ *
+ * compiles FIX protocol XML description (with its transport description) into binary image, which is loaded by
+ * fix_parser_create_from_image, or into C source with static description tables
+ */
+
+#include "fix_parser.h"
+#include "fix_error.h"
+#include "fix_source_gen.h"
+
+#include <stdio.h>
+#include <string.h>
+
+int main(int argc, char* argv[])
+{
+   int const source = (argc == 5 && !strcmp(argv[1], "-c"));
+   if (argc != 3 && !source)
+   {
+      printf("usage: fix_compiler <protocol.xml> <image>\n"
+             "       fix_compiler -c <protocol.xml> <name> <out_dir>  - generate <name>_protocol.c and <name>_protocol.h\n");
+      return 1;
+   }
+   char const* protFile = source ? argv[2] : argv[1];
+   FIXError* error = NULL;
+   FIXProtocolDescr const* protocol = fix_protocol_create(protFile, &error);
+   if (!protocol)
+   {
+      printf("ERROR: %s\n", fix_error_get_text(error));
+      fix_error_free(error);
+      return 1;
+   }
+   int ret = 0;
+   if (source)
+   {
+      if (fix_source_gen(protocol, protFile, argv[3], argv[4]))
+      {
+         printf("ERROR: unable to write sources to '%s'\n", argv[4]);
+         ret = 1;
+      }
+   }
+   else if (fix_protocol_save_image(protocol, argv[2], &error) == FIX_FAILED)
+   {
+      printf("ERROR: %s\n", fix_error_get_text(error));
+      fix_error_free(error);
+      ret = 1;
+   }
+   fix_protocol_free(protocol);
+   return ret;
+}
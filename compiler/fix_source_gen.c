@@ -0,0 +1,653 @@
+/**
+ * @file   fix_source_gen.c
+ * @author Dmitry S. Melnikov, dmitryme@gmail.com
+ * @date   Created on: 10/16/2026 08:15:27 PM
+ */
+
+#include "fix_source_gen.h"
+#include "fix_protocol_descr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define MAX_PATH_LEN 4096
+
+/**
+ * address of description item and its number in generated table
+ */
+typedef struct PtrNum_
+{
+   void const* ptr; ///< address of item
+   uint32_t num;    ///< number of item in generated table
+} PtrNum;
+
+/**
+ * state of source generator. All items are numbered in order of generated tables
+ */
+typedef struct SourceGen_
+{
+   FILE* f;                         ///< generated source
+   char const* name;                ///< prefix of generated names
+   FIXFieldType const** types;      ///< field types, transport ones first, in order of hash chains
+   uint32_t type_count;             ///< count of field types
+   int32_t app_heads[FIELD_TYPE_CNT];       ///< number of first type in chain of application types, -1 - empty chain
+   int32_t transport_heads[FIELD_TYPE_CNT]; ///< number of first type in chain of transport types, -1 - empty chain
+   PtrNum* type_nums;               ///< types sorted by address
+   uint32_t value_count;            ///< count of field values
+   uint32_t value_set_count;        ///< count of field types with values
+   uint32_t value_slot_count;       ///< count of value table slots
+   FIXFieldDescr const** descrs;    ///< field descriptions of all messages and groups
+   uint32_t descr_count;            ///< count of field descriptions
+   PtrNum* descr_nums;              ///< field descriptions sorted by address
+   uint32_t* group_slots;           ///< number of first index slot of each group description
+   uint32_t* group_required;        ///< number of first required bitmap word of each group description
+   FIXMsgDescr const** msgs;        ///< message descriptions in order of hash chains
+   uint32_t msg_count;              ///< count of message descriptions
+   int32_t msg_heads[MSG_CNT];      ///< number of first message in chain, -1 - empty chain
+   uint32_t* msg_slots;             ///< number of first index slot of each message
+   uint32_t* msg_required;          ///< number of first required bitmap word of each message
+   uint32_t* msg_data_lens;         ///< number of first Data and Length tag pair of each message
+   uint32_t slot_count;             ///< count of index slots
+   uint32_t required_count;         ///< count of required bitmap words
+   uint32_t data_len_count;         ///< count of Data and Length tag pairs
+} SourceGen;
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static int compare_ptr_nums(void const* l, void const* r)
+{
+   void const* lptr = ((PtrNum const*)l)->ptr;
+   void const* rptr = ((PtrNum const*)r)->ptr;
+   return lptr < rptr ? -1 : (lptr > rptr ? 1 : 0);
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static PtrNum* sort_ptrs(void const* const* ptrs, uint32_t count)
+{
+   PtrNum* nums = (PtrNum*)calloc(count ? count : 1, sizeof(PtrNum));
+   for(uint32_t i = 0; i < count; ++i)
+   {
+      nums[i].ptr = ptrs[i];
+      nums[i].num = i;
+   }
+   qsort(nums, count, sizeof(PtrNum), &compare_ptr_nums);
+   return nums;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static uint32_t get_num(PtrNum const* nums, uint32_t count, void const* ptr)
+{
+   PtrNum key = {ptr, 0};
+   return ((PtrNum const*)bsearch(&key, nums, count, sizeof(PtrNum), &compare_ptr_nums))->num;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void collect_types(SourceGen* gen, FIXFieldType* const* ftypes, int32_t* heads)
+{
+   for(uint32_t i = 0; i < FIELD_TYPE_CNT; ++i)
+   {
+      heads[i] = ftypes[i] ? (int32_t)gen->type_count : -1;
+      for(FIXFieldType const* ft = ftypes[i]; ft; ft = ft->next)
+      {
+         if (gen->types)
+         {
+            gen->types[gen->type_count] = ft;
+         }
+         ++gen->type_count;
+      }
+   }
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void collect_descrs(SourceGen* gen, FIXFieldDescr const* fields, uint32_t count)
+{
+   uint32_t const first = gen->descr_count;
+   gen->descr_count += count;
+   for(uint32_t i = 0; gen->descrs && i < count; ++i)
+   {
+      gen->descrs[first + i] = &fields[i];
+   }
+   for(uint32_t i = 0; i < count; ++i)
+   {
+      if (fields[i].group_count)
+      {
+         collect_descrs(gen, fields[i].group, fields[i].group_count);
+      }
+   }
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void collect_msgs(SourceGen* gen, FIXProtocolDescr const* prot)
+{
+   for(uint32_t i = 0; i < MSG_CNT; ++i)
+   {
+      gen->msg_heads[i] = prot->messages[i] ? (int32_t)gen->msg_count : -1;
+      for(FIXMsgDescr const* msg = prot->messages[i]; msg; msg = msg->next)
+      {
+         if (gen->msgs)
+         {
+            gen->msgs[gen->msg_count] = msg;
+         }
+         ++gen->msg_count;
+         collect_descrs(gen, msg->fields, msg->field_count);
+      }
+   }
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void put_string(FILE* f, char const* str)
+{
+   fputc('"', f);
+   for(; *str; ++str)
+   {
+      unsigned char const ch = (unsigned char)*str;
+      if (ch == '"' || ch == '\\')
+      {
+         fprintf(f, "\\%c", ch);
+      }
+      else if (ch < 0x20 || ch > 0x7E)
+      {
+         fprintf(f, "\\%03o", ch);
+      }
+      else
+      {
+         fputc(ch, f);
+      }
+   }
+   fputc('"', f);
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void put_values(SourceGen* gen)
+{
+   FILE* f = gen->f;
+   fprintf(f, "   { // value_strings\n");
+   for(uint32_t i = 0; i < gen->type_count; ++i)
+   {
+      for(uint32_t j = 0; gen->types[i]->values && j < gen->types[i]->values->count; ++j)
+      {
+         fprintf(f, "      ");
+         put_string(f, gen->types[i]->values->values[j]);
+         fprintf(f, ",\n");
+      }
+   }
+   fprintf(f, gen->value_count ? "   },\n" : "      0\n   },\n");
+   fprintf(f, "   { // value_slots\n");
+   for(uint32_t i = 0; i < gen->type_count; ++i)
+   {
+      FIXFieldValues const* values = gen->types[i]->values;
+      for(uint32_t j = 0; values && j < values->size; ++j)
+      {
+         fprintf(f, (j % 8) ? " " : "      ");
+         if (values->table[j].value)
+         {
+            fprintf(f, "{");
+            put_string(f, values->table[j].value);
+            fprintf(f, ", %u}", values->table[j].len);
+         }
+         else
+         {
+            fprintf(f, "{0, 0}");
+         }
+         fprintf(f, (j % 8 == 7 || j + 1 == values->size) ? ",\n" : ",");
+      }
+   }
+   fprintf(f, gen->value_slot_count ? "   },\n" : "      {0, 0}\n   },\n");
+   fprintf(f, "   { // value_sets\n");
+   uint32_t value = 0, slot = 0;
+   for(uint32_t i = 0; i < gen->type_count; ++i)
+   {
+      FIXFieldValues const* values = gen->types[i]->values;
+      if (!values)
+      {
+         continue;
+      }
+      fprintf(f, "      {{");
+      for(uint32_t j = 0; j < sizeof(values->chars) / sizeof(values->chars[0]); ++j)
+      {
+         fprintf(f, j ? ", 0x%llXULL" : "0x%llXULL", (unsigned long long)values->chars[j]);
+      }
+      fprintf(f, "}, %u, (char const**)&%s_tables.value_strings[%u], %u, %u, ", values->count, gen->name, value,
+            values->size, values->seed);
+      if (values->size)
+      {
+         fprintf(f, "(FIXFieldValueSlot*)&%s_tables.value_slots[%u]},\n", gen->name, slot);
+      }
+      else
+      {
+         fprintf(f, "0},\n");
+      }
+      value += values->count;
+      slot += values->size;
+   }
+   fprintf(f, gen->value_set_count ? "   },\n" : "      {{0}}\n   },\n");
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void put_types(SourceGen* gen)
+{
+   FILE* f = gen->f;
+   fprintf(f, "   { // types\n");
+   uint32_t value_set = 0;
+   for(uint32_t i = 0; i < gen->type_count; ++i)
+   {
+      FIXFieldType const* ft = gen->types[i];
+      char prefix[sizeof(ft->prefix) + 1] = {};
+      memcpy(prefix, ft->prefix, ft->prefix_len);
+      fprintf(f, "      {%d, ", ft->tag);
+      put_string(f, prefix);
+      fprintf(f, ", %u, %u, (FIXFieldValueTypeEnum)0x%X, (char*)", ft->prefix_len, ft->prefix_crc, ft->valueType);
+      put_string(f, ft->name);
+      if (ft->values)
+      {
+         fprintf(f, ", VALUES(%u)", value_set++);
+      }
+      else
+      {
+         fprintf(f, ", 0");
+      }
+      fprintf(f, ft->next ? ", TYPE(%u)},\n" : ", 0},\n", i + 1);
+   }
+   fprintf(f, gen->type_count ? "   },\n" : "      {0}\n   },\n");
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void put_descrs(SourceGen* gen)
+{
+   FILE* f = gen->f;
+   fprintf(f, "   { // descrs\n");
+   for(uint32_t i = 0; i < gen->descr_count; ++i)
+   {
+      FIXFieldDescr const* fd = gen->descrs[i];
+      fprintf(f, "      {TYPE(%u), %s, %u, %u, ", get_num(gen->type_nums, gen->type_count, fd->type),
+            fd->category == FIXFieldCategory_Group ? "FIXFieldCategory_Group" : "FIXFieldCategory_Value",
+            fd->flags, fd->group_count);
+      if (fd->group_count)
+      {
+         fprintf(f, "DESCR(%u), SLOT(%u), %u, ", get_num(gen->descr_nums, gen->descr_count, fd->group),
+               gen->group_slots[i], fd->group_index_size);
+      }
+      else
+      {
+         fprintf(f, "0, 0, 0, ");
+      }
+      if (fd->dataLenField)
+      {
+         fprintf(f, "DESCR(%u), ", get_num(gen->descr_nums, gen->descr_count, fd->dataLenField));
+      }
+      else
+      {
+         fprintf(f, "0, ");
+      }
+      fprintf(f, fd->group_count ? "REQ(%u)},\n" : "0},\n", gen->group_required[i]);
+   }
+   fprintf(f, gen->descr_count ? "   },\n" : "      {0}\n   },\n");
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void put_index(SourceGen* gen, FIXFieldDescr* const* index, uint32_t size)
+{
+   fprintf(gen->f, "     ");
+   for(uint32_t i = 0; i < size; ++i)
+   {
+      if (index[i])
+      {
+         fprintf(gen->f, " DESCR(%u),", get_num(gen->descr_nums, gen->descr_count, index[i]));
+      }
+      else
+      {
+         fprintf(gen->f, " 0,");
+      }
+   }
+   fprintf(gen->f, "\n");
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void put_slots(SourceGen* gen)
+{
+   fprintf(gen->f, "   { // slots\n");
+   for(uint32_t i = 0; i < gen->msg_count; ++i)
+   {
+      put_index(gen, gen->msgs[i]->field_index, gen->msgs[i]->field_index_size);
+   }
+   for(uint32_t i = 0; i < gen->descr_count; ++i)
+   {
+      if (gen->descrs[i]->group_count)
+      {
+         put_index(gen, gen->descrs[i]->group_index, gen->descrs[i]->group_index_size);
+      }
+   }
+   fprintf(gen->f, gen->slot_count ? "   },\n" : "      0\n   },\n");
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void put_required_words(FILE* f, FIXFieldDescr const* fields, uint32_t count)
+{
+   uint64_t* required = (uint64_t*)calloc(REQUIRED_WORDS(count) ? REQUIRED_WORDS(count) : 1, sizeof(uint64_t));
+   fix_protocol_init_required(fields, count, required);
+   fprintf(f, "\n     ");
+   for(uint32_t i = 0; i < REQUIRED_WORDS(count); ++i)
+   {
+      fprintf(f, " 0x%llXULL,", (unsigned long long)required[i]);
+   }
+   free(required);
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void put_required(SourceGen* gen)
+{
+   fprintf(gen->f, "   { // required");
+   for(uint32_t i = 0; i < gen->msg_count; ++i)
+   {
+      put_required_words(gen->f, gen->msgs[i]->fields, gen->msgs[i]->field_count);
+   }
+   for(uint32_t i = 0; i < gen->descr_count; ++i)
+   {
+      if (gen->descrs[i]->group_count)
+      {
+         put_required_words(gen->f, gen->descrs[i]->group, gen->descrs[i]->group_count);
+      }
+   }
+   fprintf(gen->f, gen->required_count ? "\n   },\n" : "\n      0\n   },\n");
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void put_data_lens(SourceGen* gen)
+{
+   fprintf(gen->f, "   { // data_lens");
+   for(uint32_t i = 0; i < gen->msg_count; ++i)
+   {
+      FIXMsgDescr const* msg = gen->msgs[i];
+      if (!msg->data_len_count)
+      {
+         continue;
+      }
+      fprintf(gen->f, "\n     ");
+      for(uint32_t j = 0; j < msg->data_len_count * 2; ++j)
+      {
+         fprintf(gen->f, " %d,", msg->data_lens[j]);
+      }
+   }
+   fprintf(gen->f, gen->data_len_count ? "\n   },\n" : "\n      0\n   },\n");
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void put_msgs(SourceGen* gen)
+{
+   FILE* f = gen->f;
+   fprintf(f, "   { // msgs\n");
+   for(uint32_t i = 0; i < gen->msg_count; ++i)
+   {
+      FIXMsgDescr const* msg = gen->msgs[i];
+      fprintf(f, "      {(char*)");
+      put_string(f, msg->type);
+      fprintf(f, ", (char*)");
+      put_string(f, msg->name);
+      fprintf(f, ", %u, DESCR(%u), SLOT(%u), %u, REQ(%u), ", msg->field_count,
+            get_num(gen->descr_nums, gen->descr_count, msg->fields), gen->msg_slots[i], msg->field_index_size,
+            gen->msg_required[i]);
+      if (msg->data_len_count)
+      {
+         fprintf(f, "LENS(%u), %u, ", gen->msg_data_lens[i], msg->data_len_count);
+      }
+      else
+      {
+         fprintf(f, "0, 0, ");
+      }
+      fprintf(f, msg->next ? "MSG(%u)},\n" : "0},\n", i + 1);
+   }
+   fprintf(f, gen->msg_count ? "   },\n" : "      {0}\n   },\n");
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void put_tag_types(SourceGen* gen, FIXProtocolDescr const* prot)
+{
+   fprintf(gen->f, "   { // tag_types\n      ");
+   for(uint32_t i = 0; i < prot->tag_types_count; ++i)
+   {
+      if (prot->tag_types[i])
+      {
+         fprintf(gen->f, "TYPE(%u),", get_num(gen->type_nums, gen->type_count, prot->tag_types[i]));
+      }
+      else
+      {
+         fprintf(gen->f, "0,");
+      }
+      fprintf(gen->f, (i % 16 == 15) ? "\n      " : " ");
+   }
+   fprintf(gen->f, "\n   }\n");
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static FIXMsgDescr const** sorted_msgs = NULL; // used by compare_msg_nums only
+
+static int compare_msg_nums(void const* l, void const* r)
+{
+   uint32_t const lnum = *(uint32_t const*)l;
+   uint32_t const rnum = *(uint32_t const*)r;
+   int const res = strcmp(sorted_msgs[lnum]->type, sorted_msgs[rnum]->type);
+   return res ? res : (lnum < rnum ? -1 : (lnum > rnum ? 1 : 0)); // first message in chain wins, as in hash lookup
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void put_switch(SourceGen* gen, uint32_t const* nums, uint32_t begin, uint32_t end, uint32_t depth, int indent)
+{
+   FILE* f = gen->f;
+   fprintf(f, "%*sswitch(type[%u])\n%*s{\n", indent, "", depth, indent, "");
+   for(uint32_t i = begin; i < end;)
+   {
+      unsigned char const ch = (unsigned char)gen->msgs[nums[i]]->type[depth];
+      uint32_t j = i + 1;
+      while(j < end && (unsigned char)gen->msgs[nums[j]]->type[depth] == ch)
+      {
+         ++j;
+      }
+      if (!ch)
+      {
+         fprintf(f, "%*s   case 0: return MSG(%u);\n", indent, "", nums[i]);
+      }
+      else
+      {
+         if (isalnum(ch))
+         {
+            fprintf(f, "%*s   case '%c':\n", indent, "", ch);
+         }
+         else
+         {
+            fprintf(f, "%*s   case %u:\n", indent, "", ch);
+         }
+         put_switch(gen, nums, i, j, depth + 1, indent + 6);
+      }
+      i = j;
+   }
+   fprintf(f, "%*s}\n%*sreturn NULL;\n", indent, "", indent, "");
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void put_find_msg(SourceGen* gen)
+{
+   uint32_t* nums = (uint32_t*)calloc(gen->msg_count ? gen->msg_count : 1, sizeof(uint32_t));
+   for(uint32_t i = 0; i < gen->msg_count; ++i)
+   {
+      nums[i] = i;
+   }
+   sorted_msgs = gen->msgs;
+   qsort(nums, gen->msg_count, sizeof(uint32_t), &compare_msg_nums);
+   fprintf(gen->f, "static FIXMsgDescr const* %s_find_msg(char const* type)\n{\n", gen->name);
+   put_switch(gen, nums, 0, gen->msg_count, 0, 3);
+   fprintf(gen->f, "}\n\n");
+   free(nums);
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void put_heads(FILE* f, int32_t const* heads, uint32_t count, char const* macro)
+{
+   fprintf(f, "   {");
+   for(uint32_t i = 0; i < count; ++i)
+   {
+      fprintf(f, (i % 16) ? " " : "\n      ");
+      if (heads[i] >= 0)
+      {
+         fprintf(f, "%s(%d),", macro, heads[i]);
+      }
+      else
+      {
+         fprintf(f, "0,");
+      }
+   }
+   fprintf(f, "\n   },\n");
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void put_source(SourceGen* gen, FIXProtocolDescr const* prot, char const* protFile)
+{
+   FILE* f = gen->f;
+   char const* name = gen->name;
+   fprintf(f, "/* generated by fix_compiler from %s, do not edit */\n\n", protFile);
+   fprintf(f, "#include \"%s_protocol.h\"\n#include \"fix_protocol_tables.h\"\n\n#include <stddef.h>\n\n", name);
+   fprintf(f, "#if FIX_PROTOCOL_TABLES_VERSION != %d\n#error \"%s_protocol.c is generated for other fix_parser version\"\n#endif\n\n",
+         FIX_PROTOCOL_TABLES_VERSION, name);
+   fprintf(f, "#define VALUES(n) ((FIXFieldValues*)&%s_tables.value_sets[n])\n", name);
+   fprintf(f, "#define TYPE(n)   ((FIXFieldType*)&%s_tables.types[n])\n", name);
+   fprintf(f, "#define DESCR(n)  ((FIXFieldDescr*)&%s_tables.descrs[n])\n", name);
+   fprintf(f, "#define SLOT(n)   ((FIXFieldDescr**)&%s_tables.slots[n])\n", name);
+   fprintf(f, "#define MSG(n)    ((FIXMsgDescr*)&%s_tables.msgs[n])\n", name);
+   fprintf(f, "#define REQ(n)    ((uint64_t*)&%s_tables.required[n])\n", name);
+   fprintf(f, "#define LENS(n)   ((FIXTagNum*)&%s_tables.data_lens[n])\n\n", name);
+   fprintf(f, "static struct\n{\n");
+   fprintf(f, "   uint64_t required[%u];\n", gen->required_count ? gen->required_count : 1);
+   fprintf(f, "   FIXTagNum data_lens[%u];\n", gen->data_len_count ? gen->data_len_count * 2 : 1);
+   fprintf(f, "   char const* value_strings[%u];\n", gen->value_count ? gen->value_count : 1);
+   fprintf(f, "   FIXFieldValueSlot value_slots[%u];\n", gen->value_slot_count ? gen->value_slot_count : 1);
+   fprintf(f, "   FIXFieldValues value_sets[%u];\n", gen->value_set_count ? gen->value_set_count : 1);
+   fprintf(f, "   FIXFieldType types[%u];\n", gen->type_count ? gen->type_count : 1);
+   fprintf(f, "   FIXFieldDescr descrs[%u];\n", gen->descr_count ? gen->descr_count : 1);
+   fprintf(f, "   FIXFieldDescr* slots[%u];\n", gen->slot_count ? gen->slot_count : 1);
+   fprintf(f, "   FIXMsgDescr msgs[%u];\n", gen->msg_count ? gen->msg_count : 1);
+   fprintf(f, "   FIXFieldType* tag_types[%u];\n", prot->tag_types_count);
+   fprintf(f, "} const %s_tables =\n{\n", name);
+   put_required(gen);
+   put_data_lens(gen);
+   put_values(gen);
+   put_types(gen);
+   put_descrs(gen);
+   put_slots(gen);
+   put_msgs(gen);
+   put_tag_types(gen, prot);
+   fprintf(f, "};\n\n");
+   put_find_msg(gen);
+   fprintf(f, "static FIXProtocolDescr %s_protocol_descr =\n{\n   (char*)", name);
+   put_string(f, prot->version);
+   fprintf(f, ",\n   (char*)");
+   put_string(f, prot->transportVersion);
+   fprintf(f, ",\n");
+   put_heads(f, gen->app_heads, FIELD_TYPE_CNT, "TYPE");
+   put_heads(f, gen->transport_heads, FIELD_TYPE_CNT, "TYPE");
+   put_heads(f, gen->msg_heads, MSG_CNT, "MSG");
+   fprintf(f, "   (FIXFieldType**)%s_tables.tag_types,\n   %u,\n", name, prot->tag_types_count);
+   fprintf(f, "   1,    // ref_count\n   NULL, // image\n   0,    // image_size\n   NULL, // arena\n");
+   fprintf(f, "   &%s_find_msg,\n   1     // is_static\n};\n\n", name);
+   fprintf(f, "FIXProtocolDescr const* %s_protocol(void)\n{\n   return &%s_protocol_descr;\n}\n", name, name);
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void put_header(FILE* f, char const* name, char const* protFile)
+{
+   fprintf(f, "/* generated by fix_compiler from %s, do not edit */\n\n", protFile);
+   fprintf(f, "#ifndef FIX_PARSER_%s_PROTOCOL_H\n#define FIX_PARSER_%s_PROTOCOL_H\n\n", name, name);
+   fprintf(f, "#include \"fix_types.h\"\n\n#ifdef __cplusplus\nextern \"C\"\n{\n#endif\n\n");
+   fprintf(f, "/**\n * return static protocol description, generated from %s. Use it with fix_parser_create_from_protocol\n */\n",
+         protFile);
+   fprintf(f, "FIXProtocolDescr const* %s_protocol(void);\n\n", name);
+   fprintf(f, "#ifdef __cplusplus\n}\n#endif\n\n#endif /* FIX_PARSER_%s_PROTOCOL_H */\n", name);
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+/* PUBLICS                                                                                                               */
+/*-----------------------------------------------------------------------------------------------------------------------*/
+int fix_source_gen(FIXProtocolDescr const* prot, char const* protFile, char const* name, char const* outDir)
+{
+   SourceGen gen = {};
+   gen.name = name;
+   collect_types(&gen, prot->transport_field_types, gen.transport_heads);
+   collect_types(&gen, prot->field_types, gen.app_heads);
+   gen.types = (FIXFieldType const**)calloc(gen.type_count ? gen.type_count : 1, sizeof(FIXFieldType*));
+   gen.type_count = 0;
+   collect_types(&gen, prot->transport_field_types, gen.transport_heads);
+   collect_types(&gen, prot->field_types, gen.app_heads);
+   gen.type_nums = sort_ptrs((void const* const*)gen.types, gen.type_count);
+   for(uint32_t i = 0; i < gen.type_count; ++i)
+   {
+      FIXFieldValues const* values = gen.types[i]->values;
+      gen.value_set_count += (values != NULL);
+      gen.value_count += values ? values->count : 0;
+      gen.value_slot_count += values ? values->size : 0;
+   }
+   collect_msgs(&gen, prot);
+   gen.msgs = (FIXMsgDescr const**)calloc(gen.msg_count ? gen.msg_count : 1, sizeof(FIXMsgDescr*));
+   gen.descrs = (FIXFieldDescr const**)calloc(gen.descr_count ? gen.descr_count : 1, sizeof(FIXFieldDescr*));
+   gen.msg_count = 0;
+   gen.descr_count = 0;
+   collect_msgs(&gen, prot);
+   gen.descr_nums = sort_ptrs((void const* const*)gen.descrs, gen.descr_count);
+   gen.msg_slots = (uint32_t*)calloc(gen.msg_count ? gen.msg_count : 1, sizeof(uint32_t));
+   gen.group_slots = (uint32_t*)calloc(gen.descr_count ? gen.descr_count : 1, sizeof(uint32_t));
+   gen.msg_required = (uint32_t*)calloc(gen.msg_count ? gen.msg_count : 1, sizeof(uint32_t));
+   gen.group_required = (uint32_t*)calloc(gen.descr_count ? gen.descr_count : 1, sizeof(uint32_t));
+   gen.msg_data_lens = (uint32_t*)calloc(gen.msg_count ? gen.msg_count : 1, sizeof(uint32_t));
+   for(uint32_t i = 0; i < gen.msg_count; ++i)
+   {
+      gen.msg_slots[i] = gen.slot_count;
+      gen.slot_count += gen.msgs[i]->field_index_size;
+      gen.msg_required[i] = gen.required_count;
+      gen.required_count += REQUIRED_WORDS(gen.msgs[i]->field_count);
+      gen.msg_data_lens[i] = gen.data_len_count * 2;
+      gen.data_len_count += gen.msgs[i]->data_len_count;
+   }
+   for(uint32_t i = 0; i < gen.descr_count; ++i)
+   {
+      if (gen.descrs[i]->group_count)
+      {
+         gen.group_slots[i] = gen.slot_count;
+         gen.slot_count += gen.descrs[i]->group_index_size;
+         gen.group_required[i] = gen.required_count;
+         gen.required_count += REQUIRED_WORDS(gen.descrs[i]->group_count);
+      }
+   }
+   int res = 0;
+   char path[MAX_PATH_LEN];
+   snprintf(path, sizeof(path), "%s/%s_protocol.h", outDir, name);
+   FILE* f = fopen(path, "w");
+   if (f)
+   {
+      put_header(f, name, protFile);
+      res |= fclose(f);
+   }
+   else
+   {
+      res = 1;
+   }
+   snprintf(path, sizeof(path), "%s/%s_protocol.c", outDir, name);
+   gen.f = fopen(path, "w");
+   if (gen.f)
+   {
+      put_source(&gen, prot, protFile);
+      res |= fclose(gen.f);
+   }
+   else
+   {
+      res = 1;
+   }
+   free(gen.types);
+   free(gen.type_nums);
+   free(gen.msgs);
+   free(gen.descrs);
+   free(gen.descr_nums);
+   free(gen.msg_slots);
+   free(gen.group_slots);
+   free(gen.msg_required);
+   free(gen.group_required);
+   free(gen.msg_data_lens);
+   return res;
+}
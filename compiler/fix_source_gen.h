@@ -0,0 +1,33 @@
+/**
+ * @file   fix_source_gen.h
+ * @author Dmitry S. Melnikov, dmitryme@gmail.com
+ * @date   Created on: 10/16/2026 08:15:27 PM
+ */
+
+#ifndef FIX_PARSER_FIX_SOURCE_GEN_H
+#define FIX_PARSER_FIX_SOURCE_GEN_H
+
+#include "fix_protocol_descr.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * generate C source with static tables of protocol description. Files <outDir>/<name>_protocol.h and
+ * <outDir>/<name>_protocol.c are created. Header declares FIXProtocolDescr const* <name>_protocol(void), which result
+ * is passed to fix_parser_create_from_protocol
+ * @param[in] prot - protocol description
+ * @param[in] protFile - protocol xml file, only mentioned in generated comments
+ * @param[in] name - prefix of generated files and function, must be valid C identifier
+ * @param[in] outDir - directory for generated files
+ * @return 0 - ok, else - file can't be written
+ */
+int fix_source_gen(FIXProtocolDescr const* prot, char const* protFile, char const* name, char const* outDir);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FIX_PARSER_FIX_SOURCE_GEN_H */
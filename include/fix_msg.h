@@ -11,12 +11,28 @@
 #include "fix_parser_dll.h"
 
 #include <stdint.h>
+#ifdef WIN32
+#  include <stddef.h>
+#else
+#  include <sys/uio.h>
+#endif
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+#ifdef WIN32
+/**
+ * scatter/gather buffer, same as POSIX one
+ */
+struct iovec
+{
+   void* iov_base; ///< start of data
+   size_t iov_len; ///< length of data
+};
+#endif
+
 /**
  * create new FIX message
  * @param[in] parser - instance of parser
@@ -145,6 +161,19 @@ FIX_PARSER_API FIXErrCode fix_msg_set_char(FIXMsg* msg, FIXGroup* grp, FIXTagNum
  */
 FIX_PARSER_API FIXErrCode fix_msg_set_double(FIXMsg* msg, FIXGroup* grp, FIXTagNum tagNum, double val, FIXError** error);
 
+/**
+ * set tag with double value, written with fixed count of fraction digits (e.g. price with known tick precision)
+ * @param[in] msg - FIX message
+ * @param[in] grp - non NULL group, if tag is a part of group, else must be NULL
+ * @param[in] tagNum - field tag number
+ * @param[in] val - double value
+ * @param[in] precision - count of fraction digits
+ * @param[out] error - error description
+ * @return FIX_SUCCESS - OK, FIX_FAILED - not set. See fix_parser_get_error_code(parser) for details
+ */
+FIX_PARSER_API FIXErrCode fix_msg_set_double_fixed(FIXMsg* msg, FIXGroup* grp, FIXTagNum tagNum, double val, uint32_t precision,
+      FIXError** error);
+
 /**
  * set tag with data value
  * @param[in] msg - FIX message
@@ -249,6 +278,76 @@ FIX_PARSER_API FIXErrCode fix_msg_get_data(FIXMsg* msg, FIXGroup* grp, FIXTagNum
  */
 FIX_PARSER_API FIXErrCode fix_msg_del_field(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag, FIXError** error);
 
+/**
+ * resolve message field once, so it can be get or set by handle without looking up field description every time.
+ * Handle is valid for all messages of msgType, created by parsers with the same protocol description
+ * @param[in] parser - instance of parser
+ * @param[in] msgType - type of message (e.g. "A", "D", "AE", etc.)
+ * @param[in] tagNum - field tag number. Field must be a message field, not a group one
+ * @param[out] handle - resolved field
+ * @param[out] error - error description
+ * @return FIX_SUCCESS - OK, FIX_FAILED - see error description
+ */
+FIX_PARSER_API FIXErrCode fix_msg_resolve_field(FIXParser* parser, char const* msgType, FIXTagNum tagNum, FIXFieldHandle* handle,
+      FIXError** error);
+
+/**
+ * set tag with string value by handle. See fix_msg_set_string_len
+ */
+FIX_PARSER_API FIXErrCode fix_msg_set_string_len_h(FIXMsg* msg, FIXFieldHandle const* handle, char const* val, uint32_t len,
+      FIXError** error);
+
+/**
+ * set tag with string value by handle. See fix_msg_set_string
+ */
+FIX_PARSER_API FIXErrCode fix_msg_set_string_h(FIXMsg* msg, FIXFieldHandle const* handle, char const* val, FIXError** error);
+
+/**
+ * set tag with 32-bit numeric value by handle. See fix_msg_set_int32
+ */
+FIX_PARSER_API FIXErrCode fix_msg_set_int32_h(FIXMsg* msg, FIXFieldHandle const* handle, int32_t val, FIXError** error);
+
+/**
+ * set tag with 64-bit numeric value by handle. See fix_msg_set_int64
+ */
+FIX_PARSER_API FIXErrCode fix_msg_set_int64_h(FIXMsg* msg, FIXFieldHandle const* handle, int64_t val, FIXError** error);
+
+/**
+ * set tag with single char value by handle. See fix_msg_set_char
+ */
+FIX_PARSER_API FIXErrCode fix_msg_set_char_h(FIXMsg* msg, FIXFieldHandle const* handle, char val, FIXError** error);
+
+/**
+ * set tag with double value by handle. See fix_msg_set_double
+ */
+FIX_PARSER_API FIXErrCode fix_msg_set_double_h(FIXMsg* msg, FIXFieldHandle const* handle, double val, FIXError** error);
+
+/**
+ * get tag 32-bit value by handle. See fix_msg_get_int32
+ */
+FIX_PARSER_API FIXErrCode fix_msg_get_int32_h(FIXMsg* msg, FIXFieldHandle const* handle, int32_t* val, FIXError** error);
+
+/**
+ * get tag 64-bit value by handle. See fix_msg_get_int64
+ */
+FIX_PARSER_API FIXErrCode fix_msg_get_int64_h(FIXMsg* msg, FIXFieldHandle const* handle, int64_t* val, FIXError** error);
+
+/**
+ * get tag double value by handle. See fix_msg_get_double
+ */
+FIX_PARSER_API FIXErrCode fix_msg_get_double_h(FIXMsg* msg, FIXFieldHandle const* handle, double* val, FIXError** error);
+
+/**
+ * get tag char value by handle. See fix_msg_get_char
+ */
+FIX_PARSER_API FIXErrCode fix_msg_get_char_h(FIXMsg* msg, FIXFieldHandle const* handle, char* val, FIXError** error);
+
+/**
+ * get tag string value by handle. See fix_msg_get_string
+ */
+FIX_PARSER_API FIXErrCode fix_msg_get_string_h(FIXMsg* msg, FIXFieldHandle const* handle, char const** val, uint32_t* len,
+      FIXError** error);
+
 /**
  * convert FIX message to string
  * @param[in] msg - message to be converted
@@ -263,6 +362,95 @@ FIX_PARSER_API FIXErrCode fix_msg_del_field(FIXMsg* msg, FIXGroup* grp, FIXTagNu
  */
 FIX_PARSER_API FIXErrCode fix_msg_to_str(FIXMsg* msg, char delimiter, char* buff, uint32_t buffLen, uint32_t* reqBuffLen, FIXError** error);
 
+/**
+ * convert FIX message to iovecs, suitable for writev/sendmsg. Tags, delimiters and short values are written to buff,
+ * long values and data fields are not copied, iovecs refer to message field data directly. Iovecs are valid until
+ * message is changed or freed
+ * @param[in] msg - message to be converted
+ * @param[in] delimiter - FIX field delimter char
+ * @param[out] iov - array of iovecs with converted message
+ * @param[in] iovCount - count of iovecs in iov array
+ * @param[out] reqIovCount - count of used iovecs. If iov array is too small, returns count of needed iovecs
+ * @param[out] buff - buffer for tags, delimiters and short values
+ * @param[in] buffLen - length of buff
+ * @param[out] reqBuffLen - length of used buff. If buff too small, returns length of needed space
+ * @param[out] error - error description
+ * @return FIX_SUCCESS - OK
+ *         FIX_ERROR_NO_MORE_SPACE - see reqIovCount and reqBuffLen for required space
+ *         FIX_FAILED - error description
+ */
+FIX_PARSER_API FIXErrCode fix_msg_to_iovec(FIXMsg* msg, char delimiter, struct iovec* iov, uint32_t iovCount, uint32_t* reqIovCount,
+      char* buff, uint32_t buffLen, uint32_t* reqBuffLen, FIXError** error);
+
+/**
+ * create message template. All message fields except variable ones are serialized once and copied as is on every
+ * fix_msg_template_to_str. Template doesn't refer to message, so message can be freed after template creation.
+ * Template is not thread-safe, each thread should have its own one
+ * @param[in] msg - message with constant fields (and initial values of variable fields)
+ * @param[in] delimiter - FIX field delimiter
+ * @param[in] fields - handles of variable fields, resolved for message type. BeginString, BodyLength, CheckSum and
+ * groups can't be variable
+ * @param[in] fieldCount - count of variable fields
+ * @param[out] error - error description
+ * @return message template, NULL - see error description
+ * @note all created templates must be destroyed with fix_msg_template_free
+ */
+FIX_PARSER_API FIXMsgTemplate* fix_msg_template_create(FIXMsg* msg, char delimiter, FIXFieldHandle const* fields,
+      uint32_t fieldCount, FIXError** error);
+
+/**
+ * free message template
+ * @param[in] tmpl - template, which should be destroyed
+ */
+FIX_PARSER_API void fix_msg_template_free(FIXMsgTemplate* tmpl);
+
+/**
+ * set variable field with string value
+ * @param[in] tmpl - message template
+ * @param[in] fieldIdx - index of variable field in fields array, passed to fix_msg_template_create
+ * @param[in] val - string value
+ * @param[in] len - string length
+ * @param[out] error - error description
+ * @return FIX_SUCCESS - OK, FIX_FAILED - see error description
+ */
+FIX_PARSER_API FIXErrCode fix_msg_template_set_string_len(FIXMsgTemplate* tmpl, uint32_t fieldIdx, char const* val, uint32_t len,
+      FIXError** error);
+
+/**
+ * set variable field with string value (ends with zero). See fix_msg_template_set_string_len
+ */
+FIX_PARSER_API FIXErrCode fix_msg_template_set_string(FIXMsgTemplate* tmpl, uint32_t fieldIdx, char const* val, FIXError** error);
+
+/**
+ * set variable field with 64-bit numeric value. See fix_msg_template_set_string_len
+ */
+FIX_PARSER_API FIXErrCode fix_msg_template_set_int64(FIXMsgTemplate* tmpl, uint32_t fieldIdx, int64_t val, FIXError** error);
+
+/**
+ * set variable field with single char value. See fix_msg_template_set_string_len
+ */
+FIX_PARSER_API FIXErrCode fix_msg_template_set_char(FIXMsgTemplate* tmpl, uint32_t fieldIdx, char val, FIXError** error);
+
+/**
+ * set variable field with double value. See fix_msg_template_set_string_len
+ */
+FIX_PARSER_API FIXErrCode fix_msg_template_set_double(FIXMsgTemplate* tmpl, uint32_t fieldIdx, double val, FIXError** error);
+
+/**
+ * convert message template with current values of variable fields to string. BodyLength and CheckSum are not
+ * recalculated over the whole message, but are maintained on every change of variable field
+ * @param[in] tmpl - message template
+ * @param[out] buff - buffer with converted message
+ * @param[in] buffLen - length of output buffer
+ * @param[out] reqBuffLen - length of converted message. If buff length too small, reqBuffLen returns length of needed space
+ * @param[out] error - error description
+ * @return FIX_SUCCESS - OK
+ *         FIX_ERROR_NO_MORE_SPACE - see reqBuffLen for required space
+ *         FIX_FAILED - error description
+ */
+FIX_PARSER_API FIXErrCode fix_msg_template_to_str(FIXMsgTemplate* tmpl, char* buff, uint32_t buffLen, uint32_t* reqBuffLen,
+      FIXError** error);
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,12 +23,78 @@ extern "C"
  * @param[in] protFile - path to xml file with protocol description. see fix_parser/fix_descr directory for various FIX
  * protocol description
  * @param[in] attrs - parser attributes
- * @param[in] flags - parser flags. See PARSER_FLAG_CHECK_* values
+ * @param[in] flags - parser flags. See PARSER_FLAG_* values
  * @param[out] error - error description, if any. If error is returned, it must be destroyed by free(error)
  * @return new instance of FIX parser. if NULL, invoke fix_error_get_code(error), fix_error_get_text(error) for error description
  */
 FIX_PARSER_API FIXParser* fix_parser_create(char const* protFile, FIXParserAttrs const* attrs, int32_t flags, FIXError** error);
 
+/**
+ * load FIX protocol description. Description is immutable and reference counted, so it can be shared by any number of
+ * parsers in different threads
+ * @param[in] protFile - path to xml file with protocol description
+ * @param[out] error - error description, if any
+ * @return protocol description, NULL - see error description. Must be released by fix_protocol_free
+ */
+FIX_PARSER_API FIXProtocolDescr const* fix_protocol_create(char const* protFile, FIXError** error);
+
+/**
+ * load FIX protocol description from binary image, created by fix_protocol_save_image (or fix_compiler utility). Image
+ * is mapped read-only, so loading is much faster than XML parsing and image pages are shared by all processes
+ * @param[in] imageFile - path to image file
+ * @param[out] error - error description, if any
+ * @return protocol description, NULL - see error description. Must be released by fix_protocol_free
+ * @note image format depends on library version and platform (byte order), so image must be created by the same
+ * library build, which loads it
+ */
+FIX_PARSER_API FIXProtocolDescr const* fix_protocol_create_from_image(char const* imageFile, FIXError** error);
+
+/**
+ * save FIX protocol description (with its transport protocol) as relocatable binary image
+ * @param[in] protocol - protocol description
+ * @param[in] imageFile - path to image file. File is overwritten
+ * @param[out] error - error description, if any
+ * @return FIX_SUCCESS - ok, FIX_FAILED - see error description
+ */
+FIX_PARSER_API FIXErrCode fix_protocol_save_image(FIXProtocolDescr const* protocol, char const* imageFile, FIXError** error);
+
+/**
+ * release protocol description. Description is destroyed, when its last parser is freed
+ * @param[in] protocol - protocol description
+ */
+FIX_PARSER_API void fix_protocol_free(FIXProtocolDescr const* protocol);
+
+/**
+ * create lightweight parser, which uses already loaded protocol description. Parser holds only its own memory pools,
+ * so create one parser per thread and share the protocol. Memory pools are thread safe, so messages may be created,
+ * parsed and freed by several threads with one parser too, but one message must not be used concurrently
+ * @param[in] protocol - protocol description. Parser holds reference to it
+ * @param[in] attrs - parser attributes
+ * @param[in] flags - parser flags. See PARSER_FLAG_* values
+ * @param[out] error - error description, if any
+ * @return new instance of FIX parser, NULL - see error description
+ */
+FIX_PARSER_API FIXParser* fix_parser_create_from_protocol(FIXProtocolDescr const* protocol, FIXParserAttrs const* attrs,
+      int32_t flags, FIXError** error);
+
+/**
+ * create new parser instance with protocol description from binary image. See fix_protocol_create_from_image
+ * @param[in] imageFile - path to image file
+ * @param[in] attrs - parser attributes
+ * @param[in] flags - parser flags. See PARSER_FLAG_* values
+ * @param[out] error - error description, if any
+ * @return new instance of FIX parser, NULL - see error description
+ */
+FIX_PARSER_API FIXParser* fix_parser_create_from_image(char const* imageFile, FIXParserAttrs const* attrs, int32_t flags,
+      FIXError** error);
+
+/**
+ * return protocol description of parser. Use it with fix_parser_create_from_protocol to create parsers for another threads
+ * @param[in] parser - pointer to parser instance
+ * @return protocol description, NULL - parser is NULL
+ */
+FIX_PARSER_API FIXProtocolDescr const* fix_parser_get_protocol(FIXParser const* parser);
+
 /**
  * free parser instance.
  * @param[in] parser - pointer to parser instance
@@ -51,9 +117,55 @@ FIX_PARSER_API char const* fix_parser_get_protocol_ver(FIXParser* parser);
  * @param[in] stop - pointer to position in data, where parsing is stopped
  * @param[out] error - error descritption
  * @return new instance of parsed message
+ * @note if parser is created with PARSER_FLAG_ZERO_COPY flag, message fields refer to data, so data must not be changed
+ * or freed while message is alive
+ * @note if parser is created with PARSER_FLAG_LAZY flag, only message structure is checked here. Top-level fields and
+ * groups are parsed and validated on first access, whole message is parsed on first change or conversion to string.
+ * Data must live as long as message
  */
 FIX_PARSER_API FIXMsg* fix_parser_str_to_msg(FIXParser* parser, char const* data, uint32_t len, char delimiter, char const** stop, FIXError** error);
 
+/**
+ * parse sequence of FIX encoded messages
+ * @param[in] parser - instance of FIX parser
+ * @param[in] data - pointer to data with FIX messages
+ * @param[in] len - length of data
+ * @param[in] delimiter - FIX SOH
+ * @param[out] msgs - parsed messages. If message is broken, NULL is stored and corresponding error is set
+ * @param[out] errors - error description of each message, NULL if message is parsed successfully. Can be NULL,
+ * if errors are not needed. Each error must be destroyed by fix_error_free(error)
+ * @param[in] maxMsgs - size of msgs and errors arrays
+ * @param[out] stop - pointer to the first not processed byte of data. It is the beginning of incomplete message, if data
+ * ends with incomplete message
+ * @return count of messages (and errors) stored in msgs (and errors)
+ * @note broken message doesn't stop parsing. If message structure is broken, parsing is continued from the next field
+ * which looks like BeginString
+ */
+FIX_PARSER_API uint32_t fix_parser_str_to_msgs(FIXParser* parser, char const* data, uint32_t len, char delimiter,
+      FIXMsg** msgs, FIXError** errors, uint32_t maxMsgs, char const** stop);
+
+/**
+ * build structural index of FIX encoded message. Message is scanned only once: field positions are stored in index and
+ * CheckSum is calculated on the fly. BeginString is checked against parser protocol version, BodyLength is used to find
+ * the message end and Data fields are bounded by their Length fields.
+ * @param[in] parser - instance of FIX parser
+ * @param[in] data - pointer to data with FIX message
+ * @param[in] len - length of data
+ * @param[in] delimiter - FIX SOH
+ * @param[out] index - array of index entries, one per field in order of appearance (BeginString, BodyLength, ...,
+ * CheckSum). Can be NULL if indexSize == 0
+ * @param[in] indexSize - count of entries in index array
+ * @param[out] count - count of fields in message. If count > indexSize, only indexSize entries are stored
+ * @param[out] checkSum - calculated message CheckSum (sum of bytes till CheckSum field modulo 256)
+ * @param[out] stop - pointer to the last char of message (CheckSum field delimiter)
+ * @param[out] error - error description
+ * @return FIX_SUCCESS - ok,
+ *         FIX_ERROR_NO_MORE_SPACE - index array is too small, see count for required size
+ *         FIX_FAILED - see error description
+ */
+FIX_PARSER_API FIXErrCode fix_parser_index(FIXParser* parser, char const* data, uint32_t len, char delimiter,
+      FIXFieldIndex* index, uint32_t indexSize, uint32_t* count, int32_t* checkSum, char const** stop, FIXError** error);
+
 /**
  * pre-parse string and return pair SenderCompID and TargetCompID
  * @param[in] data - message for pre-parsing
@@ -79,6 +191,72 @@ FIX_PARSER_API FIXErrCode fix_parser_get_header(char const* data, uint32_t len,
       char const** targetCompID, uint32_t* targetCompIDLen,
       int64_t* msgSeqNum, char* possDupFlag, FIXError** error);
 
+/**
+ * create new stream parser. Stream parser accepts data by chunks of arbitrary size (e.g. as it is received from socket)
+ * and returns complete messages.
+ * @param[in] parser - instance of FIX parser, used for parsing of complete messages
+ * @param[in] delimiter - FIX SOH
+ * @param[out] error - error description, if any. If error is returned it must be destroyed by fix_error_free(error)
+ * @return new instance of stream parser, NULL - see error description
+ */
+FIX_PARSER_API FIXStreamParser* fix_stream_parser_create(FIXParser* parser, char delimiter, FIXError** error);
+
+/**
+ * free stream parser instance. Parser, used by stream parser, is not freed
+ * @param[in] sparser - stream parser instance
+ */
+FIX_PARSER_API void fix_stream_parser_free(FIXStreamParser* sparser);
+
+/**
+ * pass next data chunk to stream parser. Chunk is not copied, so it must be valid till fix_stream_parser_next returns NULL.
+ * Only the tail of chunk with incomplete message is copied into stream parser
+ * @param[in] sparser - stream parser instance
+ * @param[in] data - data chunk
+ * @param[in] len - length of data chunk
+ * @param[out] error - error description, if any. If error is returned it must be destroyed by fix_error_free(error)
+ * @return FIX_SUCCESS - ok, FIX_FAILED - previous chunk is not processed yet
+ */
+FIX_PARSER_API FIXErrCode fix_stream_parser_feed(FIXStreamParser* sparser, char const* data, uint32_t len, FIXError** error);
+
+/**
+ * return next complete message
+ * @param[in] sparser - stream parser instance
+ * @param[out] error - error description, if any. If error is returned it must be destroyed by fix_error_free(error)
+ * @return new parsed message. NULL and error == NULL - more data required, NULL and error != NULL - message is broken
+ * and skipped, call fix_stream_parser_next again to get next message
+ * @note if parser is created with PARSER_FLAG_ZERO_COPY or PARSER_FLAG_LAZY flags, message can refer to the internal
+ * stream parser buffer, so it is valid only till the next call of fix_stream_parser_next
+ */
+FIX_PARSER_API FIXMsg* fix_stream_parser_next(FIXStreamParser* sparser, FIXError** error);
+
+/**
+ * callback for fix_parser_parse_log
+ * @param[in] msg - parsed message. It is freed after callback returns, so it must not be stored. NULL if message is broken
+ * @param[in] error - error description, if message is broken, else NULL. It is freed after callback returns
+ * @param[in] userData - user data, passed to fix_parser_parse_log
+ */
+typedef void (*FIXLogCallback)(FIXMsg* msg, FIXError* error, void* userData);
+
+/**
+ * parse big amount of FIX messages (e.g. mmap'ed FIX log) by several threads. Data is split by messages boundaries
+ * (field delimiter followed by '8=FIX') and each part is parsed by worker thread with its own memory pools, which
+ * shares protocol with parser
+ * @param[in] parser - instance of FIX parser. Its flags and attributes are used by workers
+ * @param[in] data - data with FIX messages
+ * @param[in] len - length of data
+ * @param[in] delimiter - FIX SOH
+ * @param[in] numThreads - count of worker threads. 0 - count of CPU cores
+ * @param[in] ordered - 1 - messages are delivered in the same order as in data. 0 - messages are delivered as soon as
+ * they parsed, so order of messages is not kept
+ * @param[in] callback - is called for each message. It is called from worker threads, but never concurrently if
+ * ordered == 1
+ * @param[in] userData - user data, passed to callback
+ * @param[out] error - error description, if any. If error is returned it must be destroyed by fix_error_free(error)
+ * @return FIX_SUCCESS - ok, FIX_FAILED - see error description. Errors of message parsing are passed to callback
+ */
+FIX_PARSER_API FIXErrCode fix_parser_parse_log(FIXParser* parser, char const* data, uint64_t len, char delimiter,
+      uint32_t numThreads, int32_t ordered, FIXLogCallback callback, void* userData, FIXError** error);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,127 @@
+/**
+ * @file   fix_protocol_tables.h
+ * @author Dmitry S. Melnikov, dmitryme@gmail.com
+ * @date   Created on: 10/16/2026 11:04:51 PM
+ *
+ * Tables of FIX protocol description. It is not a part of public API, it is only included by sources generated with
+ * fix_compiler, so they are compiled without library sources. Generated source checks FIX_PROTOCOL_TABLES_VERSION,
+ * which is increased on every change of tables layout.
+ */
+
+#ifndef FIX_PARSER_FIX_PROTOCOL_TABLES_H
+#define FIX_PARSER_FIX_PROTOCOL_TABLES_H
+
+#include "fix_types.h"
+
+#include <stdint.h>
+
+#pragma pack(push, 1)
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define FIX_PROTOCOL_TABLES_VERSION 1 ///< version of tables layout
+
+#define FIELD_TYPE_CNT 1000
+#define MSG_CNT   100
+#define FIELD_FLAG_REQUIRED 0x01
+
+/**
+ * slot of value table
+ */
+typedef struct FIXFieldValueSlot_
+{
+   char const* value;               ///< value longer than one char, NULL - free slot
+   uint32_t len;                    ///< length of value
+} FIXFieldValueSlot;
+
+/**
+ * possible values of FIX field type, compiled for validation
+ */
+typedef struct FIXFieldValues_
+{
+   uint64_t chars[4];               ///< bitmap of one char values
+   uint32_t count;                  ///< count of all values
+   char const** values;             ///< all values in description order
+   uint32_t size;                   ///< size of table, power of two. 0 - there are no values longer than one char
+   uint32_t seed;                   ///< hash seed, with which every longer value has own table slot
+   FIXFieldValueSlot* table;        ///< values longer than one char placed by hash
+} FIXFieldValues;
+
+/**
+ * description of FIX field type (entry in dictionary types)
+ */
+typedef struct FIXFieldType_
+{
+   FIXTagNum tag;                   ///< tag number
+   char prefix[12];                 ///< serialized "tag=", so tag number isn't converted on every serialization
+   uint8_t prefix_len;              ///< length of serialized prefix
+   uint32_t prefix_crc;             ///< sum of prefix bytes, used for incremental CheckSum
+   FIXFieldValueTypeEnum valueType; ///< type of field (string, number, length, etc)
+   char* name;                      ///< textual representation of field
+   FIXFieldValues* values;          ///< possible field values, NULL - any value is allowed
+   struct FIXFieldType_* next;      ///< next type in chain
+} FIXFieldType;
+
+/**
+ * descrion of FIX field
+ */
+typedef struct FIXFieldDescr_
+{
+   FIXFieldType* type;                  ///< type of FIX field
+   FIXFieldCategoryEnum category;       ///< category - value or group
+   uint8_t flags;                       ///< only FIELD_FLAG_REQUIRED is used
+   uint32_t group_count;                ///< count of field descriptions in group
+   struct FIXFieldDescr_*  group;       ///< all field descriptions indexed as array
+   struct FIXFieldDescr_** group_index; ///< collision-free table with field descriptions, indexed by tag % group_index_size
+   uint32_t group_index_size;           ///< size of group_index
+   struct FIXFieldDescr_*  dataLenField; ///< reference to field description. Not NULL if this field has valueType == Data.
+   uint64_t* group_required;            ///< bitmap of required group fields, indexed by position of field description
+} FIXFieldDescr;
+
+/**
+ * FIX message description
+ */
+typedef struct FIXMsgDescr_
+{
+   char* type;                   ///< type. E.g. "A", "AE", "D"
+   char* name;                   ///< textual message name
+   uint32_t field_count;         ///< count of field descriptions
+   FIXFieldDescr* fields;        ///< all fields indexed as array
+   FIXFieldDescr** field_index;  ///< collision-free table with fields, indexed by tag % field_index_size
+   uint32_t field_index_size;    ///< size of field_index
+   uint64_t* required;           ///< bitmap of required fields, indexed by position of field description
+   FIXTagNum* data_lens;         ///< tag of each Data field of message and its groups, followed by tag of its Length field
+   uint32_t data_len_count;      ///< count of Data fields in data_lens
+   struct FIXMsgDescr_* next;    ///< next description with the same hash key
+} FIXMsgDescr;
+
+/**
+ * FIX protocol description
+ */
+struct FIXProtocolDescr_
+{
+   char* version;                                        ///< protocol version ("FIX.4.4", "FIX.5.0", etc)
+   char* transportVersion;                               ///< version of transport protocol. If protocol doesn't have a transport transportVersion == version
+   FIXFieldType* field_types[FIELD_TYPE_CNT];            ///< array of field types
+   FIXFieldType* transport_field_types[FIELD_TYPE_CNT];  ///< field types of transport protocol
+   FIXMsgDescr* messages[MSG_CNT];                       ///< message descriptions (transport and application levels)
+   FIXFieldType** tag_types;                             ///< field types indexed by tag number (transport and application levels)
+   uint32_t tag_types_count;                             ///< size of tag_types array (max tag number + 1)
+   int32_t ref_count;                                    ///< count of owners (parsers and user references)
+   void const* image;                                    ///< mapped binary image, if description is loaded from image
+   uint32_t image_size;                                  ///< size of mapped image
+   void* arena;                                          ///< all descriptions and tables, which refer to image
+   FIXMsgDescr const* (*find_msg)(char const* type);     ///< generated message lookup by type, NULL - lookup in messages
+   int32_t is_static;                                    ///< 1 - description is generated static tables, it is never freed
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#pragma pack(pop)
+
+#endif /* FIX_PARSER_FIX_PROTOCOL_TABLES_H */
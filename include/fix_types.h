@@ -46,11 +46,16 @@ extern "C"
 #define FIX_ERROR_INTEGRITY_CHECK           -23
 #define FIX_ERROR_NO_MORE_DATA              -24
 #define FIX_ERROR_WRONG_FIELD_VALUE         -25
+#define FIX_ERROR_PROTOCOL_IMAGE_LOAD_FAILED -26
+#define FIX_ERROR_TOO_BIG_MSG               -27
 
 typedef struct FIXGroup_ FIXGroup;
 typedef struct FIXField_ FIXField;
 typedef struct FIXMsg_ FIXMsg;
 typedef struct FIXParser_ FIXParser;
+typedef struct FIXProtocolDescr_ FIXProtocolDescr;
+typedef struct FIXStreamParser_ FIXStreamParser;
+typedef struct FIXMsgTemplate_ FIXMsgTemplate;
 typedef struct FIXError_ FIXError;
 typedef int32_t FIXTagNum;  ///< FIX field tag type
 typedef int32_t FIXErrCode; ///< error code
@@ -61,6 +66,8 @@ typedef int32_t FIXErrCode; ///< error code
 #define PARSER_FLAG_CHECK_UNKNOWN_FIELDS 0x08 ///< check for unknown FIX fields during parsing. If not set all unknown fields ignored
 #define PARSER_FLAG_CHECK_ALL \
    (PARSER_FLAG_CHECK_CRC | PARSER_FLAG_CHECK_REQUIRED | PARSER_FLAG_CHECK_VALUE | PARSER_FLAG_CHECK_UNKNOWN_FIELDS) ///< make all possible checks during parsing.
+#define PARSER_FLAG_ZERO_COPY 0x10       ///< parsed field values are not copied, but refer to parsed string. String must live longer than message
+#define PARSER_FLAG_LAZY      0x20       ///< fields are parsed on first access. String must live longer than message
 
 /**
  * Determine FIX field category (simple value or group of fields)
@@ -133,8 +140,29 @@ typedef struct FIXParserAttrs
    uint32_t maxPages;     ///< Maximum alocated pages. 0 - not bounded, numPages - only numPages pages can be allocates. Default 0
    uint32_t numGroups;    ///< Groups allocated at parser creation. Default 1000
    uint32_t maxGroups;    ///< Maximum allocated groups. 0 - not bounded, numGroups - onlu numGroups groups can be allocated. Default 0
+   uint32_t maxMsgSize;   ///< Maximum size of message, which stream parser buffers. Longer messages are skipped. Default 1048576
 } FIXParserAttrs;
 
+/**
+ * entry of FIX message structural index. See fix_parser_index
+ */
+typedef struct FIXFieldIndex
+{
+   FIXTagNum tag;    ///< field tag number
+   uint32_t offset;  ///< offset of field value from the beginning of message
+   uint32_t len;     ///< length of field value
+} FIXFieldIndex;
+
+/**
+ * FIX field of message type, resolved once. See fix_msg_resolve_field
+ */
+typedef struct FIXFieldHandle
+{
+   struct FIXMsgDescr_ const* msg_descr; ///< description of message type, handle is valid for
+   FIXTagNum tag;                        ///< field tag number
+   uint32_t slot;                        ///< position of field in message description
+} FIXFieldHandle;
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,6 +6,10 @@
 #include "fix_parser.h"
 #include "fix_msg.h"
 #include "fix_error.h"
+#include "fix_utils.h"
+#include "fix_parser_priv.h"
+#include "fix_protocol_descr.h"
+#include "fix44_protocol.h"
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -86,6 +90,116 @@ void create_msg(FIXParser* parser)
    printf("%12s%12d%12d%10.2f\n", "create_msg", count, total, (float)total/count);
 }
 
+void create_msg_h(FIXParser* parser)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   FIXError* error = NULL;
+   FIXFieldHandle h[23];
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_SenderCompID, &h[0], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_TargetCompID, &h[1], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_MsgSeqNum, &h[2], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_TargetSubID, &h[3], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_SendingTime, &h[4], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_OrderID, &h[5], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_ClOrdID, &h[6], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_ExecID, &h[7], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_ExecType, &h[8], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_OrdStatus, &h[9], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_Account, &h[10], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_Symbol, &h[11], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_Side, &h[12], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_OrderQty, &h[13], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_Price, &h[14], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_TimeInForce, &h[15], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_LastQty, &h[16], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_LastPx, &h[17], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_LeavesQty, &h[18], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_CumQty, &h[19], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_AvgPx, &h[20], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_HandlInst, &h[21], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_Text, &h[22], &error);
+
+   GET_TIMESTAMP(start);
+
+   int32_t const count = 100000;
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      FIXMsg* msg = fix_msg_create(parser, "8", &error);
+      if (!msg)
+      {
+         printf("ERROR: %s\n", fix_error_get_text(error));
+         fix_error_free(error);
+         return;
+      }
+
+      assert(FIX_SUCCESS == fix_msg_set_string_h(msg, &h[0], "QWERTY_12345678", &error));
+      assert(FIX_SUCCESS == fix_msg_set_string_h(msg, &h[1], "ABCQWE_XYZ", &error));
+      assert(FIX_SUCCESS == fix_msg_set_int32_h(msg, &h[2], 34, &error));
+      assert(FIX_SUCCESS == fix_msg_set_string_h(msg, &h[3], "srv-ivanov_ii1", &error));
+      assert(FIX_SUCCESS == fix_msg_set_string_h(msg, &h[4], "20120716-06:00:16.230", &error));
+      assert(FIX_SUCCESS == fix_msg_set_string_h(msg, &h[5], "1", &error));
+      assert(FIX_SUCCESS == fix_msg_set_string_h(msg, &h[6], "CL_ORD_ID_1234567", &error));
+      assert(FIX_SUCCESS == fix_msg_set_string_h(msg, &h[7], "FE_1_9494_1", &error));
+      assert(FIX_SUCCESS == fix_msg_set_char_h(msg, &h[8], '0', &error));
+      assert(FIX_SUCCESS == fix_msg_set_char_h(msg, &h[9], '1', &error));
+      assert(FIX_SUCCESS == fix_msg_set_string_h(msg, &h[10], "ZUM", &error));
+      assert(FIX_SUCCESS == fix_msg_set_string_h(msg, &h[11], "RTS-12.12", &error));
+      assert(FIX_SUCCESS == fix_msg_set_char_h(msg, &h[12], '1', &error));
+      assert(FIX_SUCCESS == fix_msg_set_double_h(msg, &h[13], 25, &error));
+      assert(FIX_SUCCESS == fix_msg_set_double_h(msg, &h[14], 135155.0, &error));
+      assert(FIX_SUCCESS == fix_msg_set_char_h(msg, &h[15], '0', &error));
+      assert(FIX_SUCCESS == fix_msg_set_double_h(msg, &h[16], 0, &error));
+      assert(FIX_SUCCESS == fix_msg_set_double_h(msg, &h[17], 0.0, &error));
+      assert(FIX_SUCCESS == fix_msg_set_double_h(msg, &h[18], 25.0, &error));
+      assert(FIX_SUCCESS == fix_msg_set_double_h(msg, &h[19], 0, &error));
+      assert(FIX_SUCCESS == fix_msg_set_double_h(msg, &h[20], 0.0, &error));
+      assert(FIX_SUCCESS == fix_msg_set_char_h(msg, &h[21], '1', &error));
+      assert(FIX_SUCCESS == fix_msg_set_string_h(msg, &h[22], "COMMENT12", &error));
+
+      fix_msg_free(msg);
+   }
+
+   GET_TIMESTAMP(stop);
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "create_msg_h", count, total, (float)total/count);
+}
+
+void set_fields(FIXParser* parser, char const* msgType)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   FIXError* error = NULL;
+   FIXMsg* msg = fix_msg_create(parser, msgType, &error);
+   if (!msg)
+   {
+      printf("ERROR: %s\n", fix_error_get_text(error));
+      fix_error_free(error);
+      return;
+   }
+
+   int32_t const count = 1000000;
+
+   GET_TIMESTAMP(start);
+   for(int32_t i = 0; i < count; ++i) // field description is looked up by tag on each set
+   {
+      fix_msg_set_string(msg, NULL, FIXFieldTag_SenderCompID, "QWERTY_12345678", &error);
+      fix_msg_set_string(msg, NULL, FIXFieldTag_TargetCompID, "ABCQWE_XYZ", &error);
+      fix_msg_set_int32(msg, NULL, FIXFieldTag_MsgSeqNum, i, &error);
+      fix_msg_set_string(msg, NULL, FIXFieldTag_SendingTime, "20120716-06:00:16.230", &error);
+   }
+   GET_TIMESTAMP(stop);
+   fix_msg_free(msg);
+
+   char name[32];
+   snprintf(name, sizeof(name), "set_%s", msgType);
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", name, count, total, (float)total/count);
+}
+
 void msg_to_str(FIXParser* parser)
 {
    TIMESTAMP_INIT;
@@ -143,7 +257,361 @@ void msg_to_str(FIXParser* parser)
    printf("%12s%12d%12d%10.2f\n", "msg_to_str", count, total, (float)total/count);
 }
 
-void str_to_msg(FIXParser* parser)
+void msg_template(FIXParser* parser)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   FIXError* error = NULL;
+   FIXMsg* msg = fix_msg_create(parser, "8", &error);
+   if (!msg)
+   {
+      printf("ERROR: %s\n", fix_error_get_text(error));
+      fix_error_free(error);
+      return;
+   }
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_SenderCompID, "QWERTY_12345678", &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_TargetCompID, "ABCQWE_XYZ", &error));
+   assert(FIX_SUCCESS == fix_msg_set_int32(msg, NULL, FIXFieldTag_MsgSeqNum, 34, &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_TargetSubID, "srv-ivanov_ii1", &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_SendingTime, "20120716-06:00:16.230", &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_OrderID, "1", &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_ClOrdID, "CL_ORD_ID_1234567", &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_ExecID, "FE_1_9494_1", &error));
+   assert(FIX_SUCCESS == fix_msg_set_char(msg, NULL, FIXFieldTag_ExecType, '0', &error));
+   assert(FIX_SUCCESS == fix_msg_set_char(msg, NULL, FIXFieldTag_OrdStatus, '1', &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_Account, "ZUM", &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_Symbol, "RTS-12.12", &error));
+   assert(FIX_SUCCESS == fix_msg_set_char(msg, NULL, FIXFieldTag_Side, '1', &error));
+   assert(FIX_SUCCESS == fix_msg_set_double(msg, NULL, FIXFieldTag_OrderQty, 25, &error));
+   assert(FIX_SUCCESS == fix_msg_set_double(msg, NULL, FIXFieldTag_Price, 135155.0, &error));
+   assert(FIX_SUCCESS == fix_msg_set_char(msg, NULL, FIXFieldTag_TimeInForce, '0', &error));
+   assert(FIX_SUCCESS == fix_msg_set_double(msg, NULL, FIXFieldTag_LastQty, 0, &error));
+   assert(FIX_SUCCESS == fix_msg_set_double(msg, NULL, FIXFieldTag_LastPx, 0.0, &error));
+   assert(FIX_SUCCESS == fix_msg_set_double(msg, NULL, FIXFieldTag_LeavesQty, 25.0, &error));
+   assert(FIX_SUCCESS == fix_msg_set_double(msg, NULL, FIXFieldTag_CumQty, 0, &error));
+   assert(FIX_SUCCESS == fix_msg_set_double(msg, NULL, FIXFieldTag_AvgPx, 0.0, &error));
+   assert(FIX_SUCCESS == fix_msg_set_char(msg, NULL, FIXFieldTag_HandlInst, '1', &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_Text, "COMMENT12", &error));
+
+   FIXFieldHandle h[5];
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_MsgSeqNum, &h[0], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_SendingTime, &h[1], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_ClOrdID, &h[2], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_Price, &h[3], &error);
+   fix_msg_resolve_field(parser, "8", FIXFieldTag_OrderQty, &h[4], &error);
+   FIXMsgTemplate* tmpl = fix_msg_template_create(msg, '|', h, 5, &error);
+   fix_msg_free(msg);
+   if (!tmpl)
+   {
+      printf("ERROR: %s\n", fix_error_get_text(error));
+      fix_error_free(error);
+      return;
+   }
+
+   GET_TIMESTAMP(start);
+
+   int32_t const count = 100000;
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      assert(FIX_SUCCESS == fix_msg_template_set_int64(tmpl, 0, i, &error));
+      assert(FIX_SUCCESS == fix_msg_template_set_string(tmpl, 1, "20120716-06:00:16.230", &error));
+      assert(FIX_SUCCESS == fix_msg_template_set_string(tmpl, 2, "CL_ORD_ID_1234567", &error));
+      assert(FIX_SUCCESS == fix_msg_template_set_double(tmpl, 3, 135155.0, &error));
+      assert(FIX_SUCCESS == fix_msg_template_set_double(tmpl, 4, 25, &error));
+
+      char buff[1024];
+      uint32_t reqBuffLen = 0;
+      fix_msg_template_to_str(tmpl, buff, sizeof(buff), &reqBuffLen, &error);
+   }
+
+   GET_TIMESTAMP(stop);
+
+   fix_msg_template_free(tmpl);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "msg_template", count, total, (float)total/count);
+}
+
+void serialize_msg(FIXParser* parser, char delimiter, int32_t iovec, char const* name)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   FIXError* error = NULL;
+   FIXMsg* msg = fix_msg_create(parser, "8", &error);
+   if (!msg)
+   {
+      printf("ERROR: %s\n", fix_error_get_text(error));
+      fix_error_free(error);
+      return;
+   }
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_SenderCompID, "QWERTY_12345678", &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_TargetCompID, "ABCQWE_XYZ", &error));
+   assert(FIX_SUCCESS == fix_msg_set_int32(msg, NULL, FIXFieldTag_MsgSeqNum, 34, &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_SendingTime, "20120716-06:00:16.230", &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_OrderID, "1", &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_ClOrdID, "CL_ORD_ID_1234567", &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_ExecID, "FE_1_9494_1", &error));
+   assert(FIX_SUCCESS == fix_msg_set_char(msg, NULL, FIXFieldTag_ExecType, '0', &error));
+   assert(FIX_SUCCESS == fix_msg_set_char(msg, NULL, FIXFieldTag_OrdStatus, '1', &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_Symbol, "RTS-12.12", &error));
+   assert(FIX_SUCCESS == fix_msg_set_char(msg, NULL, FIXFieldTag_Side, '1', &error));
+   assert(FIX_SUCCESS == fix_msg_set_double(msg, NULL, FIXFieldTag_Price, 135155.0, &error));
+   assert(FIX_SUCCESS == fix_msg_set_double(msg, NULL, FIXFieldTag_LeavesQty, 25.0, &error));
+   assert(FIX_SUCCESS == fix_msg_set_double(msg, NULL, FIXFieldTag_CumQty, 0, &error));
+   assert(FIX_SUCCESS == fix_msg_set_double(msg, NULL, FIXFieldTag_AvgPx, 0.0, &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_Text, "COMMENT12", &error));
+
+   GET_TIMESTAMP(start);
+
+   int32_t const count = 100000;
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      char buff[1024];
+      uint32_t reqBuffLen = 0;
+      if (iovec)
+      {
+         struct iovec iov[16];
+         uint32_t reqIovCount = 0;
+         fix_msg_to_iovec(msg, delimiter, iov, 16, &reqIovCount, buff, sizeof(buff), &reqBuffLen, &error);
+      }
+      else
+      {
+         fix_msg_to_str(msg, delimiter, buff, sizeof(buff), &reqBuffLen, &error);
+      }
+   }
+
+   GET_TIMESTAMP(stop);
+
+   fix_msg_free(msg);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", name, count, total, (float)total/count);
+}
+
+void render_tags(FIXParser* parser)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   FIXTagNum const tags[] = {35, 49, 56, 34, 52, 37, 11, 17, 150, 39, 1, 55, 54, 38, 44, 59, 151, 14, 6, 58};
+   uint32_t const tag_count = sizeof(tags) / sizeof(tags[0]);
+   FIXFieldType const* types[sizeof(tags) / sizeof(tags[0])];
+   for(uint32_t i = 0; i < tag_count; ++i)
+   {
+      types[i] = fix_protocol_get_field_type_by_tag(parser->protocol, tags[i]);
+      assert(types[i]);
+   }
+
+   int32_t const count = 1000000; // tags are rendered too fast for microseconds, so time per tag is in nanoseconds
+   char buff[32];
+   uint32_t len = 0;
+
+   GET_TIMESTAMP(start);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      for(uint32_t j = 0; j < tag_count; ++j)
+      {
+         int32_t res = fix_utils_i64toa(types[j]->tag, buff, sizeof(buff), 0);
+         buff[res] = '=';
+         len += res + 1;
+      }
+   }
+   GET_TIMESTAMP(stop);
+   int32_t total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "tag_itoa", count * tag_count, total, (float)total * 1000 / (count * tag_count));
+
+   GET_TIMESTAMP(start);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      for(uint32_t j = 0; j < tag_count; ++j)
+      {
+         memcpy(buff, types[j]->prefix, types[j]->prefix_len);
+         len += types[j]->prefix_len;
+      }
+   }
+   GET_TIMESTAMP(stop);
+   total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "tag_prefix", count * tag_count, total, (float)total * 1000 / (count * tag_count));
+   if (len == 0 || buff[0] == 0) // keep rendering from being optimized out
+   {
+      printf("ERROR: nothing rendered\n");
+   }
+}
+
+void format_numbers(void)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   int32_t const count = 1000000; // time per value is in nanoseconds
+   double const prices[] = {135155.0, 135155.5, 25.0, 0.0001, 99.99, 1234567.125, 0.1 + 0.2, 76.03};
+   uint32_t const price_count = sizeof(prices) / sizeof(prices[0]);
+   char buff[64];
+   uint32_t len = 0;
+
+   GET_TIMESTAMP(start);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      len += fix_utils_i64toa(i * 7919LL, buff, sizeof(buff), 0);
+   }
+   GET_TIMESTAMP(stop);
+   int32_t total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "fmt_i64toa", count, total, (float)total * 1000 / count);
+
+   GET_TIMESTAMP(start);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      len += snprintf(buff, sizeof(buff), "%lld", i * 7919LL);
+   }
+   GET_TIMESTAMP(stop);
+   total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "fmt_lld", count, total, (float)total * 1000 / count);
+
+   GET_TIMESTAMP(start);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      len += fix_utils_dtoa(prices[i % price_count], buff, sizeof(buff));
+   }
+   GET_TIMESTAMP(stop);
+   total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "fmt_dtoa", count, total, (float)total * 1000 / count);
+
+   GET_TIMESTAMP(start);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      len += fix_utils_dtoa_fixed(prices[i % price_count], 4, buff, sizeof(buff));
+   }
+   GET_TIMESTAMP(stop);
+   total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "fmt_fixed", count, total, (float)total * 1000 / count);
+
+   GET_TIMESTAMP(start);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      len += snprintf(buff, sizeof(buff), "%.4f", prices[i % price_count]);
+   }
+   GET_TIMESTAMP(stop);
+   total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "fmt_4f", count, total, (float)total * 1000 / count);
+   if (len == 0)
+   {
+      printf("ERROR: nothing formatted\n");
+   }
+}
+
+static int32_t atoi_bytewise(char const* buff, char stopChar, int32_t* cnt)
+{
+   int32_t val = 0;
+   int32_t sign = 1;
+   char const* p = buff;
+   if (*p == '-')
+   {
+      sign = -1;
+      ++p;
+   }
+   for(; *p != stopChar; ++p)
+   {
+      val = val * 10 + (*p - '0');
+   }
+   *cnt = p - buff;
+   return val * sign;
+}
+
+static double atod_bytewise(char const* buff, char stopChar, int32_t* cnt)
+{
+   double val = 0.0;
+   double exp = 0.1;
+   char const* p = buff;
+   for(; *p != stopChar && *p != '.'; ++p)
+   {
+      val = val * 10 + (*p - '0');
+   }
+   if (*p == '.')
+   {
+      for(++p; *p != stopChar; ++p, exp /= 10)
+      {
+         val += (*p - '0') * exp;
+      }
+   }
+   *cnt = p - buff;
+   return val;
+}
+
+void parse_numbers(void)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   int32_t const count = 1000000; // time per value is in nanoseconds
+   // tags, lengths and sequence numbers as they are met in messages
+   char const* ints[] = {"35\001", "49\001", "10\001", "453\001", "9999\001", "1\001", "1234\001", "7654321\001", "178\001"};
+   char const* prices[] = {"135155.25\001", "0.0001\001", "99.99\001", "1234567.125\001", "25\001", "76.03\001", "1.23456789\001"};
+   uint32_t const int_count = sizeof(ints) / sizeof(ints[0]);
+   uint32_t const price_count = sizeof(prices) / sizeof(prices[0]);
+   char int_buff[sizeof(ints) / sizeof(ints[0])][32]; // values are followed by the rest of message, as parser sees them
+   char price_buff[sizeof(prices) / sizeof(prices[0])][32];
+   for(uint32_t i = 0; i < int_count; ++i)
+   {
+      snprintf(int_buff[i], sizeof(int_buff[i]), "%s52=20121107-10:20:30", ints[i]);
+   }
+   for(uint32_t i = 0; i < price_count; ++i)
+   {
+      snprintf(price_buff[i], sizeof(price_buff[i]), "%s52=20121107-10:20:30", prices[i]);
+   }
+   int64_t sum = 0;
+   double dsum = 0.0;
+   int32_t cnt = 0;
+
+   GET_TIMESTAMP(start);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      sum += atoi_bytewise(int_buff[i % int_count], FIX_SOH, &cnt) + cnt;
+   }
+   GET_TIMESTAMP(stop);
+   int32_t total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "atoi_byte", count, total, (float)total * 1000 / count);
+
+   GET_TIMESTAMP(start);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      int32_t val = 0;
+      fix_utils_atoi32(int_buff[i % int_count], sizeof(int_buff[0]), FIX_SOH, &val, &cnt);
+      sum -= val + cnt;
+   }
+   GET_TIMESTAMP(stop);
+   total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "atoi_swar", count, total, (float)total * 1000 / count);
+
+   GET_TIMESTAMP(start);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      dsum += atod_bytewise(price_buff[i % price_count], FIX_SOH, &cnt) + cnt;
+   }
+   GET_TIMESTAMP(stop);
+   total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "atod_byte", count, total, (float)total * 1000 / count);
+
+   GET_TIMESTAMP(start);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      double val = 0.0;
+      fix_utils_atod(price_buff[i % price_count], sizeof(price_buff[0]), FIX_SOH, &val, &cnt);
+      dsum -= val + cnt;
+   }
+   GET_TIMESTAMP(stop);
+   total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "atod_swar", count, total, (float)total * 1000 / count);
+   if (sum != 0 || dsum > 1.0 || dsum < -1.0)
+   {
+      printf("ERROR: parsed values differ\n");
+   }
+}
+
+void str_to_msg(FIXParser* parser, char const* name)
 {
    TIMESTAMP_INIT;
    TIMESTAMP start, stop;
@@ -169,14 +637,342 @@ void str_to_msg(FIXParser* parser)
    GET_TIMESTAMP(stop);
 
    int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
-   printf("%12s%12d%12d%10.2f\n", "str_to_msg", count, total, (float)total/count);
+   printf("%12s%12d%12d%10.2f\n", name, count, total, (float)total/count);
+}
+
+void check_value(FIXParser* parser)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   FIXError* error = NULL;
+   FIXMsgDescr const* msg = fix_protocol_get_msg_descr(parser, "8", &error);
+   if (!msg)
+   {
+      printf("ERROR: %s\n", fix_error_get_text(error));
+      fix_error_free(error);
+      return;
+   }
+   struct { FIXTagNum tag; char const* value; } const checks[] =
+   {
+      {FIXFieldTag_ExecType, "0"}, {FIXFieldTag_OrdStatus, "1"}, {FIXFieldTag_Side, "1"}, {FIXFieldTag_TimeInForce, "0"},
+      {FIXFieldTag_OrdRejReason, "10"}, {FIXFieldTag_SecurityType, "FUT"}, {FIXFieldTag_SecurityType, "FAKE"}
+   };
+   uint32_t const check_count = sizeof(checks) / sizeof(checks[0]);
+   FIXFieldDescr const* fdescrs[sizeof(checks) / sizeof(checks[0])];
+   uint32_t lens[sizeof(checks) / sizeof(checks[0])];
+   for(uint32_t i = 0; i < check_count; ++i)
+   {
+      fdescrs[i] = fix_protocol_get_field_descr(msg, checks[i].tag);
+      lens[i] = strlen(checks[i].value);
+      if (!fdescrs[i])
+      {
+         return;
+      }
+   }
+
+   int32_t const count = 1000000;
+   int32_t valid = 0;
+
+   GET_TIMESTAMP(start);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      for(uint32_t j = 0; j < check_count; ++j)
+      {
+         valid += fix_protocol_check_field_value(fdescrs[j], checks[j].value, lens[j]);
+      }
+   }
+   GET_TIMESTAMP(stop);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f ns\n", "check_value", count * check_count, total, (float)total * 1000 / (count * check_count));
+   if (valid != count * (check_count - 1)) // the last value is wrong
+   {
+      printf("ERROR: wrong count of valid values %d\n", valid);
+   }
+}
+
+void stream_to_msg(FIXParser* parser)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   char buff[] = "8=FIX.4.4|9=228|35=8|49=QWERTY_12345678|56=ABCQWE_XYZ|34=34|57=srv-ivanov_ii1|52=20120716-06:00:16.230|37=1|11=CL_ORD_ID_1234567|17=FE_1_9494_1|150=0|39=1|1=ZUM|55=RTS-12.12|54=1|38=25|44=135155|59=0|32=0|31=0|151=25|14=0|6=0|21=1|58=COMMENT12|10=110|";
+   uint32_t const len = strlen(buff);
+   uint32_t const chunk = len * 2 / 3; // every message straddles two chunks
+
+   FIXError* error = NULL;
+   FIXStreamParser* sparser = fix_stream_parser_create(parser, '|', &error);
+
+   GET_TIMESTAMP(start);
+
+   int32_t const count = 100000;
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      FIXMsg* msg = NULL;
+      fix_stream_parser_feed(sparser, buff, chunk, &error);
+      msg = fix_stream_parser_next(sparser, &error);
+      assert(msg == NULL);
+      fix_stream_parser_feed(sparser, buff + chunk, len - chunk, &error);
+      msg = fix_stream_parser_next(sparser, &error);
+      assert(msg != NULL);
+      fix_msg_free(msg);
+   }
+
+   GET_TIMESTAMP(stop);
+
+   fix_stream_parser_free(sparser);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "stream", count, total, (float)total/count);
+}
+
+void str_to_msgs(FIXParser* parser, char const* fileName)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   char* buff = NULL;
+   uint32_t len = 0;
+   char delimiter = '|';
+   if (fileName) // file with concatenated messages
+   {
+      FILE* file = fopen(fileName, "rb");
+      if (!file)
+      {
+         printf("ERROR: unable to open '%s'\n", fileName);
+         return;
+      }
+      fseek(file, 0, SEEK_END);
+      len = ftell(file);
+      fseek(file, 0, SEEK_SET);
+      buff = (char*)malloc(len);
+      len = fread(buff, 1, len, file);
+      fclose(file);
+      delimiter = (memchr(buff, 1, len) ? 1 : '|');
+   }
+   else
+   {
+      char msg[] = "8=FIX.4.4|9=228|35=8|49=QWERTY_12345678|56=ABCQWE_XYZ|34=34|57=srv-ivanov_ii1|52=20120716-06:00:16.230|37=1|11=CL_ORD_ID_1234567|17=FE_1_9494_1|150=0|39=1|1=ZUM|55=RTS-12.12|54=1|38=25|44=135155|59=0|32=0|31=0|151=25|14=0|6=0|21=1|58=COMMENT12|10=110|";
+      uint32_t const msgLen = strlen(msg);
+      uint32_t const msgCount = 10000;
+      buff = (char*)malloc(msgLen * msgCount);
+      for(uint32_t i = 0; i < msgCount; ++i)
+      {
+         memcpy(buff + len, msg, msgLen);
+         len += msgLen;
+      }
+   }
+
+   FIXMsg* msgs[256];
+   int32_t const loops = 10;
+   int32_t count = 0;
+   int32_t failed = 0;
+
+   GET_TIMESTAMP(start);
+
+   for(int32_t i = 0; i < loops; ++i)
+   {
+      char const* it = buff;
+      char const* end = buff + len;
+      while(it != end)
+      {
+         char const* stop = NULL;
+         uint32_t const n = fix_parser_str_to_msgs(parser, it, end - it, delimiter, msgs, NULL, sizeof(msgs) / sizeof(msgs[0]), &stop);
+         for(uint32_t j = 0; j < n; ++j)
+         {
+            failed += (msgs[j] == NULL);
+            fix_msg_free(msgs[j]);
+         }
+         count += n;
+         if (!n) // incomplete message at the end of file
+         {
+            break;
+         }
+         it = stop;
+      }
+   }
+
+   GET_TIMESTAMP(stop);
+
+   free(buff);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f  %.0f msg/sec, %d failed\n",
+         "str_to_msgs", count, total, (float)total/count, (double)count * 1000000 / total, failed);
+}
+
+static void parse_log_callback(FIXMsg* msg, FIXError* error, void* userData)
+{
+   (void)msg;
+   (void)error;
+   (void)userData;
+}
+
+void parse_log(FIXParser* parser)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   char msg[] = "8=FIX.4.4|9=228|35=8|49=QWERTY_12345678|56=ABCQWE_XYZ|34=34|57=srv-ivanov_ii1|52=20120716-06:00:16.230|37=1|11=CL_ORD_ID_1234567|17=FE_1_9494_1|150=0|39=1|1=ZUM|55=RTS-12.12|54=1|38=25|44=135155|59=0|32=0|31=0|151=25|14=0|6=0|21=1|58=COMMENT12|10=110|";
+   uint32_t const msgLen = strlen(msg);
+   int32_t const count = 200000;
+   char* buff = (char*)malloc((uint64_t)msgLen * count);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      memcpy(buff + (uint64_t)i * msgLen, msg, msgLen);
+   }
+
+   static char const* names[] = {"log_1thr", "log_2thr", "log_4thr"};
+   for(uint32_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i)
+   {
+      FIXError* error = NULL;
+      GET_TIMESTAMP(start);
+      fix_parser_parse_log(parser, buff, (uint64_t)msgLen * count, '|', 1 << i, 0, &parse_log_callback, NULL, &error);
+      GET_TIMESTAMP(stop);
+      int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+      printf("%12s%12d%12d%10.2f  %.0f msg/sec\n", names[i], count, total, (float)total/count, (double)count * 1000000 / total);
+   }
+
+   free(buff);
+}
+
+void str_to_msg_simd(FIXParser* parser)
+{
+   static char const* names[] = {"s2m_scalar", "s2m_sse2", "s2m_avx2"};
+   int32_t const level = fix_utils_simd_level();
+   for(int32_t i = FIX_SIMD_NONE; i <= FIX_SIMD_AVX2; ++i)
+   {
+      if (fix_utils_set_simd_level(i) == i)
+      {
+         str_to_msg(parser, names[i]);
+      }
+   }
+   fix_utils_set_simd_level(level);
+}
+
+void create_parsers(char const* protFile)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   FIXParser* parsers[32];
+   int32_t const count = sizeof(parsers) / sizeof(parsers[0]);
+   FIXError* error = NULL;
+
+   GET_TIMESTAMP(start);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      parsers[i] = fix_parser_create(protFile, NULL, PARSER_FLAG_CHECK_ALL, &error);
+      assert(parsers[i] != NULL);
+   }
+   GET_TIMESTAMP(stop);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      fix_parser_free(parsers[i]);
+   }
+   int32_t total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "prs_create", count, total, (float)total/count);
+
+   GET_TIMESTAMP(start);
+   FIXProtocolDescr const* protocol = fix_protocol_create(protFile, &error);
+   assert(protocol != NULL);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      parsers[i] = fix_parser_create_from_protocol(protocol, NULL, PARSER_FLAG_CHECK_ALL, &error);
+      assert(parsers[i] != NULL);
+   }
+   GET_TIMESTAMP(stop);
+   fix_protocol_free(protocol);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      fix_parser_free(parsers[i]);
+   }
+   total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "prs_shared", count, total, (float)total/count);
+
+   protocol = fix_protocol_create(protFile, &error);
+   assert(protocol != NULL);
+   if (fix_protocol_save_image(protocol, "perf_test.img", &error) == FIX_FAILED)
+   {
+      printf("ERROR: %s\n", fix_error_get_text(error));
+      fix_error_free(error);
+      fix_protocol_free(protocol);
+      return;
+   }
+   fix_protocol_free(protocol);
+   GET_TIMESTAMP(start);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      parsers[i] = fix_parser_create_from_image("perf_test.img", NULL, PARSER_FLAG_CHECK_ALL, &error);
+      assert(parsers[i] != NULL);
+   }
+   GET_TIMESTAMP(stop);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      fix_parser_free(parsers[i]);
+   }
+   remove("perf_test.img");
+   total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "prs_image", count, total, (float)total/count);
+
+   GET_TIMESTAMP(start);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      parsers[i] = fix_parser_create_from_protocol(fix44_protocol(), NULL, PARSER_FLAG_CHECK_ALL, &error);
+      assert(parsers[i] != NULL);
+   }
+   GET_TIMESTAMP(stop);
+   for(int32_t i = 0; i < count; ++i)
+   {
+      fix_parser_free(parsers[i]);
+   }
+   total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "prs_static", count, total, (float)total/count);
+}
+
+void load_protocols(char const* protFile)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   static char const* files[] = {"fix.4.2.xml", "fix.4.3.xml", "fix.4.4.xml", "fix.5.0.xml", "fix.5.0.sp1.xml", "fix.5.0.sp2.xml"};
+   int32_t const count = 10;
+
+   for(uint32_t i = 0; i < sizeof(files) / sizeof(files[0]); ++i)
+   {
+      char path[1024];
+      if (fix_utils_make_path(protFile, files[i], path, sizeof(path)) == FIX_FAILED) // dictionaries next to protFile
+      {
+         return;
+      }
+      FIXError* error = NULL;
+      GET_TIMESTAMP(start);
+      for(int32_t j = 0; j < count; ++j)
+      {
+         FIXProtocolDescr const* protocol = fix_protocol_create(path, &error);
+         if (!protocol)
+         {
+            printf("ERROR: %s\n", fix_error_get_text(error));
+            fix_error_free(error);
+            return;
+         }
+         fix_protocol_free(protocol);
+      }
+      GET_TIMESTAMP(stop);
+      char name[32];
+      snprintf(name, sizeof(name), "ld_%.*s", (int)(strlen(files[i]) - 8), files[i] + 4); // fix.5.0.sp2.xml -> ld_5.0.sp2
+      int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+      printf("%12s%12d%12d%10.2f\n", name, count, total, (float)total/count);
+   }
 }
 
 int main(int argc, char *argv[])
 {
    if (argc == 1)
    {
-      printf("perf_test <prot_file.xml>\n");
+      printf("perf_test <prot_file.xml> [file_with_messages]\n");
       return 1;
    }
 
@@ -190,9 +986,63 @@ int main(int argc, char *argv[])
    }
 
    printf("%12s%12s%12s%12s", "test", "count", "total", "per msg\n");
+   load_protocols(argv[1]);
+   create_parsers(argv[1]);
    create_msg(parser);
+   create_msg_h(parser);
+   set_fields(parser, "8");
+   set_fields(parser, "D");
+   set_fields(parser, "W");
    msg_to_str(parser);
-   str_to_msg(parser);
+   msg_template(parser);
+   serialize_msg(parser, '|', 0, "m2s_pipe");
+   serialize_msg(parser, FIX_SOH, 0, "m2s_soh");
+   serialize_msg(parser, FIX_SOH, 1, "m2s_iovec");
+   render_tags(parser);
+   format_numbers();
+   parse_numbers();
+   str_to_msg(parser, "str_to_msg");
+   check_value(parser);
+   str_to_msg_simd(parser);
+   stream_to_msg(parser);
+   str_to_msgs(parser, argc > 2 ? argv[2] : NULL);
+   parse_log(parser);
+
+   FIXParser* zparser = fix_parser_create(argv[1], NULL, PARSER_FLAG_CHECK_ALL | PARSER_FLAG_ZERO_COPY, &error);
+   if (zparser)
+   {
+      str_to_msg(zparser, "s2m_zcopy");
+      fix_parser_free(zparser);
+   }
+   FIXParser* nparser = fix_parser_create(argv[1], NULL, PARSER_FLAG_CHECK_ALL & ~PARSER_FLAG_CHECK_VALUE, &error);
+   if (nparser)
+   {
+      str_to_msg(nparser, "s2m_novalue");
+      fix_parser_free(nparser);
+   }
+   FIXParser* rparser = fix_parser_create(argv[1], NULL, PARSER_FLAG_CHECK_ALL & ~PARSER_FLAG_CHECK_REQUIRED, &error);
+   if (rparser)
+   {
+      str_to_msg(rparser, "s2m_noreq");
+      serialize_msg(rparser, FIX_SOH, 0, "m2s_noreq");
+      fix_parser_free(rparser);
+   }
+   FIXParser* lparser = fix_parser_create(argv[1], NULL, PARSER_FLAG_CHECK_ALL | PARSER_FLAG_LAZY, &error);
+   if (lparser)
+   {
+      str_to_msg(lparser, "s2m_lazy");
+      fix_parser_free(lparser);
+   }
+
+   if (!strcmp(parser->protocol->version, fix44_protocol()->version)) // generated tables are for FIX.4.4 only
+   {
+      FIXParser* sparser = fix_parser_create_from_protocol(fix44_protocol(), NULL, PARSER_FLAG_CHECK_ALL, &error);
+      if (sparser)
+      {
+         str_to_msg(sparser, "s2m_static");
+         fix_parser_free(sparser);
+      }
+   }
 
    fix_parser_free(parser);
 
@@ -9,11 +9,19 @@
 #include "fix_parser_priv.h"
 #include "fix_msg_priv.h"
 #include "fix_utils.h"
+#include "fix_protocol_descr.h"
 
 #include <stdlib.h>
 #include <string.h>
 
-static FIXField* fix_field_free(FIXMsg* msg, FIXField* field);
+static FIXFieldDescr const* fix_group_descrs(FIXMsg const* msg, FIXGroup const* group, uint32_t* count);
+static FIXField* fix_field_find(FIXGroup const* group, int32_t slot, FIXTagNum tag);
+static FIXField* fix_field_set_slot(FIXMsg* msg, FIXGroup* group, FIXFieldDescr const* descr, int32_t slot,
+      unsigned char const* data, uint32_t len, FIXError** error);
+static FIXField* fix_field_create(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr, int32_t slot, FIXError** error);
+static void fix_field_update_body_len(FIXMsg* msg, FIXField* field);
+static void fix_field_update_group_len(FIXMsg* msg, FIXField* field);
+static void fix_field_free(FIXMsg* msg, FIXField* field);
 static void fix_group_free(FIXMsg* msg, FIXGroup* group);
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
@@ -22,98 +30,151 @@ static void fix_group_free(FIXMsg* msg, FIXGroup* group);
 FIXField* fix_field_set(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr, unsigned char const* data, uint32_t len,
       FIXError** error)
 {
-   FIXField* field = fix_field_get(msg, grp, descr->type->tag);
+   FIXGroup* group = grp ? grp : msg->fields;
+   return fix_field_set_slot(msg, group, descr, fix_field_get_slot(msg, group, descr->type->tag), data, len, error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXField* fix_field_set_ref(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr, char const* data, uint32_t len,
+      FIXError** error)
+{
+   FIXGroup* group = grp ? grp : msg->fields;
+   int32_t const slot = fix_field_get_slot(msg, group, descr->type->tag);
+   FIXField* field = fix_field_find(group, slot, descr->type->tag);
    if (field && field->descr->category == FIXFieldCategory_Group)
    {
       *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "FIXField has wrong type");
       return NULL;
    }
-   int32_t idx = descr->type->tag % GROUP_SIZE;
    if (!field)
    {
-      field = (FIXField*)fix_msg_alloc(msg, sizeof(FIXField), error);
+      field = fix_field_create(msg, group, descr, slot, error);
       if (!field)
       {
          return NULL;
       }
-      field->descr = descr;
-      FIXGroup* group = (grp ? grp : msg->fields);
-      field->next = group->fields[idx];
-      group->fields[idx] = field;
-      field->size = len;
-      field->data = (char*)fix_msg_alloc(msg, len, error);
-      field->body_len = 0;
    }
-   else
+   field->size = len;
+   field->data = (char*)data;
+   field->flags |= FIELD_DATA_EXTERNAL;
+   fix_field_update_body_len(msg, field);
+   return field;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXField* fix_field_get(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag)
+{
+   FIXGroup* group = grp ? grp : msg->fields;
+   return fix_field_find(group, fix_field_get_slot(msg, group, tag), tag);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+int32_t fix_field_get_slot(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag)
+{
+   FIXGroup const* group = grp ? grp : msg->fields;
+   FIXFieldDescr const* fdescr = NULL;
+   if (group->parent_fdescr)
    {
-      field->size = len;
-      field->data = (char*)fix_msg_realloc(msg, field->data, len, error);
-      msg->body_len -= field->body_len;
+      fdescr = group->parent_fdescr->group_index ? fix_protocol_get_group_descr(group->parent_fdescr, tag) : NULL;
+      return fdescr ? fdescr - group->parent_fdescr->group : -1;
    }
-   if (!field->data)
+   fdescr = msg->descr ? fix_protocol_get_field_descr(msg->descr, tag) : NULL;
+   return fdescr ? fdescr - msg->descr->fields : -1;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXField* fix_field_get_by_slot(FIXMsg* msg, FIXGroup* grp, uint32_t slot)
+{
+   FIXGroup const* group = grp ? grp : msg->fields;
+   if (!group->slots || !group->slots[slot])
    {
       return NULL;
    }
-   if (LIKE(field->descr->type->tag != FIXFieldTag_BeginString &&
-            field->descr->type->tag != FIXFieldTag_BodyLength &&
-            field->descr->type->tag != FIXFieldTag_CheckSum))
-   {
-      field->body_len = fix_utils_numdigits(descr->type->tag) + 1 + len + 1;
-   }
-   memcpy(field->data, data, len);
-   msg->body_len += field->body_len;
-   return field;
+   return &group->fields[group->slots[slot] - 1];
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
-FIXField* fix_field_get(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag)
+FIXField* fix_field_set_by_slot(FIXMsg* msg, FIXGroup* grp, uint32_t slot, unsigned char const* data, uint32_t len,
+      FIXError** error)
 {
-   uint32_t const idx = tag % GROUP_SIZE;
-   FIXField* it = (grp ? grp : msg->fields)->fields[idx];
-   while(it)
+   FIXGroup* group = grp ? grp : msg->fields;
+   uint32_t count = 0;
+   FIXFieldDescr const* descrs = fix_group_descrs(msg, group, &count);
+   if (!descrs || slot >= count)
    {
-      if (it->descr->type->tag == tag)
-      {
-         return it;
-      }
-      it = it->next;
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Wrong field slot %u", slot);
+      return NULL;
    }
-   return it;
+   return fix_field_set_slot(msg, group, &descrs[slot], slot, data, len, error);
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIXErrCode fix_field_del(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag, FIXError** error)
 {
-   uint32_t const idx = tag % GROUP_SIZE;
    FIXGroup* group = grp ? grp : msg->fields;
-   FIXField* field = group->fields[idx];
-   FIXField* prev = field;
-   while(field)
+   FIXField* field = fix_field_get(msg, group, tag);
+   if (!field)
    {
-      if (field->descr->type->tag == tag)
+      *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND, "FIXField not found");
+      return FIX_FAILED;
+   }
+   fix_field_free(msg, field);
+   uint32_t const idx = field - group->fields;
+   memmove(field, field + 1, (group->field_count - idx - 1) * sizeof(FIXField)); // keep order of insertion
+   --group->field_count;
+   if (group->slots) // fields after deleted one are shifted, so fix their slots
+   {
+      uint32_t count = 0;
+      fix_group_descrs(msg, group, &count);
+      for(uint32_t i = 0; i < count; ++i)
       {
-         if (prev == field)
+         if (group->slots[i] == idx + 1)
          {
-            group->fields[idx] = fix_field_free(msg, field);
+            group->slots[i] = 0;
+            group->present[i / 64] &= ~(1ULL << (i % 64));
          }
-         else
+         else if (group->slots[i] > idx + 1)
          {
-            prev->next = fix_field_free(msg, field);
+            --group->slots[i];
          }
-         return FIX_SUCCESS;
       }
-      prev = field;
-      field = field->next;
    }
-   *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND, "FIXField not found");
-   return FIX_FAILED;
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+int32_t fix_field_get_missing(FIXMsg* msg, FIXGroup* grp, uint32_t slot)
+{
+   FIXGroup const* group = grp ? grp : msg->fields;
+   uint32_t count = 0;
+   fix_group_descrs(msg, group, &count);
+   uint64_t const* required = group->parent_fdescr ? group->parent_fdescr->group_required :
+      (msg->descr ? msg->descr->required : NULL);
+   if (!required)
+   {
+      return -1;
+   }
+   for(uint32_t i = slot / 64; i < REQUIRED_WORDS(count); ++i)
+   {
+      uint64_t missing = required[i] & ~(group->present ? group->present[i] : 0);
+      if (i == slot / 64)
+      {
+         missing &= ~0ULL << (slot % 64);
+      }
+      if (missing)
+      {
+         return i * 64 + fix_utils_ctz64(missing);
+      }
+   }
+   return -1;
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIXGroup* fix_group_add(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr, FIXField** fld, FIXError** error)
 {
-   FIXField* field = fix_field_get(msg, grp, descr->type->tag);
    FIXGroup* group = grp ? grp : msg->fields;
+   int32_t const slot = fix_field_get_slot(msg, group, descr->type->tag);
+   FIXField* field = fix_field_find(group, slot, descr->type->tag);
    if (field && field->descr->category != FIXFieldCategory_Group)
    {
       *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "FIXField has wrong type");
@@ -121,11 +182,11 @@ FIXGroup* fix_group_add(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr,
    }
    if (!field)
    {
-      uint32_t const idx = descr->type->tag % GROUP_SIZE;
-      field = (FIXField*)fix_msg_alloc(msg, sizeof(FIXField), error);
-      field->descr = descr;
-      field->next = group->fields[idx];
-      group->fields[idx] = field;
+      field = fix_field_create(msg, group, descr, slot, error);
+      if (!field)
+      {
+         return NULL;
+      }
       field->data = (char*)fix_msg_alloc(msg, sizeof(FIXGroups), error);
       if (!field->data)
       {
@@ -133,12 +194,12 @@ FIXGroup* fix_group_add(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr,
       }
       FIXGroups* grps = (FIXGroups*)field->data;
       field->size = 1;
-      field->body_len = 0;
       grps->group[0] = fix_msg_alloc_group(msg, error);
       if (!grps->group[0])
       {
          return NULL;
       }
+      grps->group[0]->parent_fdescr = descr;
    }
    else
    {
@@ -150,17 +211,11 @@ FIXGroup* fix_group_add(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr,
       {
          return NULL;
       }
+      new_grps->group[field->size]->parent_fdescr = descr;
       ++field->size;
       field->data = (char*)new_grps;
-      msg->body_len -= field->body_len;
    }
-   if (LIKE(field->descr->type->tag != FIXFieldTag_BeginString &&
-            field->descr->type->tag != FIXFieldTag_BodyLength &&
-            field->descr->type->tag != FIXFieldTag_CheckSum))
-   {
-      field->body_len = fix_utils_numdigits(descr->type->tag) + 1 + fix_utils_numdigits(field->size) + 1;
-   }
-   msg->body_len += field->body_len;
+   fix_field_update_group_len(msg, field);
    FIXGroups* grps = (FIXGroups*)field->data;
    FIXGroup* new_grp = grps->group[field->size - 1];
    *fld = field;
@@ -170,32 +225,23 @@ FIXGroup* fix_group_add(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr,
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIXGroup* fix_group_get(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag, uint32_t grpIdx, FIXError** error)
 {
-   int32_t const idx = tag % GROUP_SIZE;
-   FIXGroup* group = (grp ? grp : msg->fields);
-   FIXField* it = group->fields[idx];
-   while(it)
+   FIXField* it = fix_field_get(msg, grp, tag);
+   if (!it)
    {
-      if (it->descr->type->tag == tag)
-      {
-         if (it->descr->category != FIXFieldCategory_Group)
-         {
-            *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "FIXField has wrong type");
-            return NULL;
-         }
-         FIXGroups* grps = (FIXGroups*)it->data;
-         if (grpIdx >= it->size)
-         {
-            *error = fix_error_create(FIX_ERROR_GROUP_WRONG_INDEX, "Wrong index");
-            return NULL;
-         }
-         return grps->group[grpIdx];
-      }
-      else
-      {
-         it = it->next;
-      }
+      return NULL;
    }
-   return NULL;
+   if (it->descr->category != FIXFieldCategory_Group)
+   {
+      *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "FIXField has wrong type");
+      return NULL;
+   }
+   FIXGroups* grps = (FIXGroups*)it->data;
+   if (grpIdx >= it->size)
+   {
+      *error = fix_error_create(FIX_ERROR_GROUP_WRONG_INDEX, "Wrong index");
+      return NULL;
+   }
+   return grps->group[grpIdx];
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
@@ -220,7 +266,7 @@ FIXErrCode fix_group_del(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag, uint32_t grp
    }
    else
    {
-      memcpy((char*)grps->group + sizeof(FIXGroup*) * grpIdx, (char*)grps->group + sizeof(FIXGroup*) * (grpIdx + 1),
+      memmove((char*)grps->group + sizeof(FIXGroup*) * grpIdx, (char*)grps->group + sizeof(FIXGroup*) * (grpIdx + 1),
          sizeof(FIXGroup*) * (field->size - grpIdx));
       grps->group[field->size] = NULL;
    }
@@ -230,9 +276,7 @@ FIXErrCode fix_group_del(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag, uint32_t grp
    }
    else
    {
-      msg->body_len -= field->body_len;
-      field->body_len = fix_utils_numdigits(tag) + 1 + fix_utils_numdigits(field->size) + 1;
-      msg->body_len += field->body_len;
+      fix_field_update_group_len(msg, field);
    }
    return FIX_SUCCESS;
 }
@@ -240,7 +284,180 @@ FIXErrCode fix_group_del(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag, uint32_t grp
 /*------------------------------------------------------------------------------------------------------------------------*/
 /* PRIVATES                                                                                                               */
 /*------------------------------------------------------------------------------------------------------------------------*/
-static FIXField* fix_field_free(FIXMsg* msg, FIXField* field)
+static FIXFieldDescr const* fix_group_descrs(FIXMsg const* msg, FIXGroup const* group, uint32_t* count)
+{
+   if (group->parent_fdescr)
+   {
+      *count = group->parent_fdescr->group_count;
+      return group->parent_fdescr->group;
+   }
+   *count = msg->descr ? msg->descr->field_count : 0;
+   return msg->descr ? msg->descr->fields : NULL;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXField* fix_field_find(FIXGroup const* group, int32_t slot, FIXTagNum tag)
+{
+   if (slot >= 0)
+   {
+      return (group->slots && group->slots[slot]) ? &group->fields[group->slots[slot] - 1] : NULL;
+   }
+   FIXField* it = group->fields; // field without description. Search it among all fields
+   FIXField* const end = it + group->field_count;
+   for(; it != end; ++it)
+   {
+      if (it->tag == tag)
+      {
+         return it;
+      }
+   }
+   return NULL;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXField* fix_field_set_slot(FIXMsg* msg, FIXGroup* group, FIXFieldDescr const* descr, int32_t slot,
+      unsigned char const* data, uint32_t len, FIXError** error)
+{
+   FIXField* field = fix_field_find(group, slot, descr->type->tag);
+   if (field && field->descr->category == FIXFieldCategory_Group)
+   {
+      *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "FIXField has wrong type");
+      return NULL;
+   }
+   if (!field)
+   {
+      field = fix_field_create(msg, group, descr, slot, error);
+      if (!field)
+      {
+         return NULL;
+      }
+      field->size = len;
+      field->data = (char*)fix_msg_alloc(msg, len, error);
+   }
+   else if (field->flags & FIELD_DATA_EXTERNAL) // external data can't be reused, so copy it on first change
+   {
+      field->size = len;
+      field->data = (char*)fix_msg_alloc(msg, len, error);
+      field->flags &= ~FIELD_DATA_EXTERNAL;
+   }
+   else
+   {
+      field->size = len;
+      field->data = (char*)fix_msg_realloc(msg, field->data, len, error);
+   }
+   if (!field->data)
+   {
+      return NULL;
+   }
+   memcpy(field->data, data, len);
+   fix_field_update_body_len(msg, field);
+   return field;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXField* fix_field_create(FIXMsg* msg, FIXGroup* group, FIXFieldDescr const* descr, int32_t slot, FIXError** error)
+{
+   uint32_t descr_count = 0;
+   fix_group_descrs(msg, group, &descr_count);
+   if (slot >= 0 && !group->slots) // slots and presence bitmap are allocated with first described field
+   {
+      uint32_t const words = REQUIRED_WORDS(descr_count);
+      char* buff = (char*)fix_msg_alloc(msg, (words + 1) * sizeof(uint64_t) + descr_count * sizeof(uint16_t), error);
+      if (!buff)
+      {
+         return NULL;
+      }
+      group->present = (uint64_t*)(((uintptr_t)buff + sizeof(uint64_t) - 1) & ~(uintptr_t)(sizeof(uint64_t) - 1));
+      group->slots = (uint16_t*)(group->present + words);
+      memset(group->present, 0, words * sizeof(uint64_t) + descr_count * sizeof(uint16_t));
+   }
+   if (group->field_count == group->field_size) // grow fields array up to count of fields in group description
+   {
+      uint32_t new_size = group->field_size ? group->field_size * 2 : GROUP_FIELDS_INIT;
+      if (new_size > descr_count && descr_count > group->field_size)
+      {
+         new_size = descr_count;
+      }
+      FIXField* fields = (FIXField*)fix_msg_alloc(msg, new_size * sizeof(FIXField), error);
+      if (!fields)
+      {
+         return NULL;
+      }
+      if (group->field_count) // fields is NULL on first growth
+      {
+         memcpy(fields, group->fields, group->field_count * sizeof(FIXField));
+      }
+      group->fields = fields;
+      group->field_size = new_size;
+   }
+   FIXField* field = &group->fields[group->field_count++];
+   field->descr = descr;
+   field->tag = descr->type->tag;
+   field->body_len = 0;
+   field->crc = 0;
+   field->size = 0;
+   field->data = NULL;
+   field->flags = 0;
+   if (slot >= 0)
+   {
+      group->slots[slot] = group->field_count;
+      group->present[slot / 64] |= 1ULL << (slot % 64);
+   }
+   return field;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static uint32_t fix_field_digits(uint32_t val, uint32_t* crc)
+{
+   uint32_t len = 0;
+   do
+   {
+      *crc += '0' + val % 10;
+      val /= 10;
+      ++len;
+   }
+   while(val);
+   return len;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static int32_t fix_field_is_body(FIXField const* field)
+{
+   return field->tag != FIXFieldTag_BeginString && field->tag != FIXFieldTag_BodyLength && field->tag != FIXFieldTag_CheckSum;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void fix_field_update_body_len(FIXMsg* msg, FIXField* field)
+{
+   msg->body_len -= field->body_len;
+   msg->crc -= field->crc;
+   if (LIKE(fix_field_is_body(field)))
+   {
+      FIXFieldType const* type = field->descr->type;
+      field->body_len = type->prefix_len + field->size + 1;
+      field->crc = type->prefix_crc + fix_utils_sum_bytes(field->data, field->size) + FIX_SOH;
+   }
+   msg->body_len += field->body_len;
+   msg->crc += field->crc;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void fix_field_update_group_len(FIXMsg* msg, FIXField* field)
+{
+   msg->body_len -= field->body_len;
+   msg->crc -= field->crc;
+   if (LIKE(fix_field_is_body(field)))
+   {
+      FIXFieldType const* type = field->descr->type;
+      field->crc = type->prefix_crc + FIX_SOH;
+      field->body_len = type->prefix_len + fix_field_digits(field->size, &field->crc) + 1;
+   }
+   msg->body_len += field->body_len;
+   msg->crc += field->crc;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void fix_field_free(FIXMsg* msg, FIXField* field)
 {
    if (field->descr->category == FIXFieldCategory_Group)
    {
@@ -251,19 +468,15 @@ static FIXField* fix_field_free(FIXMsg* msg, FIXField* field)
       }
    }
    msg->body_len -= field->body_len;
-   return field->next;
+   msg->crc -= field->crc;
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
 static void fix_group_free(FIXMsg* msg, FIXGroup* group)
 {
-   for(int32_t i = 0; i < GROUP_SIZE; ++i)
+   for(uint32_t i = 0; i < group->field_count; ++i)
    {
-      FIXField* tag = group->fields[i];
-      while(tag)
-      {
-         tag = fix_field_free(msg, tag);
-      }
+      fix_field_free(msg, &group->fields[i]);
    }
    fix_msg_free_group(msg, group);
 }
@@ -21,7 +21,9 @@ extern "C"
 {
 #endif
 
-#define GROUP_SIZE 64
+#define GROUP_FIELDS_INIT 8 ///< max count of fields allocated for group at first. Group never allocates more than its description has
+
+#define FIELD_DATA_EXTERNAL 0x01 ///< field data points into external buffer (e.g. parsed string) and must not be reused
 
 /**
  * FIX field
@@ -29,10 +31,12 @@ extern "C"
 struct FIXField_
 {
    FIXFieldDescr const* descr; ///< FIX field description
-   struct FIXField_* next;     ///< next FIX field with the same hash key
+   FIXTagNum tag;              ///< tag of field. Copy of descr->type->tag, so fields are searched without touching descriptions
    uint32_t body_len;          ///< length of field, if it is converted to string
+   uint32_t crc;               ///< sum of bytes of field, if it is converted to string with FIX_SOH delimiter
    uint32_t size;              ///< size of field data
    char* data;                 ///< field value. All values converted to string
+   uint8_t flags;              ///< field flags. See FIELD_DATA_* values
 };
 
 /**
@@ -40,7 +44,11 @@ struct FIXField_
  */
 struct FIXGroup_
 {
-   FIXField* fields[GROUP_SIZE]; ///< FIX field hash table
+   FIXField* fields;         ///< FIX fields in order of insertion. Array is allocated in message pages
+   uint16_t* slots;          ///< index + 1 of field in fields array, indexed by position of field description. 0 - field is not set
+   uint64_t* present;        ///< bitmap of set fields, indexed by position of field description
+   uint32_t field_count;     ///< count of fields in group
+   uint32_t field_size;      ///< allocated size of fields array
    FIXFieldDescr const* parent_fdescr; ///< description of FIX field, which defines number of entries on group
    struct FIXGroup_* next;   ///< next group in pool of unused groups. If this group is used next == NULL
 };
@@ -65,6 +73,19 @@ typedef struct FIXGroups_
  */
 FIXField* fix_field_set(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr, unsigned char const* data, uint32_t len, FIXError** error);
 
+/**
+ * set FIX field value without copying. Field data refers to external buffer, which must live longer than message.
+ * Value is copied into message pages on the first change of field
+ * @param[in] msg    - FIX message
+ * @param[in] grp    - FIX group, if FIX field is a part of FIX group, else must be NULL
+ * @param[in] descr  - FIX field description
+ * @param[in] data   - FIX field value
+ * @param[in] len    - value length
+ * @param[out] error - error description
+ * @return pointer to changed FIX field, NULL in case of error
+ */
+FIXField* fix_field_set_ref(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr, char const* data, uint32_t len, FIXError** error);
+
 /**
  * return FIX field by tag number
  * @param[in] msg - FIX message with required field
@@ -74,6 +95,46 @@ FIXField* fix_field_set(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr,
  */
 FIXField* fix_field_get(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag);
 
+/**
+ * return slot of FIX field. Slot is a position of field description in message (or group) description, so it is the same
+ * for all messages of one type and can be resolved once
+ * @param[in] msg - FIX message
+ * @param[in] grp - FIX group, if FIX field is a part of FIX group, else must be NULL
+ * @param[in] tag - FIX field tag num
+ * @return slot of field, -1 - field is not described
+ */
+int32_t fix_field_get_slot(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag);
+
+/**
+ * return FIX field by slot
+ * @param[in] msg  - FIX message with required field
+ * @param[in] grp  - FIX group, if required FIX field is a part of FIX group
+ * @param[in] slot - slot of field, returned by fix_field_get_slot
+ * @return required FIX field, NULL - field is not set
+ */
+FIXField* fix_field_get_by_slot(FIXMsg* msg, FIXGroup* grp, uint32_t slot);
+
+/**
+ * set FIX field value by slot
+ * @param[in] msg    - FIX message
+ * @param[in] grp    - FIX group, if FIX field is a part of FIX group, else must be NULL
+ * @param[in] slot   - slot of field, returned by fix_field_get_slot
+ * @param[in] data   - FIX field value
+ * @param[in] len    - value length
+ * @param[out] error - error description
+ * @return pointer to changed FIX field, NULL in case of error
+ */
+FIXField* fix_field_set_by_slot(FIXMsg* msg, FIXGroup* grp, uint32_t slot, unsigned char const* data, uint32_t len, FIXError** error);
+
+/**
+ * return slot of required FIX field, which is not set. Presence of fields is compared with required ones word by word
+ * @param[in] msg  - FIX message
+ * @param[in] grp  - FIX group, if required fields of group are checked, else must be NULL
+ * @param[in] slot - first checked slot, so all missing fields are found by repeated calls
+ * @return slot of missing field, -1 - all required fields are set
+ */
+int32_t fix_field_get_missing(FIXMsg* msg, FIXGroup* grp, uint32_t slot);
+
 /**
  * delete FIX field by tag number
  * @param[in] msg - FIX message, with deleted FIX field
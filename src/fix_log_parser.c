@@ -0,0 +1,290 @@
+/**
+ * @file   fix_log_parser.c
+ * @author Dmitry S. Melnikov, dmitryme@gmail.com
+ * @date   Created on: 10/16/2026 02:12:40 PM
+ */
+
+#include "fix_parser.h"
+#include "fix_parser_priv.h"
+#include "fix_thread.h"
+#include "fix_utils.h"
+#include "fix_error_priv.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define LOG_CHUNK_SIZE (4 * 1024 * 1024) ///< approximate size of data, parsed by worker at once
+#define LOG_BATCH_SIZE 64                ///< count of messages, parsed by fix_parser_str_to_msgs at once
+
+/**
+ * parsed message, waiting for delivery
+ */
+typedef struct FIXLogMsg_
+{
+   FIXMsg* msg;
+   FIXError* error;
+} FIXLogMsg;
+
+/**
+ * shared state of log parsing
+ */
+typedef struct FIXLogParser_
+{
+   char const* data;          ///< log data
+   char delimiter;            ///< FIX field SOH
+   uint64_t* bounds;          ///< chunk boundaries. Chunk i is [bounds[i], bounds[i + 1])
+   uint32_t chunk_count;      ///< count of chunks
+   uint32_t next_chunk;       ///< next chunk to parse
+   uint32_t next_delivery;    ///< next chunk to deliver, if messages are delivered in order
+   int32_t ordered;           ///< deliver messages in order
+   FIXLogCallback callback;   ///< user callback
+   void* user_data;           ///< user data for callback
+   FIXMutex* mutex;           ///< protects next_chunk and next_delivery
+   FIXCond* cond;             ///< signaled, when next_delivery is changed
+} FIXLogParser;
+
+/**
+ * worker thread state
+ */
+typedef struct FIXLogWorker_
+{
+   FIXLogParser* log;         ///< shared state
+   FIXParser* parser;         ///< worker own parser
+   FIXThread* thread;         ///< worker thread
+   FIXLogMsg* msgs;           ///< parsed messages of current chunk, if messages are delivered in order
+   uint32_t msgs_size;        ///< allocated size of msgs
+   uint32_t msgs_count;       ///< count of msgs
+   uint32_t msgs_lost;        ///< count of messages of current chunk, dropped because msgs can not grow
+} FIXLogWorker;
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+/* find beginning of the first message at or after pos. Message begins with BeginString field, e.g. |8=FIX */
+static uint64_t fix_log_find_msg(char const* data, uint64_t len, uint64_t pos, char delimiter)
+{
+   while(pos < len)
+   {
+      uint64_t const left = len - pos;
+      char const* it = fix_utils_find_char(data + pos, left > UINT32_MAX ? UINT32_MAX : (uint32_t)left, delimiter);
+      if (!it)
+      {
+         if (left > UINT32_MAX)
+         {
+            pos += UINT32_MAX;
+            continue;
+         }
+         break;
+      }
+      pos = it - data + 1;
+      if (len - pos >= 5 && !strncmp(data + pos, "8=FIX", 5))
+      {
+         return pos;
+      }
+   }
+   return len;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void fix_log_deliver(FIXLogParser* log, FIXMsg* msg, FIXError* error)
+{
+   log->callback(msg, error, log->user_data);
+   fix_msg_free(msg);
+   fix_error_free(error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void fix_log_keep(FIXLogWorker* worker, FIXMsg* msg, FIXError* error)
+{
+   if (worker->msgs_count == worker->msgs_size)
+   {
+      uint32_t const size = worker->msgs_size ? worker->msgs_size * 2 : 1024;
+      FIXLogMsg* msgs = (FIXLogMsg*)realloc(worker->msgs, size * sizeof(FIXLogMsg));
+      if (!msgs) // message is dropped, its loss is reported after delivery of kept ones
+      {
+         fix_msg_free(msg);
+         fix_error_free(error);
+         ++worker->msgs_lost;
+         return;
+      }
+      worker->msgs = msgs;
+      worker->msgs_size = size;
+   }
+   worker->msgs[worker->msgs_count].msg = msg;
+   worker->msgs[worker->msgs_count].error = error;
+   ++worker->msgs_count;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void fix_log_parse_chunk(FIXLogWorker* worker, uint32_t chunk)
+{
+   FIXLogParser* log = worker->log;
+   char const* it = log->data + log->bounds[chunk];
+   char const* end = log->data + log->bounds[chunk + 1];
+   FIXMsg* msgs[LOG_BATCH_SIZE];
+   FIXError* errors[LOG_BATCH_SIZE];
+   while(it != end)
+   {
+      char const* stop = NULL;
+      uint32_t const count = fix_parser_str_to_msgs(worker->parser, it, end - it, log->delimiter, msgs, errors, LOG_BATCH_SIZE, &stop);
+      if (!count) // message exceeds chunk. Chunks end at message boundaries, so only the last one can be incomplete
+      {
+         int32_t const last = (chunk + 1 == log->chunk_count);
+         FIXError* error = last ? fix_error_create(FIX_ERROR_NO_MORE_DATA, "Incomplete message at the end of data.") :
+            fix_error_create(FIX_ERROR_PARSE_MSG, "Message at offset %llu is broken, its BodyLength exceeds the next message.",
+                  (unsigned long long)(it - log->data));
+         if (log->ordered)
+         {
+            fix_log_keep(worker, NULL, error);
+         }
+         else
+         {
+            fix_log_deliver(log, NULL, error);
+         }
+         if (last)
+         {
+            break;
+         }
+         it = log->data + fix_log_find_msg(log->data, log->bounds[chunk + 1], it - log->data, log->delimiter);
+         continue;
+      }
+      for(uint32_t i = 0; i < count; ++i)
+      {
+         if (log->ordered)
+         {
+            fix_log_keep(worker, msgs[i], errors[i]);
+         }
+         else
+         {
+            fix_log_deliver(log, msgs[i], errors[i]);
+         }
+      }
+      it = stop;
+   }
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void fix_log_worker(void* arg)
+{
+   FIXLogWorker* worker = (FIXLogWorker*)arg;
+   FIXLogParser* log = worker->log;
+   for(;;)
+   {
+      fix_mutex_lock(log->mutex);
+      uint32_t const chunk = log->next_chunk++;
+      fix_mutex_unlock(log->mutex);
+      if (chunk >= log->chunk_count)
+      {
+         break;
+      }
+      fix_log_parse_chunk(worker, chunk);
+      if (log->ordered) // wait for previous chunks delivery. Worker with the first not delivered chunk never waits
+      {
+         fix_mutex_lock(log->mutex);
+         while(log->next_delivery != chunk)
+         {
+            fix_cond_wait(log->cond, log->mutex);
+         }
+         fix_mutex_unlock(log->mutex);
+         for(uint32_t i = 0; i < worker->msgs_count; ++i)
+         {
+            fix_log_deliver(log, worker->msgs[i].msg, worker->msgs[i].error);
+         }
+         worker->msgs_count = 0;
+         if (worker->msgs_lost)
+         {
+            fix_log_deliver(log, NULL, fix_error_create(FIX_ERROR_MALLOC,
+                  "%u messages of chunk %u are lost, unable to allocate memory for them.", worker->msgs_lost, chunk));
+            worker->msgs_lost = 0;
+         }
+         fix_mutex_lock(log->mutex);
+         ++log->next_delivery;
+         fix_cond_broadcast(log->cond);
+         fix_mutex_unlock(log->mutex);
+      }
+   }
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_parser_parse_log(FIXParser* parser, char const* data, uint64_t len, char delimiter,
+      uint32_t numThreads, int32_t ordered, FIXLogCallback callback, void* userData, FIXError** error)
+{
+   if (!parser || !data || !callback)
+   {
+      return FIX_FAILED;
+   }
+   if (!numThreads)
+   {
+      numThreads = fix_thread_cpu_count();
+   }
+   FIXLogParser log = {};
+   log.data = data;
+   log.delimiter = delimiter;
+   log.ordered = ordered;
+   log.callback = callback;
+   log.user_data = userData;
+   uint32_t const maxChunks = len / LOG_CHUNK_SIZE + 1;
+   log.bounds = (uint64_t*)malloc((maxChunks + 1) * sizeof(uint64_t));
+   if (!log.bounds)
+   {
+      *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate %u chunk boundaries.", maxChunks + 1);
+      return FIX_FAILED;
+   }
+   log.bounds[0] = 0;
+   while(log.bounds[log.chunk_count] < len) // split data by messages boundaries
+   {
+      uint64_t const next = log.bounds[log.chunk_count] + LOG_CHUNK_SIZE;
+      log.bounds[++log.chunk_count] = (next >= len ? len : fix_log_find_msg(data, len, next - 1, delimiter));
+   }
+   if (numThreads > log.chunk_count)
+   {
+      numThreads = log.chunk_count;
+   }
+   FIXLogWorker* workers = (FIXLogWorker*)calloc(numThreads ? numThreads : 1, sizeof(FIXLogWorker));
+   if (!workers)
+   {
+      free(log.bounds);
+      *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate %u workers.", numThreads);
+      return FIX_FAILED;
+   }
+   log.mutex = fix_mutex_create();
+   log.cond = fix_cond_create();
+   FIXErrCode res = FIX_SUCCESS;
+   uint32_t created = 0;
+   for(; created < numThreads; ++created) // all parsers are created before workers start, so nothing is parsed on failure
+   {
+      workers[created].log = &log;
+      workers[created].parser = fix_parser_create_from_protocol(parser->protocol, &parser->attrs, parser->flags, error);
+      if (!workers[created].parser)
+      {
+         res = FIX_FAILED;
+         break;
+      }
+   }
+   uint32_t started = 0;
+   for(; res == FIX_SUCCESS && started < numThreads; ++started)
+   {
+      workers[started].thread = fix_thread_create(&fix_log_worker, &workers[started]);
+      if (!workers[started].thread)
+      {
+         break;
+      }
+   }
+   if (res == FIX_SUCCESS && !started && log.chunk_count)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Unable to start worker threads.");
+      res = FIX_FAILED;
+   }
+   for(uint32_t i = 0; i < started; ++i)
+   {
+      fix_thread_join(workers[i].thread);
+      free(workers[i].msgs);
+   }
+   for(uint32_t i = 0; i < created; ++i)
+   {
+      fix_parser_free(workers[i].parser);
+   }
+   free(workers);
+   fix_cond_free(log.cond);
+   fix_mutex_free(log.mutex);
+   free(log.bounds);
+   return res;
+}
@@ -23,8 +23,49 @@
 /*------------------------------------------------------------------------------------------------------------------------*/
 static inline uint32_t calc_required_space(FIXMsg* msg)
 {
-   // 8= + FIX.4.4 + SOH + 9= LEN + SON + BODY_LEN + 10=XXX|
-   return 2 + strlen(msg->parser->protocol->version) + 1 + 2 + fix_utils_numdigits(msg->body_len) + 1 + msg->body_len + 7;
+   // 8=BEGIN_STRING + SOH + 9= LEN + SOH + BODY_LEN + 10=XXX|
+   FIXField const* begin_string = fix_field_get(msg, NULL, FIXFieldTag_BeginString);
+   return (begin_string ? 2 + begin_string->size + 1 : 0) + 2 + fix_utils_numdigits(msg->body_len) + 1 + msg->body_len + 7;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static inline FIXFieldDescr const* get_handle_descr(FIXMsg* msg, FIXFieldHandle const* handle, FIXError** error)
+{
+   if (UNLIKE(!handle || handle->msg_descr != msg->descr))
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Field handle is not resolved for message '%s'", msg->descr->type);
+      return NULL;
+   }
+   if (UNLIKE(msg->lazy) && fix_parser_lazy_parse_all(msg, error) == FIX_FAILED)
+   {
+      return NULL;
+   }
+   return &msg->descr->fields[handle->slot];
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static inline FIXErrCode get_handle_field(FIXMsg* msg, FIXFieldHandle const* handle, FIXField** field, FIXError** error)
+{
+   if (UNLIKE(!handle || handle->msg_descr != msg->descr))
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Field handle is not resolved for message '%s'", msg->descr->type);
+      return FIX_FAILED;
+   }
+   if (UNLIKE(msg->lazy) && fix_parser_lazy_get(msg, handle->tag, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
+   *field = fix_field_get_by_slot(msg, NULL, handle->slot);
+   if (!*field)
+   {
+      return FIX_NO_FIELD;
+   }
+   if ((*field)->descr->category != FIXFieldCategory_Value)
+   {
+      *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "Field %d is not a value", handle->tag);
+      return FIX_FAILED;
+   }
+   return FIX_SUCCESS;
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
@@ -60,6 +101,8 @@ FIX_PARSER_API FIXMsg* fix_msg_create(FIXParser* parser, char const* msgType, FI
       return NULL;
    }
    msg->body_len = 0;
+   msg->crc = 0;
+   msg->lazy = NULL;
    fix_msg_set_string(msg, NULL, 8, parser->protocol->transportVersion, error);
    fix_msg_set_string(msg, NULL, 35, msgType, error);
    return msg;
@@ -113,6 +156,10 @@ FIX_PARSER_API FIXGroup* fix_msg_add_group(FIXMsg* msg, FIXGroup* grp, FIXTagNum
    {
       return NULL;
    }
+   if (UNLIKE(msg->lazy) && fix_parser_lazy_parse_all(msg, error) == FIX_FAILED)
+   {
+      return NULL;
+   }
    FIXFieldDescr const* fdescr = fix_protocol_get_descr(msg, grp, tag, error);
    if (!fdescr)
    {
@@ -125,9 +172,7 @@ FIX_PARSER_API FIXGroup* fix_msg_add_group(FIXMsg* msg, FIXGroup* grp, FIXTagNum
    }
 
    FIXField* field = NULL;
-   FIXGroup* new_grp = fix_group_add(msg, grp, fdescr, &field, error);
-   new_grp->parent_fdescr = fdescr;
-   return new_grp;
+   return fix_group_add(msg, grp, fdescr, &field, error);
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
@@ -137,6 +182,10 @@ FIX_PARSER_API FIXGroup* fix_msg_get_group(FIXMsg* msg, FIXGroup* grp, FIXTagNum
    {
       return NULL;
    }
+   if (UNLIKE(msg->lazy && !grp) && fix_parser_lazy_get(msg, tag, error) == FIX_FAILED)
+   {
+      return NULL;
+   }
    FIXFieldDescr const* fdescr = fix_protocol_get_descr(msg, grp, tag, error);
    if (!fdescr)
    {
@@ -157,6 +206,10 @@ FIX_PARSER_API FIXErrCode fix_msg_del_group(FIXMsg* msg, FIXGroup* grp, FIXTagNu
    {
       return FIX_FAILED;
    }
+   if (UNLIKE(msg->lazy) && fix_parser_lazy_parse_all(msg, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
    FIXFieldDescr const* fdescr = fix_protocol_get_descr(msg, grp, tag, error);
    if (!fdescr)
    {
@@ -178,6 +231,10 @@ FIX_PARSER_API FIXErrCode fix_msg_set_string_len(FIXMsg* msg, FIXGroup* grp, FIX
    {
       return FIX_FAILED;
    }
+   if (UNLIKE(msg->lazy) && fix_parser_lazy_parse_all(msg, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
    FIXFieldDescr const* fdescr = fix_protocol_get_descr(msg, grp, tag, error);
    if (!fdescr)
    {
@@ -205,6 +262,10 @@ FIX_PARSER_API FIXErrCode fix_msg_set_int32(FIXMsg* msg, FIXGroup* grp, FIXTagNu
    {
       return FIX_FAILED;
    }
+   if (UNLIKE(msg->lazy) && fix_parser_lazy_parse_all(msg, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
    FIXFieldDescr const* fdescr = fix_protocol_get_descr(msg, grp, tag, error);
    if (!fdescr)
    {
@@ -228,6 +289,10 @@ FIX_PARSER_API FIXErrCode fix_msg_set_int64(FIXMsg* msg, FIXGroup* grp, FIXTagNu
    {
       return FIX_FAILED;
    }
+   if (UNLIKE(msg->lazy) && fix_parser_lazy_parse_all(msg, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
    FIXFieldDescr const* fdescr = fix_protocol_get_descr(msg, grp, tag, error);
    if (!fdescr)
    {
@@ -251,6 +316,10 @@ FIX_PARSER_API FIXErrCode fix_msg_set_char(FIXMsg* msg, FIXGroup* grp, FIXTagNum
    {
       return FIX_FAILED;
    }
+   if (UNLIKE(msg->lazy) && fix_parser_lazy_parse_all(msg, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
    FIXFieldDescr const* fdescr = fix_protocol_get_descr(msg, grp, tag, error);
    if (!fdescr)
    {
@@ -272,6 +341,10 @@ FIX_PARSER_API FIXErrCode fix_msg_set_double(FIXMsg* msg, FIXGroup* grp, FIXTagN
    {
       return FIX_FAILED;
    }
+   if (UNLIKE(msg->lazy) && fix_parser_lazy_parse_all(msg, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
    FIXFieldDescr const* fdescr = fix_protocol_get_descr(msg, grp, tag, error);
    if (!fdescr)
    {
@@ -288,6 +361,39 @@ FIX_PARSER_API FIXErrCode fix_msg_set_double(FIXMsg* msg, FIXGroup* grp, FIXTagN
    return field != NULL ? FIX_SUCCESS : FIX_FAILED;
 }
 
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_set_double_fixed(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag, double val, uint32_t precision,
+      FIXError** error)
+{
+   if (!msg)
+   {
+      return FIX_FAILED;
+   }
+   if (UNLIKE(msg->lazy) && fix_parser_lazy_parse_all(msg, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
+   FIXFieldDescr const* fdescr = fix_protocol_get_descr(msg, grp, tag, error);
+   if (!fdescr)
+   {
+      return FIX_FAILED;
+   }
+   if (!IS_FLOAT_TYPE(fdescr->type->valueType))
+   {
+      *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "Tag '%d' type is not compatrible with value '%f'", tag, val);
+      return FIX_FAILED;
+   }
+   char buff[64] = {};
+   int32_t res = fix_utils_dtoa_fixed(val, precision, buff, sizeof(buff));
+   if (res > (int32_t)sizeof(buff))
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Value '%f' with precision %u is too long", val, precision);
+      return FIX_FAILED;
+   }
+   FIXField* field = fix_msg_set_field(msg, grp, fdescr, (unsigned char*)buff, res, error);
+   return field != NULL ? FIX_SUCCESS : FIX_FAILED;
+}
+
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIX_PARSER_API FIXErrCode fix_msg_set_data(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag, char const* data, uint32_t dataLen,
       FIXError** error)
@@ -296,6 +402,10 @@ FIX_PARSER_API FIXErrCode fix_msg_set_data(FIXMsg* msg, FIXGroup* grp, FIXTagNum
    {
       return FIX_FAILED;
    }
+   if (UNLIKE(msg->lazy) && fix_parser_lazy_parse_all(msg, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
    FIXFieldDescr const* fdescr = fix_protocol_get_descr(msg, grp, tag, error);
    if (!fdescr)
    {
@@ -321,6 +431,10 @@ FIX_PARSER_API FIXErrCode fix_msg_get_int32( FIXMsg* msg, FIXGroup* grp, FIXTagN
    {
       return FIX_FAILED;
    }
+   if (UNLIKE(msg->lazy && !grp) && fix_parser_lazy_get(msg, tag, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
    FIXField* field = fix_field_get(msg, grp, tag);
    if (!field)
    {
@@ -345,6 +459,10 @@ FIX_PARSER_API FIXErrCode fix_msg_get_int64(FIXMsg* msg, FIXGroup* grp, FIXTagNu
    {
       return FIX_FAILED;
    }
+   if (UNLIKE(msg->lazy && !grp) && fix_parser_lazy_get(msg, tag, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
    FIXField* field = fix_field_get(msg, grp, tag);
    if (!field)
    {
@@ -366,6 +484,10 @@ FIX_PARSER_API FIXErrCode fix_msg_get_double(FIXMsg* msg, FIXGroup* grp, FIXTagN
    {
       return FIX_FAILED;
    }
+   if (UNLIKE(msg->lazy && !grp) && fix_parser_lazy_get(msg, tag, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
    FIXField* field = fix_field_get(msg, grp, tag);
    if (!field)
    {
@@ -387,6 +509,10 @@ FIX_PARSER_API FIXErrCode fix_msg_get_char(FIXMsg* msg, FIXGroup* grp, FIXTagNum
    {
       return FIX_FAILED;
    }
+   if (UNLIKE(msg->lazy && !grp) && fix_parser_lazy_get(msg, tag, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
    FIXField* field = fix_field_get(msg, grp, tag);
    if (!field)
    {
@@ -409,6 +535,10 @@ FIX_PARSER_API FIXErrCode fix_msg_get_string(
    {
       return FIX_FAILED;
    }
+   if (UNLIKE(msg->lazy && !grp) && fix_parser_lazy_get(msg, tag, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
    FIXField* field = fix_field_get(msg, grp, tag);
    if (!field)
    {
@@ -438,6 +568,10 @@ FIX_PARSER_API FIXErrCode fix_msg_del_field(FIXMsg* msg, FIXGroup* grp, FIXTagNu
    {
       return FIX_FAILED;
    }
+   if (UNLIKE(msg->lazy) && fix_parser_lazy_parse_all(msg, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
    FIXField* field = fix_field_get(msg, grp, tag);
    if (!field)
    {
@@ -455,43 +589,272 @@ FIX_PARSER_API FIXErrCode fix_msg_del_field(FIXMsg* msg, FIXGroup* grp, FIXTagNu
    return fix_field_del(msg, grp, tag, error);
 }
 
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_resolve_field(FIXParser* parser, char const* msgType, FIXTagNum tag, FIXFieldHandle* handle,
+      FIXError** error)
+{
+   if (!parser)
+   {
+      return FIX_FAILED;
+   }
+   if (!msgType || !handle)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "MsgType or handle parameter is NULL");
+      return FIX_FAILED;
+   }
+   FIXMsgDescr const* msg_descr = fix_protocol_get_msg_descr(parser, msgType, error);
+   if (!msg_descr)
+   {
+      return FIX_FAILED;
+   }
+   FIXFieldDescr const* fdescr = fix_protocol_get_field_descr(msg_descr, tag);
+   if (!fdescr)
+   {
+      *error = fix_error_create(FIX_ERROR_UNKNOWN_FIELD, "Field with tag %d not found in message '%s' description.",
+            tag, msg_descr->name);
+      return FIX_FAILED;
+   }
+   handle->msg_descr = msg_descr;
+   handle->tag = tag;
+   handle->slot = fdescr - msg_descr->fields;
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_set_string_len_h(FIXMsg* msg, FIXFieldHandle const* handle, char const* val, uint32_t len,
+      FIXError** error)
+{
+   if (!msg)
+   {
+      return FIX_FAILED;
+   }
+   FIXFieldDescr const* fdescr = get_handle_descr(msg, handle, error);
+   if (!fdescr)
+   {
+      return FIX_FAILED;
+   }
+   if (!IS_STRING_TYPE(fdescr->type->valueType))
+   {
+      *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "Tag '%d' type is not compatible with value '%s'", handle->tag, val);
+      return FIX_FAILED;
+   }
+   FIXField* field = fix_field_set_by_slot(msg, NULL, handle->slot, (unsigned char*)val, len, error);
+   return field != NULL ? FIX_SUCCESS : FIX_FAILED;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_set_string_h(FIXMsg* msg, FIXFieldHandle const* handle, char const* val, FIXError** error)
+{
+   return fix_msg_set_string_len_h(msg, handle, val, strlen(val), error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_set_int32_h(FIXMsg* msg, FIXFieldHandle const* handle, int32_t val, FIXError** error)
+{
+   return fix_msg_set_int64_h(msg, handle, val, error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_set_int64_h(FIXMsg* msg, FIXFieldHandle const* handle, int64_t val, FIXError** error)
+{
+   if (!msg)
+   {
+      return FIX_FAILED;
+   }
+   FIXFieldDescr const* fdescr = get_handle_descr(msg, handle, error);
+   if (!fdescr)
+   {
+      return FIX_FAILED;
+   }
+   if (!IS_INT_TYPE(fdescr->type->valueType))
+   {
+      *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "Tag '%d' type is not compatrible with value '%ld'", handle->tag, val);
+      return FIX_FAILED;
+   }
+   char buff[64] = {};
+   int32_t res = fix_utils_i64toa(val, buff, sizeof(buff), 0);
+   FIXField* field = fix_field_set_by_slot(msg, NULL, handle->slot, (unsigned char*)buff, res, error);
+   return field != NULL ? FIX_SUCCESS : FIX_FAILED;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_set_char_h(FIXMsg* msg, FIXFieldHandle const* handle, char val, FIXError** error)
+{
+   if (!msg)
+   {
+      return FIX_FAILED;
+   }
+   FIXFieldDescr const* fdescr = get_handle_descr(msg, handle, error);
+   if (!fdescr)
+   {
+      return FIX_FAILED;
+   }
+   if (!IS_CHAR_TYPE(fdescr->type->valueType))
+   {
+      *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "Tag '%d' type is not compatrible with value '%c'", handle->tag, val);
+      return FIX_FAILED;
+   }
+   FIXField* field = fix_field_set_by_slot(msg, NULL, handle->slot, (unsigned char*)&val, 1, error);
+   return field != NULL ? FIX_SUCCESS : FIX_FAILED;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_set_double_h(FIXMsg* msg, FIXFieldHandle const* handle, double val, FIXError** error)
+{
+   if (!msg)
+   {
+      return FIX_FAILED;
+   }
+   FIXFieldDescr const* fdescr = get_handle_descr(msg, handle, error);
+   if (!fdescr)
+   {
+      return FIX_FAILED;
+   }
+   if (!IS_FLOAT_TYPE(fdescr->type->valueType))
+   {
+      *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "Tag '%d' type is not compatrible with value '%f'", handle->tag, val);
+      return FIX_FAILED;
+   }
+   char buff[64] = {};
+   int32_t res = fix_utils_dtoa(val, buff, sizeof(buff));
+   FIXField* field = fix_field_set_by_slot(msg, NULL, handle->slot, (unsigned char*)buff, res, error);
+   return field != NULL ? FIX_SUCCESS : FIX_FAILED;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_get_int32_h(FIXMsg* msg, FIXFieldHandle const* handle, int32_t* val, FIXError** error)
+{
+   if (!msg)
+   {
+      return FIX_FAILED;
+   }
+   FIXField* field = NULL;
+   FIXErrCode res = get_handle_field(msg, handle, &field, error);
+   if (res != FIX_SUCCESS)
+   {
+      return res;
+   }
+   int32_t cnt;
+   return fix_utils_atoi32((char const*)field->data, field->size, 0, val, &cnt);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_get_int64_h(FIXMsg* msg, FIXFieldHandle const* handle, int64_t* val, FIXError** error)
+{
+   if (!msg)
+   {
+      return FIX_FAILED;
+   }
+   FIXField* field = NULL;
+   FIXErrCode res = get_handle_field(msg, handle, &field, error);
+   if (res != FIX_SUCCESS)
+   {
+      return res;
+   }
+   int32_t cnt;
+   return fix_utils_atoi64((char const*)field->data, field->size, 0, val, &cnt);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_get_double_h(FIXMsg* msg, FIXFieldHandle const* handle, double* val, FIXError** error)
+{
+   if (!msg)
+   {
+      return FIX_FAILED;
+   }
+   FIXField* field = NULL;
+   FIXErrCode res = get_handle_field(msg, handle, &field, error);
+   if (res != FIX_SUCCESS)
+   {
+      return res;
+   }
+   int32_t cnt;
+   return fix_utils_atod((char const*)field->data, field->size, 0, val, &cnt);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_get_char_h(FIXMsg* msg, FIXFieldHandle const* handle, char* val, FIXError** error)
+{
+   if (!msg)
+   {
+      return FIX_FAILED;
+   }
+   FIXField* field = NULL;
+   FIXErrCode res = get_handle_field(msg, handle, &field, error);
+   if (res != FIX_SUCCESS)
+   {
+      return res;
+   }
+   *val = *(char*)(field->data);
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_get_string_h(FIXMsg* msg, FIXFieldHandle const* handle, char const** val, uint32_t* len,
+      FIXError** error)
+{
+   if (!msg)
+   {
+      return FIX_FAILED;
+   }
+   FIXField* field = NULL;
+   FIXErrCode res = get_handle_field(msg, handle, &field, error);
+   if (res != FIX_SUCCESS)
+   {
+      return res;
+   }
+   *val = (char const*)field->data;
+   *len = field->size;
+   return FIX_SUCCESS;
+}
+
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIX_PARSER_API FIXErrCode fix_msg_to_str(FIXMsg* msg, char delimiter, char* buff, uint32_t buffLen, uint32_t* reqBuffLen,
       FIXError** error)
 {
-   if(!msg || !msg || !reqBuffLen)
+   if(!msg || !reqBuffLen)
+   {
+      return FIX_FAILED;
+   }
+   if (UNLIKE(msg->lazy) && fix_parser_lazy_parse_all(msg, error) == FIX_FAILED)
    {
       return FIX_FAILED;
    }
    *reqBuffLen = calc_required_space(msg);
-   if (*reqBuffLen > buffLen)
+   if (*reqBuffLen > buffLen) // the only space check, all fields below are written without it
    {
       return FIX_ERROR_NO_MORE_SPACE;
    }
+   if ((msg->parser->flags & PARSER_FLAG_CHECK_REQUIRED) && fix_msg_check_required(msg, NULL, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
    FIXMsgDescr const* descr = msg->descr;
-   int32_t crc = 0;
+   char* const begin = buff;
+   uint32_t crc = (delimiter == FIX_SOH) ? msg->crc : 0; // body sum is maintained by field changes
    for(uint32_t i = 0; i < descr->field_count; ++i)
    {
       char* prev = buff;
       FIXFieldDescr* fdescr = &descr->fields[i];
-      FIXField* field = fix_field_get(msg, NULL, fdescr->type->tag);
-      FIXErrCode res = FIX_SUCCESS;
+      FIXField* field = fix_field_get_by_slot(msg, NULL, i);
       if (fdescr->type->tag == FIXFieldTag_BodyLength)
       {
-         res = int32_to_str(fdescr->type->tag, msg->body_len, delimiter, 0, 0, &buff, &buffLen, error);
+         buff = int32_to_str(fdescr->type, msg->body_len, delimiter, 0, 0, buff);
       }
       else if(fdescr->type->tag == FIXFieldTag_CheckSum)
       {
-         res = int32_to_str(fdescr->type->tag, crc % 256, delimiter, 3, '0', &buff, &buffLen, error);
-      }
-      else if ((msg->parser->flags & PARSER_FLAG_CHECK_REQUIRED) && !field && (fdescr->flags & FIELD_FLAG_REQUIRED))
-      {
-         *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND, "Tag '%d' is required", fdescr->type->tag);
-         return FIX_FAILED;
+         if (delimiter != FIX_SOH)
+         {
+            crc = fix_utils_sum_bytes(begin, buff - begin);
+         }
+         buff = int32_to_str(fdescr->type, crc % 256, delimiter, 3, '0', buff);
       }
       else if (field && field->descr->category == FIXFieldCategory_Group)
       {
-         res = fix_groups_to_string(msg, field, fdescr, delimiter, &buff, &buffLen, error);
+         if (fix_groups_to_string(msg, field, fdescr, delimiter, &buff, error) == FIX_FAILED)
+         {
+            return FIX_FAILED;
+         }
       }
       else if(field)
       {
@@ -503,16 +866,13 @@ FIX_PARSER_API FIXErrCode fix_msg_to_str(FIXMsg* msg, char delimiter, char* buff
                return FIX_FAILED;
             }
          }
-         res = field_to_str(field, delimiter, &buff, &buffLen, error);
-      }
-      if (res == FIX_FAILED)
-      {
-         return FIX_FAILED;
+         buff = field_to_str(field, delimiter, buff);
       }
-      for(;(field || fdescr->type->tag == FIXFieldTag_BodyLength) && prev != buff; ++prev)
+      if (delimiter == FIX_SOH && (fdescr->type->tag == FIXFieldTag_BeginString || fdescr->type->tag == FIXFieldTag_BodyLength))
       {
-         crc += *prev;
+         crc += fix_utils_sum_bytes(prev, buff - prev);
       }
    }
+   *reqBuffLen = buff - begin;
    return FIX_SUCCESS;
 }
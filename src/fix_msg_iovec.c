@@ -0,0 +1,214 @@
+/**
+ * @file   fix_msg_iovec.c
+ * @author Dmitry S. Melnikov, dmitryme@gmail.com
+ * @date   Created on: 10/16/2026 03:41:08 PM
+ */
+
+#include "fix_msg.h"
+#include "fix_msg_priv.h"
+#include "fix_parser.h"
+#include "fix_parser_priv.h"
+#include "fix_protocol_descr.h"
+#include "fix_field.h"
+#include "fix_utils.h"
+#include "fix_error.h"
+
+#include <string.h>
+
+#define IOVEC_REF_MIN_LEN 64 ///< values shorter than this are copied to buffer, longer ones are referred by own iovec
+
+/**
+ * state of message conversion to iovecs
+ */
+typedef struct IovecWriter_
+{
+   struct iovec* iov;   ///< output iovecs
+   uint32_t iov_count;  ///< count of output iovecs
+   uint32_t iov_used;   ///< required count of iovecs. Can be greater than iov_count
+   char* buff;          ///< buffer for tags, delimiters and short values
+   uint32_t buff_len;   ///< length of buffer
+   uint32_t buff_used;  ///< required length of buffer. Can be greater than buff_len
+   int32_t last_buff;   ///< last iovec refers to buffer, so it can be extended
+   int32_t sum;         ///< sum bytes of every written chunk
+   uint32_t crc;        ///< checksum of written data
+} IovecWriter;
+
+static void iovec_copy(IovecWriter* w, char const* data, uint32_t len);
+static void iovec_ref(IovecWriter* w, char const* data, uint32_t len);
+static void iovec_int(IovecWriter* w, FIXFieldType const* type, int32_t val, uint32_t width, char delimiter);
+static void iovec_field(IovecWriter* w, FIXField const* field, char delimiter);
+static FIXErrCode iovec_groups(IovecWriter* w, FIXMsg* msg, FIXField const* field, FIXFieldDescr const* fdescr, char delimiter,
+      FIXError** error);
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+/* PUBLICS                                                                                                                */
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_to_iovec(FIXMsg* msg, char delimiter, struct iovec* iov, uint32_t iovCount, uint32_t* reqIovCount,
+      char* buff, uint32_t buffLen, uint32_t* reqBuffLen, FIXError** error)
+{
+   if (!msg || !reqIovCount || !reqBuffLen)
+   {
+      return FIX_FAILED;
+   }
+   if (UNLIKE(msg->lazy) && fix_parser_lazy_parse_all(msg, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
+   if ((msg->parser->flags & PARSER_FLAG_CHECK_REQUIRED) && fix_msg_check_required(msg, NULL, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
+   IovecWriter w = {iov, iovCount, 0, buff, buffLen, 0, 0, delimiter != FIX_SOH, delimiter == FIX_SOH ? msg->crc : 0};
+   FIXMsgDescr const* descr = msg->descr;
+   for(uint32_t i = 0; i < descr->field_count; ++i)
+   {
+      FIXFieldDescr* fdescr = &descr->fields[i];
+      FIXField* field = fix_field_get_by_slot(msg, NULL, i);
+      if (fdescr->type->tag == FIXFieldTag_BodyLength)
+      {
+         w.sum = 1;
+         iovec_int(&w, fdescr->type, msg->body_len, 0, delimiter);
+         w.sum = delimiter != FIX_SOH;
+      }
+      else if(fdescr->type->tag == FIXFieldTag_CheckSum)
+      {
+         iovec_int(&w, fdescr->type, w.crc % 256, 3, delimiter);
+      }
+      else if (field && field->descr->category == FIXFieldCategory_Group)
+      {
+         if (iovec_groups(&w, msg, field, fdescr, delimiter, error) == FIX_FAILED)
+         {
+            return FIX_FAILED;
+         }
+      }
+      else if(field)
+      {
+         if (msg->parser->flags & PARSER_FLAG_CHECK_VALUE)
+         {
+            if (!fix_protocol_check_field_value(fdescr, field->data, field->size))
+            {
+               *error = fix_error_create(FIX_ERROR_WRONG_FIELD_VALUE, "Wrong field '%s' value.", fdescr->type->name);
+               return FIX_FAILED;
+            }
+         }
+         w.sum |= (fdescr->type->tag == FIXFieldTag_BeginString);
+         iovec_field(&w, field, delimiter);
+         w.sum = delimiter != FIX_SOH;
+      }
+   }
+   *reqIovCount = w.iov_used;
+   *reqBuffLen = w.buff_used;
+   if (w.iov_used > iovCount || w.buff_used > buffLen)
+   {
+      return FIX_ERROR_NO_MORE_SPACE;
+   }
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+/* PRIVATES                                                                                                               */
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void iovec_copy(IovecWriter* w, char const* data, uint32_t len)
+{
+   if (w->sum)
+   {
+      w->crc += fix_utils_sum_bytes(data, len);
+   }
+   if (!w->last_buff)
+   {
+      if (w->iov_used < w->iov_count)
+      {
+         w->iov[w->iov_used].iov_base = w->buff + w->buff_used;
+         w->iov[w->iov_used].iov_len = 0;
+      }
+      ++w->iov_used;
+      w->last_buff = 1;
+   }
+   if (w->buff_used + len <= w->buff_len) // once buffer is overflowed, only required space is calculated
+   {
+      memcpy(w->buff + w->buff_used, data, len);
+      if (w->iov_used <= w->iov_count)
+      {
+         w->iov[w->iov_used - 1].iov_len += len;
+      }
+   }
+   w->buff_used += len;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void iovec_ref(IovecWriter* w, char const* data, uint32_t len)
+{
+   if (w->sum)
+   {
+      w->crc += fix_utils_sum_bytes(data, len);
+   }
+   if (w->iov_used < w->iov_count)
+   {
+      w->iov[w->iov_used].iov_base = (void*)data;
+      w->iov[w->iov_used].iov_len = len;
+   }
+   ++w->iov_used;
+   w->last_buff = 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void iovec_int(IovecWriter* w, FIXFieldType const* type, int32_t val, uint32_t width, char delimiter)
+{
+   char value[16];
+   uint32_t len = fix_utils_i64toa(val, value, width ? width : sizeof(value), width ? '0' : 0);
+   value[len++] = delimiter;
+   iovec_copy(w, type->prefix, type->prefix_len);
+   iovec_copy(w, value, len);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void iovec_field(IovecWriter* w, FIXField const* field, char delimiter)
+{
+   iovec_copy(w, field->descr->type->prefix, field->descr->type->prefix_len);
+   if (field->size >= IOVEC_REF_MIN_LEN || IS_DATA_TYPE(field->descr->type->valueType))
+   {
+      iovec_ref(w, field->data, field->size);
+   }
+   else
+   {
+      iovec_copy(w, field->data, field->size);
+   }
+   iovec_copy(w, &delimiter, 1);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode iovec_groups(IovecWriter* w, FIXMsg* msg, FIXField const* field, FIXFieldDescr const* fdescr, char delimiter,
+      FIXError** error)
+{
+   iovec_int(w, field->descr->type, field->size, 0, delimiter);
+   for(uint32_t i = 0; i < field->size; ++i)
+   {
+      FIXGroup* group = ((FIXGroups*)field->data)->group[i];
+      if ((msg->parser->flags & PARSER_FLAG_CHECK_REQUIRED) && fix_msg_check_required(msg, group, error) == FIX_FAILED)
+      {
+         return FIX_FAILED;
+      }
+      for(uint32_t j = 0; j < fdescr->group_count; ++j)
+      {
+         FIXFieldDescr* child_fdescr = &fdescr->group[j];
+         FIXField* child_field = fix_field_get_by_slot(msg, group, j);
+         if (!child_field && j == 0)
+         {
+            *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND, "Field '%d' must be first field in group", child_fdescr->type->tag);
+            return FIX_FAILED;
+         }
+         else if (child_field && child_field->descr->category == FIXFieldCategory_Group)
+         {
+            if (iovec_groups(w, msg, child_field, child_fdescr, delimiter, error) == FIX_FAILED)
+            {
+               return FIX_FAILED;
+            }
+         }
+         else if(child_field)
+         {
+            iovec_field(w, child_field, delimiter);
+         }
+      }
+   }
+   return FIX_SUCCESS;
+}
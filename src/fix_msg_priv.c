@@ -14,7 +14,7 @@
 void* fix_msg_alloc(FIXMsg* msg, uint32_t size, FIXError** error)
 {
    FIXPage* curr_page = msg->curr_page;
-   if (sizeof(uint32_t) + curr_page->size - curr_page->offset >= size)
+   if (curr_page->size - curr_page->offset >= size + sizeof(uint32_t)) // data is prefixed with its size
    {
       uint32_t old_offset = curr_page->offset;
       *(uint32_t*)(&curr_page->data + curr_page->offset) = size;
@@ -23,7 +23,7 @@ void* fix_msg_alloc(FIXMsg* msg, uint32_t size, FIXError** error)
    }
    else
    {
-      FIXPage* new_page = fix_parser_alloc_page(msg->parser, size, error);
+      FIXPage* new_page = fix_parser_alloc_page(msg->parser, size + sizeof(uint32_t), error);
       if (!new_page)
       {
          return NULL;
@@ -115,111 +115,78 @@ FIXField* fix_msg_get_field(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag)
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
-FIXErrCode int32_to_str(FIXTagNum tag, int32_t val, char delimiter, uint32_t width, char padSym, char** buff, uint32_t* buffLen, FIXError** error)
+char* int32_to_str(FIXFieldType const* type, int32_t val, char delimiter, uint32_t width, char padSym, char* buff)
 {
-   if (UNLIKE(*buffLen == 0))
-   {
-      *error = fix_error_create(FIX_ERROR_NO_MORE_SPACE, "Not enough buffer space.");
-      return FIX_FAILED;
-   }
-   int32_t res = fix_utils_i64toa(tag, *buff, *buffLen, 0);
-   *buff += res;
-   *buffLen -= res;
-   if (UNLIKE(*buffLen == 0))
-   {
-      *error = fix_error_create(FIX_ERROR_NO_MORE_SPACE, "Not enough buffer space.");
-      return FIX_FAILED;
-   }
-   *(*buff) = '=';
-   *buff += 1;
-   *buffLen -= 1;
-   if (UNLIKE(*buffLen == 0))
-   {
-      *error = fix_error_create(FIX_ERROR_NO_MORE_SPACE, "Not enough buffer space.");
-      return FIX_FAILED;
-   }
-   res = fix_utils_i64toa(val, *buff, (width == 0) ? *buffLen : width, padSym);
-   *buff += res;
-   *buffLen -= res;
-   if (UNLIKE(*buffLen == 0))
-   {
-      *error = fix_error_create(FIX_ERROR_NO_MORE_SPACE, "Not enough buffer space.");
-      return FIX_FAILED;
-   }
-   *(*buff) = delimiter;
-   *buff += 1;
-   *buffLen -= 1;
-   return FIX_SUCCESS;
+   memcpy(buff, type->prefix, type->prefix_len);
+   buff += type->prefix_len;
+   buff += fix_utils_i64toa(val, buff, (width == 0) ? 11 : width, padSym);
+   *buff = delimiter;
+   return buff + 1;
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
-FIXErrCode field_to_str(FIXField const* field, char delimiter, char** buff, uint32_t* buffLen, FIXError** error)
+char* field_to_str(FIXField const* field, char delimiter, char* buff)
 {
-   if (UNLIKE(*buffLen == 0))
-   {
-      *error = fix_error_create(FIX_ERROR_NO_MORE_SPACE, "Not enough buffer space.");
-      return FIX_FAILED;
-   }
-   int32_t res = fix_utils_i64toa(field->descr->type->tag, *buff, *buffLen, 0);
-   *buff += res;
-   *buffLen -= res;
-   if (UNLIKE(*buffLen == 0))
-   {
-      *error = fix_error_create(FIX_ERROR_NO_MORE_SPACE, "Not enough buffer space.");
-      return FIX_FAILED;
-   }
-   *(*buff) = '=';
-   *buff += 1;
-   *buffLen -= 1;
-   if (UNLIKE(*buffLen == 0))
-   {
-      *error = fix_error_create(FIX_ERROR_NO_MORE_SPACE, "Not enough buffer space.");
-      return FIX_FAILED;
-   }
-   uint32_t const len = (*buffLen > field->size) ? field->size : *buffLen;
-   strncpy(*buff, (char const*)field->data, len);
-   *buff += len;
-   *buffLen -= len;
-   if (UNLIKE(*buffLen == 0))
+   FIXFieldType const* type = field->descr->type;
+   memcpy(buff, type->prefix, type->prefix_len);
+   buff += type->prefix_len;
+   memcpy(buff, field->data, field->size);
+   buff += field->size;
+   *buff = delimiter;
+   return buff + 1;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXErrCode fix_msg_check_required(FIXMsg* msg, FIXGroup* grp, FIXError** error)
+{
+   for(int32_t i = fix_field_get_missing(msg, grp, 0); i >= 0; i = fix_field_get_missing(msg, grp, i + 1))
    {
-      *error = fix_error_create(FIX_ERROR_NO_MORE_SPACE, "Not enough buffer space.");
-      return FIX_FAILED;
+      if (grp)
+      {
+         *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND, "Field '%d' is required", grp->parent_fdescr->group[i].type->tag);
+         return FIX_FAILED;
+      }
+      FIXTagNum const tag = msg->descr->fields[i].type->tag;
+      if (tag != FIXFieldTag_BodyLength && tag != FIXFieldTag_CheckSum)
+      {
+         *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND, "Tag '%d' is required", tag);
+         return FIX_FAILED;
+      }
    }
-   *(*buff) = delimiter;
-   *buff += 1;
-   *buffLen -= 1;
    return FIX_SUCCESS;
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIXErrCode fix_groups_to_string(FIXMsg* msg, FIXField const* field, FIXFieldDescr const* fdescr, char delimiter,
-      char** buff, uint32_t* buffLen, FIXError** error)
+      char** buff, FIXError** error)
 {
-   FIXErrCode res = int32_to_str(field->descr->type->tag, field->size, delimiter, 0, 0, buff, buffLen, error);
-   for(uint32_t i = 0; i < field->size && res != FIX_FAILED; ++i)
+   *buff = int32_to_str(field->descr->type, field->size, delimiter, 0, 0, *buff);
+   for(uint32_t i = 0; i < field->size; ++i)
    {
       FIXGroup* group = ((FIXGroups*)field->data)->group[i];
-      for(uint32_t i = 0; i < fdescr->group_count && res == FIX_SUCCESS; ++i)
+      if ((msg->parser->flags & PARSER_FLAG_CHECK_REQUIRED) && fix_msg_check_required(msg, group, error) == FIX_FAILED)
       {
-         FIXFieldDescr* child_fdescr = &fdescr->group[i];
-         FIXField* child_field = fix_field_get(msg, group, child_fdescr->type->tag);
-         if ((msg->parser->flags & PARSER_FLAG_CHECK_REQUIRED) && !child_field && (child_fdescr->flags & FIELD_FLAG_REQUIRED))
-         {
-            *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND, "Field '%d' is required", child_fdescr->type->tag);
-            return FIX_FAILED;
-         }
-         else if (!child_field && i == 0)
+         return FIX_FAILED;
+      }
+      for(uint32_t j = 0; j < fdescr->group_count; ++j)
+      {
+         FIXFieldDescr* child_fdescr = &fdescr->group[j];
+         FIXField* child_field = fix_field_get_by_slot(msg, group, j);
+         if (!child_field && j == 0)
          {
             *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND, "Field '%d' must be first field in group", child_fdescr->type->tag);
             return FIX_FAILED;
          }
          else if (child_field && child_field->descr->category == FIXFieldCategory_Group)
          {
-            res = fix_groups_to_string(msg, child_field, child_fdescr, delimiter, buff, buffLen, error);
+            if (fix_groups_to_string(msg, child_field, child_fdescr, delimiter, buff, error) == FIX_FAILED)
+            {
+               return FIX_FAILED;
+            }
          }
          else if(child_field)
          {
-            res = field_to_str(child_field, delimiter, buff, buffLen, error);
+            *buff = field_to_str(child_field, delimiter, *buff);
          }
       }
    }
@@ -21,6 +21,30 @@ extern "C"
 {
 #endif
 
+/**
+ * top-level FIX field, which is not parsed yet
+ */
+typedef struct FIXLazyField_
+{
+   FIXFieldDescr const* descr; ///< FIX field description. NULL - field is already parsed
+   uint32_t begin;             ///< position of field in message index
+   uint32_t end;               ///< position after field (and its group entries) in message index
+} FIXLazyField;
+
+/**
+ * not parsed part of FIX message. See PARSER_FLAG_LAZY
+ */
+typedef struct FIXMsgLazy_
+{
+   char const* data;           ///< parsed string, index offsets are relative to it
+   FIXFieldIndex const* index; ///< copy of message index
+   uint16_t* slots;            ///< index + 1 of field in fields array, indexed by position of field description. 0 - no field
+   uint64_t* present;          ///< bitmap of fields found in data, indexed by position of field description
+   uint32_t field_count;       ///< count of top-level fields
+   char delimiter;             ///< FIX field SOH
+   FIXLazyField fields[1];     ///< top-level fields
+} FIXMsgLazy;
+
 /**
  * FIX message
  */
@@ -33,6 +57,42 @@ struct FIXMsg_
    FIXPage* curr_page;        ///< current memory page
    FIXGroup* used_groups;     ///< used groups by this message
    uint32_t body_len;         ///< entire body len, if message converted to FIX data
+   uint32_t crc;              ///< sum of body bytes, if message converted to FIX data with FIX_SOH delimiter
+   FIXMsgLazy* lazy;          ///< not parsed fields. NULL - message is completely parsed
+};
+
+/**
+ * variable field of message template
+ */
+typedef struct FIXTemplateField_
+{
+   FIXFieldDescr const* descr; ///< FIX field description
+   uint32_t slot;              ///< position of field in message description
+   char* data;                 ///< field value. NULL - field is not set and is not serialized
+   uint32_t size;              ///< size of field value
+   uint32_t capacity;          ///< allocated size of data
+   uint32_t body_len;          ///< length of serialized field (prefix, value and delimiter). 0 - field is not set
+   uint32_t crc;               ///< sum of serialized field bytes
+} FIXTemplateField;
+
+/**
+ * FIX message with constant fields serialized once. See fix_msg_template_create
+ */
+struct FIXMsgTemplate_
+{
+   char delimiter;              ///< FIX field SOH
+   char header[32];             ///< serialized BeginString field
+   uint32_t header_len;         ///< length of header
+   uint32_t header_crc;         ///< sum of header bytes
+   char* body;                  ///< serialized constant fields
+   uint32_t* chunks;            ///< end offsets of constant chunks in body. Variable field order[i] follows chunk i
+   uint32_t const_len;          ///< length of all constant fields
+   uint32_t const_crc;          ///< sum of all constant fields bytes
+   uint32_t field_count;        ///< count of variable fields
+   FIXTemplateField* fields;    ///< variable fields in order they were passed to fix_msg_template_create
+   uint32_t* order;             ///< indexes of variable fields in order of serialization
+   uint32_t body_len;           ///< current length of message body
+   uint32_t crc;                ///< current sum of constant and variable fields bytes
 };
 
 /**
@@ -90,42 +150,47 @@ FIXGroup* fix_msg_alloc_group(FIXMsg* msg, FIXError** error);
 void fix_msg_free_group(FIXMsg* msg, FIXGroup* grp);
 
 /**
- * converts FIX group to string
+ * check, that all required fields of message or group are set. BodyLength and CheckSum of message are not checked,
+ * they are calculated on conversion
+ * @param[in] msg - FIX message
+ * @param[in] grp - FIX group, if its fields are checked, else must be NULL
+ * @param[out] error - error description
+ * @return FIX_SUCCESS - ok, FIX_FAILED - see error description
+ */
+FIXErrCode fix_msg_check_required(FIXMsg* msg, FIXGroup* grp, FIXError** error);
+
+/**
+ * converts FIX group to string. Buffer is not checked for space, it must be large enough for group (see body_len)
  * @param[in] msg - FIX message with converted FIX group
  * @param[in] field - FIX field with group data
  * @param[in] fdescr - FIX field description
  * @param[in] delimiter - FIX field SOH
- * @param[out] buff - space with converted data
- * @param[out] buffLen - size of converted data
+ * @param[in,out] buff - space for converted data, moved to the end of converted data
  * @param[out] error - error description
  * @return FIX_SUCCESS - ok, FIX_FAILED - see error description
  */
-FIXErrCode fix_groups_to_string(FIXMsg* msg, FIXField const* field, FIXFieldDescr const* fdescr, char delimiter, char** buff, uint32_t* buffLen, FIXError** error);
+FIXErrCode fix_groups_to_string(FIXMsg* msg, FIXField const* field, FIXFieldDescr const* fdescr, char delimiter, char** buff, FIXError** error);
 
 /**
- * convert numeric value to string
- * @param[in] tag - FIX field tag value
+ * convert numeric value to string. Buffer is not checked for space
+ * @param[in] type - FIX field type with precomputed tag prefix
  * @param[in] val - converted value
  * @param[in] delimiter - FIX field delimiter
  * @param[in] width - value width
  * @param[in] padSym - char for padding value width. E.g. tag = 35, width = 5, padSym = '0' and value is 10, so converted data is '35=00010'
- * @param[out] buff - buffer with converted data
- * @param[out] buffLen - size of converted data
- * @param[out] error - error description
- * @return FIX_SUCCESS - ok, FIX_FAILED - see error description
+ * @param[out] buff - buffer for converted data
+ * @return end of converted data
  */
-FIXErrCode int32_to_str(FIXTagNum tag, int32_t val, char delimiter, uint32_t width, char padSym, char** buff, uint32_t* buffLen, FIXError** error);
+char* int32_to_str(FIXFieldType const* type, int32_t val, char delimiter, uint32_t width, char padSym, char* buff);
 
 /**
- * convert FIX field to string
+ * convert FIX field to string. Buffer is not checked for space, it must be at least field->body_len
  * @param[in] field - FIX field being converted
  * @param[in] delimiter - FIX field SOH
- * @param[out] buff - buffer with converted data
- * @param[out] buffLen - size of converted data
- * @param[out] error - error description
- * @return FIX_SUCCESS - ok, FIX_FAILED - see error description
+ * @param[out] buff - buffer for converted data
+ * @return end of converted data
  */
-FIXErrCode field_to_str(FIXField const* field, char delimiter, char** buff, uint32_t* buffLen, FIXError** error);
+char* field_to_str(FIXField const* field, char delimiter, char* buff);
 
 #ifdef __cplusplus
 }
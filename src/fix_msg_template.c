@@ -0,0 +1,345 @@
+/**
+ * @file   fix_msg_template.c
+ * @author Dmitry S. Melnikov, dmitryme@gmail.com
+ * @date   Created on: 10/16/2026 10:12:44 AM
+ */
+
+#include "fix_msg.h"
+#include "fix_msg_priv.h"
+#include "fix_parser.h"
+#include "fix_parser_priv.h"
+#include "fix_protocol_descr.h"
+#include "fix_field.h"
+#include "fix_utils.h"
+#include "fix_error.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static FIXErrCode fix_msg_template_add_field(FIXMsgTemplate* tmpl, FIXMsg* msg, uint32_t idx, FIXFieldHandle const* handle,
+      FIXError** error);
+static FIXErrCode fix_msg_template_set_value(FIXMsgTemplate* tmpl, FIXTemplateField* field, char const* data, uint32_t len,
+      FIXError** error);
+static FIXTemplateField* fix_msg_template_get_field(FIXMsgTemplate* tmpl, uint32_t fieldIdx, FIXError** error);
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+/* PUBLICS                                                                                                                */
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXMsgTemplate* fix_msg_template_create(FIXMsg* msg, char delimiter, FIXFieldHandle const* fields,
+      uint32_t fieldCount, FIXError** error)
+{
+   if (!msg)
+   {
+      return NULL;
+   }
+   if (fieldCount && !fields)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Fields parameter is NULL");
+      return NULL;
+   }
+   if (UNLIKE(msg->lazy) && fix_parser_lazy_parse_all(msg, error) == FIX_FAILED)
+   {
+      return NULL;
+   }
+   FIXMsgTemplate* tmpl = (FIXMsgTemplate*)calloc(1, sizeof(FIXMsgTemplate));
+   tmpl->delimiter = delimiter;
+   tmpl->field_count = fieldCount;
+   tmpl->fields = (FIXTemplateField*)calloc(fieldCount + 1, sizeof(FIXTemplateField));
+   tmpl->order = (uint32_t*)calloc(fieldCount + 1, sizeof(uint32_t));
+   tmpl->chunks = (uint32_t*)calloc(fieldCount + 1, sizeof(uint32_t));
+   tmpl->body = (char*)malloc(msg->body_len + 1);
+   char* buff = tmpl->body;
+   uint32_t var = 0;
+   FIXMsgDescr const* descr = msg->descr;
+   for(uint32_t i = 0; i < fieldCount; ++i)
+   {
+      if (fix_msg_template_add_field(tmpl, msg, i, &fields[i], error) == FIX_FAILED)
+      {
+         goto error;
+      }
+   }
+   for(uint32_t i = 0; i < descr->field_count; ++i)
+   {
+      FIXFieldDescr const* fdescr = &descr->fields[i];
+      FIXField* field = fix_field_get_by_slot(msg, NULL, i);
+      FIXErrCode res = FIX_SUCCESS;
+      if (var < fieldCount && tmpl->fields[tmpl->order[var]].slot == i) // variable field ends constant chunk
+      {
+         tmpl->chunks[var] = buff - tmpl->body;
+         if (field)
+         {
+            res = fix_msg_template_set_value(tmpl, &tmpl->fields[tmpl->order[var]], field->data, field->size, error);
+         }
+         ++var;
+      }
+      else if (fdescr->type->tag == FIXFieldTag_BeginString)
+      {
+         if (field && field->size + 4 > sizeof(tmpl->header))
+         {
+            *error = fix_error_create(FIX_ERROR_WRONG_FIELD_VALUE, "BeginString is too long");
+            goto error;
+         }
+         if (field)
+         {
+            tmpl->header[0] = '8';
+            tmpl->header[1] = '=';
+            memcpy(tmpl->header + 2, field->data, field->size);
+            tmpl->header[field->size + 2] = delimiter;
+            tmpl->header_len = field->size + 3;
+            tmpl->header_crc = fix_utils_sum_bytes(tmpl->header, tmpl->header_len);
+         }
+      }
+      else if (fdescr->type->tag == FIXFieldTag_BodyLength || fdescr->type->tag == FIXFieldTag_CheckSum)
+      {
+         continue;
+      }
+      else if ((msg->parser->flags & PARSER_FLAG_CHECK_REQUIRED) && !field && (fdescr->flags & FIELD_FLAG_REQUIRED))
+      {
+         *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND, "Tag '%d' is required", fdescr->type->tag);
+         goto error;
+      }
+      else if (field && field->descr->category == FIXFieldCategory_Group)
+      {
+         res = fix_groups_to_string(msg, field, fdescr, delimiter, &buff, error);
+      }
+      else if (field)
+      {
+         buff = field_to_str(field, delimiter, buff);
+      }
+      if (res == FIX_FAILED)
+      {
+         goto error;
+      }
+   }
+   tmpl->const_len = buff - tmpl->body;
+   tmpl->const_crc = fix_utils_sum_bytes(tmpl->body, tmpl->const_len);
+   tmpl->body_len += tmpl->const_len;
+   tmpl->crc += tmpl->const_crc;
+   return tmpl;
+error:
+   fix_msg_template_free(tmpl);
+   return NULL;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API void fix_msg_template_free(FIXMsgTemplate* tmpl)
+{
+   if (!tmpl)
+   {
+      return;
+   }
+   for(uint32_t i = 0; i < tmpl->field_count; ++i)
+   {
+      free(tmpl->fields[i].data);
+   }
+   free(tmpl->fields);
+   free(tmpl->order);
+   free(tmpl->chunks);
+   free(tmpl->body);
+   free(tmpl);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_template_set_string_len(FIXMsgTemplate* tmpl, uint32_t fieldIdx, char const* val, uint32_t len,
+      FIXError** error)
+{
+   FIXTemplateField* field = fix_msg_template_get_field(tmpl, fieldIdx, error);
+   if (!field)
+   {
+      return FIX_FAILED;
+   }
+   if (!IS_STRING_TYPE(field->descr->type->valueType))
+   {
+      *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "Tag '%d' type is not compatible with value '%s'",
+            field->descr->type->tag, val);
+      return FIX_FAILED;
+   }
+   return fix_msg_template_set_value(tmpl, field, val, len, error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_template_set_string(FIXMsgTemplate* tmpl, uint32_t fieldIdx, char const* val, FIXError** error)
+{
+   return fix_msg_template_set_string_len(tmpl, fieldIdx, val, strlen(val), error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_template_set_int64(FIXMsgTemplate* tmpl, uint32_t fieldIdx, int64_t val, FIXError** error)
+{
+   FIXTemplateField* field = fix_msg_template_get_field(tmpl, fieldIdx, error);
+   if (!field)
+   {
+      return FIX_FAILED;
+   }
+   if (!IS_INT_TYPE(field->descr->type->valueType))
+   {
+      *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "Tag '%d' type is not compatrible with value '%ld'",
+            field->descr->type->tag, val);
+      return FIX_FAILED;
+   }
+   char buff[64] = {};
+   int32_t res = fix_utils_i64toa(val, buff, sizeof(buff), 0);
+   return fix_msg_template_set_value(tmpl, field, buff, res, error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_template_set_char(FIXMsgTemplate* tmpl, uint32_t fieldIdx, char val, FIXError** error)
+{
+   FIXTemplateField* field = fix_msg_template_get_field(tmpl, fieldIdx, error);
+   if (!field)
+   {
+      return FIX_FAILED;
+   }
+   if (!IS_CHAR_TYPE(field->descr->type->valueType))
+   {
+      *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "Tag '%d' type is not compatrible with value '%c'",
+            field->descr->type->tag, val);
+      return FIX_FAILED;
+   }
+   return fix_msg_template_set_value(tmpl, field, &val, 1, error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_template_set_double(FIXMsgTemplate* tmpl, uint32_t fieldIdx, double val, FIXError** error)
+{
+   FIXTemplateField* field = fix_msg_template_get_field(tmpl, fieldIdx, error);
+   if (!field)
+   {
+      return FIX_FAILED;
+   }
+   if (!IS_FLOAT_TYPE(field->descr->type->valueType))
+   {
+      *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "Tag '%d' type is not compatrible with value '%f'",
+            field->descr->type->tag, val);
+      return FIX_FAILED;
+   }
+   char buff[64] = {};
+   int32_t res = fix_utils_dtoa(val, buff, sizeof(buff));
+   return fix_msg_template_set_value(tmpl, field, buff, res, error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_template_to_str(FIXMsgTemplate* tmpl, char* buff, uint32_t buffLen, uint32_t* reqBuffLen,
+      FIXError** error)
+{
+   if (!tmpl || !buff || !reqBuffLen)
+   {
+      return FIX_FAILED;
+   }
+   // 8=FIX.4.4| + 9=LEN| + BODY + 10=XXX|
+   uint32_t const len_digits = fix_utils_numdigits(tmpl->body_len);
+   *reqBuffLen = tmpl->header_len + 2 + len_digits + 1 + tmpl->body_len + 7;
+   if (*reqBuffLen > buffLen)
+   {
+      return FIX_ERROR_NO_MORE_SPACE;
+   }
+   char* it = buff;
+   memcpy(it, tmpl->header, tmpl->header_len);
+   it += tmpl->header_len;
+   char* const len_begin = it;
+   *it++ = '9';
+   *it++ = '=';
+   it += fix_utils_i64toa(tmpl->body_len, it, len_digits, 0);
+   *it++ = tmpl->delimiter;
+   uint32_t const crc = tmpl->header_crc + fix_utils_sum_bytes(len_begin, it - len_begin) + tmpl->crc;
+   uint32_t offset = 0;
+   for(uint32_t i = 0; i < tmpl->field_count; ++i)
+   {
+      memcpy(it, tmpl->body + offset, tmpl->chunks[i] - offset);
+      it += tmpl->chunks[i] - offset;
+      offset = tmpl->chunks[i];
+      FIXTemplateField const* field = &tmpl->fields[tmpl->order[i]];
+      if (field->body_len)
+      {
+         memcpy(it, field->descr->type->prefix, field->descr->type->prefix_len);
+         it += field->descr->type->prefix_len;
+         memcpy(it, field->data, field->size);
+         it += field->size;
+         *it++ = tmpl->delimiter;
+      }
+   }
+   memcpy(it, tmpl->body + offset, tmpl->const_len - offset);
+   it += tmpl->const_len - offset;
+   *it++ = '1';
+   *it++ = '0';
+   *it++ = '=';
+   it += fix_utils_i64toa(crc % 256, it, 3, '0');
+   *it = tmpl->delimiter;
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+/* PRIVATES                                                                                                               */
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode fix_msg_template_add_field(FIXMsgTemplate* tmpl, FIXMsg* msg, uint32_t idx, FIXFieldHandle const* handle,
+      FIXError** error)
+{
+   if (handle->msg_descr != msg->descr)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Field handle is not resolved for message '%s'", msg->descr->type);
+      return FIX_FAILED;
+   }
+   FIXFieldDescr const* fdescr = &msg->descr->fields[handle->slot];
+   if (fdescr->category == FIXFieldCategory_Group || handle->tag == FIXFieldTag_BeginString ||
+       handle->tag == FIXFieldTag_BodyLength || handle->tag == FIXFieldTag_CheckSum)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Field '%d' can't be variable", handle->tag);
+      return FIX_FAILED;
+   }
+   FIXTemplateField* field = &tmpl->fields[idx];
+   field->descr = fdescr;
+   field->slot = handle->slot;
+   uint32_t pos = idx; // keep variable fields sorted by slot, so they are serialized in order of description
+   for(; pos > 0 && tmpl->fields[tmpl->order[pos - 1]].slot >= field->slot; --pos)
+   {
+      if (tmpl->fields[tmpl->order[pos - 1]].slot == field->slot)
+      {
+         *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Field '%d' is already variable", handle->tag);
+         return FIX_FAILED;
+      }
+      tmpl->order[pos] = tmpl->order[pos - 1];
+   }
+   tmpl->order[pos] = idx;
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode fix_msg_template_set_value(FIXMsgTemplate* tmpl, FIXTemplateField* field, char const* data, uint32_t len,
+      FIXError** error)
+{
+   if (len > field->capacity)
+   {
+      char* new_data = (char*)realloc(field->data, len);
+      if (!new_data)
+      {
+         *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate %u bytes", len);
+         return FIX_FAILED;
+      }
+      field->data = new_data;
+      field->capacity = len;
+   }
+   memcpy(field->data, data, len);
+   field->size = len;
+   tmpl->body_len -= field->body_len;
+   tmpl->crc -= field->crc;
+   field->body_len = field->descr->type->prefix_len + len + 1;
+   field->crc = field->descr->type->prefix_crc + fix_utils_sum_bytes(data, len) + (unsigned char)tmpl->delimiter;
+   tmpl->body_len += field->body_len;
+   tmpl->crc += field->crc;
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXTemplateField* fix_msg_template_get_field(FIXMsgTemplate* tmpl, uint32_t fieldIdx, FIXError** error)
+{
+   if (!tmpl)
+   {
+      return NULL;
+   }
+   if (fieldIdx >= tmpl->field_count)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Wrong variable field index %u", fieldIdx);
+      return NULL;
+   }
+   return &tmpl->fields[fieldIdx];
+}
@@ -11,6 +11,7 @@
 #include "fix_msg_priv.h"
 #include "fix_page.h"
 #include "fix_utils.h"
+#include "fix_thread.h"
 #include "fix_error_priv.h"
 #include "fix_field_tag.h"
 
@@ -19,76 +20,164 @@
 #include <string.h>
 #include <stdio.h>
 
-#define CRC_FIELD_LEN 7
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void fix_parser_create_pools(FIXParser* parser)
+{
+   for(uint32_t i = 0; i < parser->attrs.numPages; ++i)
+   {
+      FIXPage* page = (FIXPage*)calloc(1, sizeof(FIXPage) + parser->attrs.pageSize - 1);
+      page->size = parser->attrs.pageSize;
+      page->next = parser->page;
+      parser->page = page;
+   }
+   for(uint32_t i = 0; i < parser->attrs.numGroups; ++i)
+   {
+      FIXGroup* group = (FIXGroup*)calloc(1, sizeof(FIXGroup));
+      group->next = parser->group;
+      parser->group = group;
+   }
+}
 
 /*------------------------------------------------------------------------------------------------------------------------*/
-FIX_PARSER_API FIXParser* fix_parser_create(char const* protFile, FIXParserAttrs const* attrs, int32_t flags, FIXError** error)
+FIX_PARSER_API FIXProtocolDescr const* fix_protocol_create(char const* protFile, FIXError** error)
+{
+   return fix_protocol_descr_create(protFile, error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXProtocolDescr const* fix_protocol_create_from_image(char const* imageFile, FIXError** error)
+{
+   if (!imageFile)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Image file is NULL.");
+      return NULL;
+   }
+   return fix_protocol_descr_load_image(imageFile, error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_protocol_save_image(FIXProtocolDescr const* protocol, char const* imageFile, FIXError** error)
+{
+   if (!protocol || !imageFile)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Protocol or image file is NULL.");
+      return FIX_FAILED;
+   }
+   return fix_protocol_descr_save_image(protocol, imageFile, error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API void fix_protocol_free(FIXProtocolDescr const* protocol)
 {
+   if (protocol && !fix_atomic_dec(&((FIXProtocolDescr*)protocol)->ref_count))
+   {
+      fix_protocol_descr_free(protocol);
+   }
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXParser* fix_parser_create_from_protocol(FIXProtocolDescr const* protocol, FIXParserAttrs const* attrs,
+      int32_t flags, FIXError** error)
+{
+   if (!protocol)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Protocol is NULL.");
+      return NULL;
+   }
    FIXParserAttrs myattrs = {};
    if (attrs)
    {
       memcpy(&myattrs, attrs, sizeof(myattrs));
    }
-   FIXParser* parser = NULL;
    if (fix_parser_validate_attrs(&myattrs, error) == FIX_FAILED)
    {
-      goto failed;
+      return NULL;
    }
-   parser = (FIXParser*)calloc(1, sizeof(FIXParser));
+   FIXParser* parser = (FIXParser*)calloc(1, sizeof(FIXParser));
    memcpy(&parser->attrs, &myattrs, sizeof(parser->attrs));
    parser->flags = flags;
-   parser->protocol = fix_protocol_descr_create(protFile, error);
-   if (!parser->protocol)
+   parser->cache = (FIXPoolCacheLine*)(((uintptr_t)parser->cache_buff + CACHE_LINE_SIZE - 1) & ~(uintptr_t)(CACHE_LINE_SIZE - 1));
+   fix_atomic_inc(&((FIXProtocolDescr*)protocol)->ref_count);
+   parser->protocol = protocol;
+   fix_parser_create_pools(parser);
+   return parser;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXParser* fix_parser_create(char const* protFile, FIXParserAttrs const* attrs, int32_t flags, FIXError** error)
+{
+   FIXParserAttrs myattrs = {};
+   if (attrs)
    {
-      goto failed;
+      memcpy(&myattrs, attrs, sizeof(myattrs));
    }
-   for(uint32_t i = 0; i < parser->attrs.numPages; ++i)
+   if (fix_parser_validate_attrs(&myattrs, error) == FIX_FAILED)
    {
-      FIXPage* page = (FIXPage*)calloc(1, sizeof(FIXPage) + parser->attrs.pageSize - 1);
-      page->size = parser->attrs.pageSize;
-      page->next = parser->page;
-      parser->page = page;
+      return NULL;
    }
-   for(uint32_t i = 0; i < parser->attrs.numGroups; ++i)
+   FIXProtocolDescr const* protocol = fix_protocol_create(protFile, error);
+   if (!protocol)
    {
-      FIXGroup* group = (FIXGroup*)calloc(1, sizeof(FIXGroup));
-      group->next = parser->group;
-      parser->group = group;
+      return NULL;
    }
-   goto ok;
-failed:
-   if (parser)
+   FIXParser* parser = fix_parser_create_from_protocol(protocol, &myattrs, flags, error);
+   fix_protocol_free(protocol); // parser holds its own reference
+   return parser;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXParser* fix_parser_create_from_image(char const* imageFile, FIXParserAttrs const* attrs, int32_t flags,
+      FIXError** error)
+{
+   FIXParserAttrs myattrs = {};
+   if (attrs)
    {
-      free(parser);
-      parser = NULL;
+      memcpy(&myattrs, attrs, sizeof(myattrs));
+   }
+   if (fix_parser_validate_attrs(&myattrs, error) == FIX_FAILED)
+   {
+      return NULL;
+   }
+   FIXProtocolDescr const* protocol = fix_protocol_create_from_image(imageFile, error);
+   if (!protocol)
+   {
+      return NULL;
    }
-ok:
+   FIXParser* parser = fix_parser_create_from_protocol(protocol, &myattrs, flags, error);
+   fix_protocol_free(protocol); // parser holds its own reference
    return parser;
 }
 
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXProtocolDescr const* fix_parser_get_protocol(FIXParser const* parser)
+{
+   return parser ? parser->protocol : NULL;
+}
+
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIX_PARSER_API void fix_parser_free(FIXParser* parser)
 {
    if (parser)
    {
-      if (parser->protocol)
+      fix_protocol_free(parser->protocol);
+      for(int32_t i = -1; i < POOL_CACHE_COUNT; ++i) // -1 - parser pool, others - thread caches
       {
-         fix_protocol_descr_free(parser->protocol);
-      }
-      FIXPage* page = parser->page;
-      while(page)
-      {
-         FIXPage* next = page->next;
-         free(page);
-         page = next;
-      }
-      FIXGroup* group = parser->group;
-      while(group)
-      {
-         FIXGroup* next = group->next;
-         free(group);
-         group = next;
+         FIXPage* page = (i < 0) ? parser->page : parser->cache[i].cache.page;
+         while(page)
+         {
+            FIXPage* next = page->next;
+            free(page);
+            page = next;
+         }
+         FIXGroup* group = (i < 0) ? parser->group : parser->cache[i].cache.group;
+         while(group)
+         {
+            FIXGroup* next = group->next;
+            free(group);
+            group = next;
+         }
       }
+      free(parser->index);
       free(parser);
    }
 }
@@ -170,25 +259,79 @@ FIX_PARSER_API FIXErrCode fix_parser_get_header(char const* data, uint32_t len,
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
-FIX_PARSER_API FIXMsg* fix_parser_str_to_msg(FIXParser* parser, char const* data, uint32_t len, char delimiter,
-      char const** stop, FIXError** error)
+// length of Data field is a value of its Length field (see FIXMsgDescr::data_lens) among already indexed ones
+static FIXErrCode fix_parser_get_data_len(FIXParser* parser, char const* data, FIXFieldIndex const* msgType,
+      FIXMsgDescr const** mdescr, FIXFieldIndex const* lens, uint32_t lenCount, FIXTagNum tag, int32_t* dataLen,
+      FIXError** error)
 {
-   if (!parser || !data)
+   if (!*mdescr) // message description is looked up once, with the first Data field
    {
-      return NULL;
+      char type[32] = {};
+      if (!msgType || msgType->len >= sizeof(type))
+      {
+         *error = fix_error_create(FIX_ERROR_UNKNOWN_MSG, "Unable to get message type for data field '%d'.", tag);
+         return FIX_FAILED;
+      }
+      memcpy(type, data + msgType->offset, msgType->len);
+      *mdescr = fix_protocol_get_msg_descr(parser, type, error);
+      if (!*mdescr)
+      {
+         return FIX_FAILED;
+      }
+   }
+   FIXTagNum lenTag = 0;
+   for(uint32_t i = 0; i < (*mdescr)->data_len_count && !lenTag; ++i)
+   {
+      lenTag = ((*mdescr)->data_lens[i * 2] == tag) ? (*mdescr)->data_lens[i * 2 + 1] : 0;
+   }
+   if (!lenTag)
+   {
+      *error = fix_error_create(
+            FIX_ERROR_UNKNOWN_FIELD, "Data field '%d' not found in message '%s' description.", tag, (*mdescr)->type);
+      return FIX_FAILED;
    }
+   for(uint32_t i = lenCount; i > 0 && i + INDEX_LEN_FIELDS > lenCount; --i) // the latest Length field first
+   {
+      FIXFieldIndex const* len = &lens[(i - 1) % INDEX_LEN_FIELDS];
+      if (len->tag == lenTag)
+      {
+         int32_t cnt = 0;
+         if (fix_utils_atoi32(data + len->offset, len->len, 0, dataLen, &cnt) < 0 || *dataLen < 0)
+         {
+            break;
+         }
+         return FIX_SUCCESS;
+      }
+   }
+   *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Unable to get length of data field '%d'.", tag);
+   return FIX_FAILED;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_parser_index(FIXParser* parser, char const* data, uint32_t len, char delimiter,
+      FIXFieldIndex* index, uint32_t indexSize, uint32_t* count, int32_t* checkSum, char const** stop, FIXError** error)
+{
+   if (!parser || !data || !count)
+   {
+      return FIX_FAILED;
+   }
+   *count = 0;
    FIXTagNum tag = 0;
    char const* dbegin = NULL;
    char const* dend = NULL;
    tag = fix_parser_parse_mandatory_field(data, len, delimiter, &dbegin, &dend, error);
    if (tag == FIX_FAILED)
    {
-      return NULL;
+      if ((*error)->code == FIX_ERROR_NO_MORE_DATA) // message header is incomplete
+      {
+         *stop = data + len;
+      }
+      return FIX_FAILED;
    }
    if (tag != FIXFieldTag_BeginString)
    {
       *error = fix_error_create(FIX_ERROR_WRONG_FIELD, "First field is '%d', but must be BeginString.", tag);
-      return NULL;
+      return FIX_FAILED;
    }
    if (strncmp(parser->protocol->transportVersion, dbegin, dend - dbegin))
    {
@@ -198,17 +341,29 @@ FIX_PARSER_API FIXMsg* fix_parser_str_to_msg(FIXParser* parser, char const* data
             FIX_ERROR_WRONG_PROTOCOL_VER,
             "Wrong protocol. Expected '%s', actual '%s'.", parser->protocol->transportVersion, actualVer);
       free(actualVer);
-      return NULL;
+      return FIX_FAILED;
    }
+   uint32_t n = 0;
+   if (n < indexSize)
+   {
+      index[n].tag = tag;
+      index[n].offset = dbegin - data;
+      index[n].len = dend - dbegin;
+   }
+   ++n;
    tag = fix_parser_parse_mandatory_field(dend + 1, len - (dend + 1 - data), delimiter, &dbegin, &dend, error);
    if (tag == FIX_FAILED)
    {
-      return NULL;
+      if ((*error)->code == FIX_ERROR_NO_MORE_DATA) // message header is incomplete
+      {
+         *stop = data + len;
+      }
+      return FIX_FAILED;
    }
    if (tag != FIXFieldTag_BodyLength)
    {
       *error = fix_error_create(FIX_ERROR_WRONG_FIELD, "Second field is '%d', but must be BodyLength.", tag);
-      return NULL;
+      return FIX_FAILED;
    }
    int64_t bodyLen;
    int32_t cnt;
@@ -216,143 +371,242 @@ FIX_PARSER_API FIXMsg* fix_parser_str_to_msg(FIXParser* parser, char const* data
    if (err < 0)
    {
       *error = fix_error_create(err, "BodyLength value not a number.");
-      return NULL;
+      return FIX_FAILED;
    }
    if (bodyLen + CRC_FIELD_LEN > len - (dend - data))
    {
       *error = fix_error_create(FIX_ERROR_NO_MORE_DATA, "Body too short.");
       *stop = data + len;
-      return NULL;
+      return FIX_FAILED;
+   }
+   if (n < indexSize)
+   {
+      index[n].tag = tag;
+      index[n].offset = dbegin - data;
+      index[n].len = dend - dbegin;
    }
-   char const* crcbeg = NULL;
+   ++n;
+   uint32_t crc = fix_utils_sum_bytes(data, dend + 1 - data);
    char const* bodyEnd = dend + bodyLen;
-   tag = fix_parser_parse_mandatory_field(bodyEnd + 1, len - (bodyEnd + 1 - data), delimiter, &crcbeg, stop, error);
+   FIXFieldIndex msgType = {};
+   FIXMsgDescr const* mdescr = NULL;
+   FIXFieldIndex lens[INDEX_LEN_FIELDS]; // last Length fields, ring buffer
+   uint32_t lenCount = 0;
+   while(dend != bodyEnd)
+   {
+      char const* fbegin = dend + 1;
+      if (fix_utils_atoi32(fbegin, bodyEnd - dend, '=', &tag, &cnt) < 0)
+      {
+         *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Unable to extract field number.");
+         return FIX_FAILED;
+      }
+      dbegin = fbegin + cnt + 1;
+      FIXFieldType const* ftype = fix_protocol_get_field_type_by_tag(parser->protocol, tag);
+      if (ftype && ftype->valueType == FIXFieldValueType_Data) // Data field length is stored in its Length field
+      {
+         int32_t dataLength = 0;
+         if (fix_parser_get_data_len(
+                  parser, data, msgType.tag ? &msgType : NULL, &mdescr, lens, lenCount, tag, &dataLength, error) == FIX_FAILED)
+         {
+            return FIX_FAILED;
+         }
+         dend = dbegin + dataLength;
+         if (dend > bodyEnd || *dend != delimiter)
+         {
+            *error = fix_error_create(FIX_ERROR_NO_MORE_DATA, "Field value must be terminated with '%c' delimiter.", delimiter);
+            return FIX_FAILED;
+         }
+      }
+      else
+      {
+         dend = fix_utils_find_char(dbegin, bodyEnd - dbegin + 1, delimiter);
+         if (!dend)
+         {
+            *error = fix_error_create(FIX_ERROR_NO_MORE_DATA, "Field value must be terminated with '%c' delimiter.", delimiter);
+            return FIX_FAILED;
+         }
+      }
+      crc += fix_utils_sum_bytes(fbegin, dend + 1 - fbegin);
+      if (n < indexSize)
+      {
+         index[n].tag = tag;
+         index[n].offset = dbegin - data;
+         index[n].len = dend - dbegin;
+      }
+      if (tag == FIXFieldTag_MsgType)
+      {
+         msgType.tag = tag;
+         msgType.offset = dbegin - data;
+         msgType.len = dend - dbegin;
+      }
+      else if (ftype && ftype->valueType == FIXFieldValueType_Length)
+      {
+         FIXFieldIndex* lenField = &lens[lenCount++ % INDEX_LEN_FIELDS];
+         lenField->tag = tag;
+         lenField->offset = dbegin - data;
+         lenField->len = dend - dbegin;
+      }
+      ++n;
+   }
+   tag = fix_parser_parse_mandatory_field(bodyEnd + 1, len - (bodyEnd + 1 - data), delimiter, &dbegin, stop, error);
    if (tag == FIX_FAILED)
    {
-      return NULL;
+      return FIX_FAILED;
    }
    if (tag != FIXFieldTag_CheckSum)
    {
       *error = fix_error_create(FIX_ERROR_WRONG_FIELD, "Field is '%d', but must be CrcSum.", tag);
-      return NULL;
+      return FIX_FAILED;
    }
-   //printf("flags = %d, CRC = '%.*s'\n", parser->flags, *stop - crcbeg, crcbeg);
-   if (parser->flags & PARSER_FLAG_CHECK_CRC)
+   if (n < indexSize)
    {
-      int32_t check_sum = 0;
-      if (fix_utils_atoi32(crcbeg, *stop - crcbeg, 0, &check_sum, &cnt) < 0)
-      {
-         *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "CheckSum value not a number.");
-         return NULL;
-      }
-      int32_t crc = 0;
-      for(char const* it = data; it <= bodyEnd; ++it)
-      {
-         crc += *it;
-      }
-      //printf("BODY = %.*s, SUM = %d, CRC = %d\n", bodyEnd - data, data, crc, (crc % 256));
-      crc %= 256;
-      //printf("CRC = %d, CRC1 = %d\n", crc, check_sum);
-      if (crc != check_sum)
+      index[n].tag = tag;
+      index[n].offset = dbegin - data;
+      index[n].len = *stop - dbegin;
+   }
+   ++n;
+   *count = n;
+   if (checkSum)
+   {
+      *checkSum = crc % 256;
+   }
+   if (n > indexSize)
+   {
+      return FIX_ERROR_NO_MORE_SPACE;
+   }
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode fix_parser_index_msg(FIXParser* parser, char const* data, uint32_t len, char delimiter, FIXFieldIndex** index,
+      uint32_t* indexSize, uint32_t* count, int32_t* checkSum, char const** stop, FIXError** error)
+{
+   FIXErrCode res = fix_parser_index(parser, data, len, delimiter, *index, *indexSize, count, checkSum, stop, error);
+   if (res == FIX_ERROR_NO_MORE_SPACE) // grow index and try again
+   {
+      free(*index);
+      *indexSize = *count * 2;
+      *index = (FIXFieldIndex*)malloc(*indexSize * sizeof(FIXFieldIndex));
+      if (!*index)
       {
-         *error = fix_error_create(
-               FIX_ERROR_INTEGRITY_CHECK, "CheckSum check failed. Expected '%d', actual '%d'.", check_sum, crc);
-         return NULL;
+         *indexSize = 0;
+         *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate message index of %u entries.", *count * 2);
+         return FIX_FAILED;
       }
+      res = fix_parser_index(parser, data, len, delimiter, *index, *indexSize, count, checkSum, stop, error);
    }
-   tag = fix_parser_parse_mandatory_field(dend + 1, bodyEnd - dend, delimiter, &dbegin, &dend, error);
-   if (tag == FIX_FAILED)
+   return res;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static int32_t fix_parser_lock_index(FIXParser* parser, FIXFieldIndex** index, uint32_t* indexSize)
+{
+   if (fix_atomic_cas(&parser->index_lock, 0, 1))
    {
-      return NULL;
+      *index = parser->index;
+      *indexSize = parser->index_size;
+      return 1;
    }
-   if (tag != FIXFieldTag_MsgType)
+   *index = NULL; // parser index is used by another thread, so caller gets its own one
+   *indexSize = 0;
+   return 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void fix_parser_unlock_index(FIXParser* parser, int32_t locked, FIXFieldIndex* index, uint32_t indexSize)
+{
+   if (locked)
    {
-      *error = fix_error_create(FIX_ERROR_WRONG_FIELD, "Field is '%d', but must be MsgType.", tag);
-      return NULL;
+      parser->index = index;
+      parser->index_size = indexSize;
+      fix_atomic_release(&parser->index_lock);
    }
-   char* msgType = (char*)calloc(dend - dbegin + 1, 1);
-   memcpy(msgType, dbegin, dend - dbegin);
-   FIXMsg* msg = fix_msg_create(parser, msgType, error);
-   free(msgType);
-   if (!msg)
+   else
    {
-      return NULL;
+      free(index);
    }
-   if (fix_msg_set_int32(msg, NULL, FIXFieldTag_BodyLength, bodyLen, error) != FIX_SUCCESS)
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXMsg* fix_parser_str_to_msg(FIXParser* parser, char const* data, uint32_t len, char delimiter,
+      char const** stop, FIXError** error)
+{
+   if (!parser || !data)
    {
-      goto error;
+      return NULL;
    }
-   FIXFieldDescr const* fdescr  = fix_protocol_get_field_descr(msg->descr, FIXFieldTag_CheckSum);
-   if (!fdescr)
+   uint32_t count = 0;
+   int32_t checkSum = 0;
+   FIXFieldIndex* index = NULL;
+   uint32_t indexSize = 0;
+   int32_t locked = fix_parser_lock_index(parser, &index, &indexSize);
+   FIXMsg* msg = NULL;
+   if (fix_parser_index_msg(parser, data, len, delimiter, &index, &indexSize, &count, &checkSum, stop, error) == FIX_SUCCESS)
    {
-      *error = fix_error_create(FIX_ERROR_UNKNOWN_FIELD, "Field with tag %d not found in message '%s' description.",
-            tag, msg->descr->name);
-      goto error;
+      msg = fix_parser_index_to_msg(parser, data, index, count, checkSum, delimiter, error);
    }
-   char crc[4] = {};
-   memcpy(crc, crcbeg, *stop - crcbeg);
-   if (!fix_field_set(msg, NULL, fdescr, (unsigned char*)crcbeg, *stop - crcbeg, error))
+   fix_parser_unlock_index(parser, locked, index, indexSize);
+   return msg;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API uint32_t fix_parser_str_to_msgs(FIXParser* parser, char const* data, uint32_t len, char delimiter,
+      FIXMsg** msgs, FIXError** errors, uint32_t maxMsgs, char const** stop)
+{
+   if (!parser || !data || !msgs || !stop)
    {
-      goto error;
+      return 0;
    }
-   while(dend != bodyEnd)
+   char const* const end = data + len;
+   uint32_t n = 0;
+   *stop = data;
+   FIXFieldIndex* index = NULL;
+   uint32_t indexSize = 0;
+   int32_t locked = fix_parser_lock_index(parser, &index, &indexSize);
+   while(n < maxMsgs && *stop != end)
    {
-      fdescr = NULL;
-      tag = fix_parser_parse_field(parser, msg, NULL, dend + 1, bodyEnd - dend, delimiter, &fdescr, &dbegin, &dend, error);
-      if (tag == FIX_FAILED)
+      char const* begin = *stop;
+      char const* msgEnd = NULL;
+      uint32_t count = 0;
+      int32_t checkSum = 0;
+      FIXError* error = NULL;
+      FIXMsg* msg = NULL;
+      if (fix_parser_index_msg(
+               parser, begin, end - begin, delimiter, &index, &indexSize, &count, &checkSum, &msgEnd, &error) == FIX_SUCCESS)
       {
-         goto error;
+         msg = fix_parser_index_to_msg(parser, begin, index, count, checkSum, delimiter, &error);
+         *stop = msgEnd + 1;
       }
-      if (fdescr) // if !fdescr, ignore this field
+      else if (error && error->code == FIX_ERROR_NO_MORE_DATA && msgEnd == end) // incomplete message at the end of data
       {
-         if (parser->flags & PARSER_FLAG_CHECK_VALUE)
-         {
-            if (fix_parser_check_value(fdescr, dbegin, dend, delimiter, error) == FIX_FAILED)
-            {
-               goto error;
-            }
-         }
-         if (fdescr->category == FIXFieldCategory_Value)
-         {
-            if (!fix_field_set(msg, NULL, fdescr, (unsigned char*)dbegin, dend - dbegin, error))
-            {
-               goto error;
-            }
-         }
-         else if (fdescr->category == FIXFieldCategory_Group)
+         fix_error_free(error);
+         break;
+      }
+      else // message is broken, so try to find beginning of the next message
+      {
+         char const* it = begin;
+         *stop = end;
+         while((it = fix_utils_find_char(it, end - it, delimiter)))
          {
-            int64_t numGroups = 0;
-            FIXErrCode err = fix_utils_atoi64(dbegin, dend - dbegin + 1, delimiter, &numGroups, &cnt);
-            if (err < 0)
-            {
-               *error = fix_error_create(err, "Unable to get group tag %d value.", tag);
-               goto  error;
-            }
-            if (FIX_FAILED == fix_parser_parse_group(parser, msg, NULL, fdescr, numGroups, dend, bodyEnd, delimiter, &dend, error))
+            ++it;
+            if (end - it >= 2 && it[0] == '8' && it[1] == '=')
             {
-               goto error;
+               *stop = it;
+               break;
             }
          }
       }
-   }
-   if (parser->flags & PARSER_FLAG_CHECK_REQUIRED)
-   {
-      for(uint32_t i = 0; i < msg->descr->field_count; ++i)
+      msgs[n] = msg;
+      if (errors)
       {
-         FIXFieldDescr* fdescr = &msg->descr->fields[i];
-         if (fdescr->flags & FIELD_FLAG_REQUIRED && !fix_field_get(msg, NULL, fdescr->type->tag))
-         {
-            *error = fix_error_create(FIX_ERROR_UNKNOWN_FIELD, "Required field '%s' not found.", fdescr->type->name);
-            goto error;
-         }
+         errors[n] = error;
       }
+      else if (error)
+      {
+         fix_error_free(error);
+      }
+      ++n;
    }
-   return msg;
-error:
-   if (msg)
-   {
-      fix_msg_free(msg);
-      msg = NULL;
-   }
-   return msg;
+   fix_parser_unlock_index(parser, locked, index, indexSize);
+   return n;
 }
@@ -7,25 +7,163 @@
 #include "fix_parser_priv.h"
 #include "fix_utils.h"
 #include "fix_msg.h"
+#include "fix_msg_priv.h"
+#include "fix_field_tag.h"
 #include "fix_error_priv.h"
+#include "fix_thread.h"
 
+#include <stdlib.h>
 #include <string.h>
 
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXPoolCache* fix_parser_lock_cache(FIXParser* parser)
+{
+   FIXPoolCache* cache = &parser->cache[fix_thread_index() % POOL_CACHE_COUNT].cache;
+   return fix_atomic_cas(&cache->lock, 0, 1) ? cache : NULL; // NULL - cache is busy
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void fix_parser_unlock_cache(FIXPoolCache* cache)
+{
+   fix_atomic_release(&cache->lock);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static int32_t fix_parser_inc_used(uint32_t volatile* used, uint32_t maxUsed)
+{
+   uint32_t count = fix_atomic_inc((int32_t volatile*)used);
+   if (maxUsed > 0 && count > maxUsed)
+   {
+      fix_atomic_dec((int32_t volatile*)used);
+      return 0;
+   }
+   return 1;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void fix_parser_push_pages(FIXParser* parser, FIXPage* first, FIXPage* last)
+{
+   FIXPage* head = NULL;
+   do
+   {
+      head = parser->page;
+      last->next = head;
+   }
+   while(!fix_atomic_cas_ptr((void* volatile*)&parser->page, head, first));
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void fix_parser_push_groups(FIXParser* parser, FIXGroup* first, FIXGroup* last)
+{
+   FIXGroup* head = NULL;
+   do
+   {
+      head = parser->group;
+      last->next = head;
+   }
+   while(!fix_atomic_cas_ptr((void* volatile*)&parser->group, head, first));
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+// takes up to limit free pages from parser pool. Whole pool is taken, so there is no ABA problem, surplus is returned back
+static FIXPage* fix_parser_take_pages(FIXParser* parser, uint32_t limit, FIXPage** tail, uint32_t* count)
+{
+   FIXPage* first = (FIXPage*)fix_atomic_xchg_ptr((void* volatile*)&parser->page, NULL);
+   *tail = NULL;
+   *count = 0;
+   for(FIXPage* it = first; it && *count < limit; it = it->next)
+   {
+      *tail = it;
+      ++*count;
+   }
+   FIXPage* rest = *tail ? (*tail)->next : NULL;
+   if (rest)
+   {
+      (*tail)->next = NULL;
+      if (!fix_atomic_cas_ptr((void* volatile*)&parser->page, NULL, rest)) // pool is not empty already, append it
+      {
+         FIXPage* last = rest;
+         while(last->next)
+         {
+            last = last->next;
+         }
+         fix_parser_push_pages(parser, rest, last);
+      }
+   }
+   return first;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+// takes up to limit free groups from parser pool. Whole pool is taken, so there is no ABA problem, surplus is returned back
+static FIXGroup* fix_parser_take_groups(FIXParser* parser, uint32_t limit, FIXGroup** tail, uint32_t* count)
+{
+   FIXGroup* first = (FIXGroup*)fix_atomic_xchg_ptr((void* volatile*)&parser->group, NULL);
+   *tail = NULL;
+   *count = 0;
+   for(FIXGroup* it = first; it && *count < limit; it = it->next)
+   {
+      *tail = it;
+      ++*count;
+   }
+   FIXGroup* rest = *tail ? (*tail)->next : NULL;
+   if (rest)
+   {
+      (*tail)->next = NULL;
+      if (!fix_atomic_cas_ptr((void* volatile*)&parser->group, NULL, rest)) // pool is not empty already, append it
+      {
+         FIXGroup* last = rest;
+         while(last->next)
+         {
+            last = last->next;
+         }
+         fix_parser_push_groups(parser, rest, last);
+      }
+   }
+   return first;
+}
+
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIXPage* fix_parser_alloc_page(FIXParser* parser, uint32_t pageSize, FIXError** error)
 {
-   if (parser->attrs.maxPages > 0 && parser->attrs.maxPages == parser->used_pages)
+   if (!fix_parser_inc_used(&parser->used_pages, parser->attrs.maxPages))
    {
       *error = fix_error_create(
          FIX_ERROR_NO_MORE_PAGES, "No more pages available. MaxPages = %d, UsedPages = %d", parser->attrs.maxPages, parser->used_pages);
       return NULL;
    }
    FIXPage* page = NULL;
-   if (parser->page == NULL) // no more free pages
+   FIXPoolCache* cache = fix_parser_lock_cache(parser);
+   if (cache)
+   {
+      if (!cache->page) // refill cache from parser pool
+      {
+         cache->page = fix_parser_take_pages(parser, POOL_CACHE_LIMIT, &cache->page_tail, &cache->page_count);
+      }
+      page = cache->page;
+      if (page)
+      {
+         cache->page = page->next;
+         if (!cache->page)
+         {
+            cache->page_tail = NULL;
+         }
+         --cache->page_count;
+         page->next = NULL; // detach from pool of free pages
+      }
+      fix_parser_unlock_cache(cache);
+   }
+   else // cache is busy, take one page from parser pool
+   {
+      FIXPage* tail = NULL;
+      uint32_t count = 0;
+      page = fix_parser_take_pages(parser, 1, &tail, &count);
+   }
+   if (page == NULL) // no more free pages
    {
       uint32_t psize = (parser->attrs.pageSize > pageSize ? parser->attrs.pageSize : pageSize);
       if (parser->attrs.maxPageSize > 0 && psize > parser->attrs.maxPageSize)
       {
+         fix_atomic_dec((int32_t volatile*)&parser->used_pages);
          *error = fix_error_create(
                FIX_ERROR_TOO_BIG_PAGE, "Requested new page is too big. MaxPageSize = %d, RequestedPageSize = %d",
                parser->attrs.maxPageSize, psize);
@@ -34,13 +172,6 @@ FIXPage* fix_parser_alloc_page(FIXParser* parser, uint32_t pageSize, FIXError**
       page = (FIXPage*)calloc(1, sizeof(FIXPage) + psize - 1);
       page->size = psize;
    }
-   else
-   {
-      page = parser->page;
-      parser->page = page->next;
-      page->next = NULL; // detach from pool of free pages
-   }
-   ++parser->used_pages;
    return page;
 }
 
@@ -49,33 +180,77 @@ FIXPage* fix_parser_free_page(FIXParser* parser, FIXPage* page)
 {
    FIXPage* next = page->next;
    page->offset = 0;
-   page->next = parser->page;
-   parser->page = page;
-   --parser->used_pages;
+   FIXPoolCache* cache = fix_parser_lock_cache(parser);
+   if (cache)
+   {
+      page->next = cache->page;
+      if (!cache->page)
+      {
+         cache->page_tail = page;
+      }
+      cache->page = page;
+      if (++cache->page_count > POOL_CACHE_LIMIT) // return older half of cache to parser pool
+      {
+         FIXPage* last = cache->page;
+         for(uint32_t i = 1; i < POOL_CACHE_LIMIT / 2; ++i)
+         {
+            last = last->next;
+         }
+         fix_parser_push_pages(parser, last->next, cache->page_tail);
+         last->next = NULL;
+         cache->page_tail = last;
+         cache->page_count = POOL_CACHE_LIMIT / 2;
+      }
+      fix_parser_unlock_cache(cache);
+   }
+   else
+   {
+      fix_parser_push_pages(parser, page, page);
+   }
+   fix_atomic_dec((int32_t volatile*)&parser->used_pages);
    return next;
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIXGroup* fix_parser_alloc_group(FIXParser* parser, FIXError** error)
 {
-   if (parser->attrs.maxGroups > 0 && parser->attrs.maxGroups == parser->used_groups)
+   if (!fix_parser_inc_used(&parser->used_groups, parser->attrs.maxGroups))
    {
       *error = fix_error_create(FIX_ERROR_NO_MORE_GROUPS,
          "No more groups available. MaxGroups = %d, UsedGroups = %d", parser->attrs.maxGroups, parser->used_groups);
       return NULL;
    }
    FIXGroup* group = NULL;
-   if (parser->group == NULL) // no more free group
+   FIXPoolCache* cache = fix_parser_lock_cache(parser);
+   if (cache)
    {
-      group = (FIXGroup*)calloc(1, sizeof(FIXGroup));
+      if (!cache->group) // refill cache from parser pool
+      {
+         cache->group = fix_parser_take_groups(parser, POOL_CACHE_LIMIT, &cache->group_tail, &cache->group_count);
+      }
+      group = cache->group;
+      if (group)
+      {
+         cache->group = group->next;
+         if (!cache->group)
+         {
+            cache->group_tail = NULL;
+         }
+         --cache->group_count;
+         group->next = NULL; // detach from pool
+      }
+      fix_parser_unlock_cache(cache);
    }
-   else
+   else // cache is busy, take one group from parser pool
    {
-      group = parser->group;
-      parser->group = group->next;
-      group->next = NULL; // detach from pool
+      FIXGroup* tail = NULL;
+      uint32_t count = 0;
+      group = fix_parser_take_groups(parser, 1, &tail, &count);
+   }
+   if (group == NULL) // no more free group
+   {
+      group = (FIXGroup*)calloc(1, sizeof(FIXGroup));
    }
-   ++parser->used_groups;
    return group;
 }
 
@@ -84,9 +259,34 @@ FIXGroup* fix_parser_free_group(FIXParser* parser, FIXGroup* group)
 {
    FIXGroup* next = group->next;
    memset(group, 0, sizeof(FIXGroup));
-   group->next = parser->group;
-   parser->group = group;
-   --parser->used_groups;
+   FIXPoolCache* cache = fix_parser_lock_cache(parser);
+   if (cache)
+   {
+      group->next = cache->group;
+      if (!cache->group)
+      {
+         cache->group_tail = group;
+      }
+      cache->group = group;
+      if (++cache->group_count > POOL_CACHE_LIMIT) // return older half of cache to parser pool
+      {
+         FIXGroup* last = cache->group;
+         for(uint32_t i = 1; i < POOL_CACHE_LIMIT / 2; ++i)
+         {
+            last = last->next;
+         }
+         fix_parser_push_groups(parser, last->next, cache->group_tail);
+         last->next = NULL;
+         cache->group_tail = last;
+         cache->group_count = POOL_CACHE_LIMIT / 2;
+      }
+      fix_parser_unlock_cache(cache);
+   }
+   else
+   {
+      fix_parser_push_groups(parser, group, group);
+   }
+   fix_atomic_dec((int32_t volatile*)&parser->used_groups);
    return next;
 }
 
@@ -105,6 +305,10 @@ int32_t fix_parser_validate_attrs(FIXParserAttrs* attrs, FIXError** error)
    {
       attrs->numGroups = 1000;
    }
+   if (!attrs->maxMsgSize)
+   {
+      attrs->maxMsgSize = 1024 * 1024;
+   }
    if (attrs->maxPageSize > 0 && attrs->maxPageSize < attrs->pageSize)
    {
       *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "ERROR: Parser attbutes are invalid: MaxPageSize < PageSize.");
@@ -164,61 +368,15 @@ FIXErrCode fix_parser_check_value(FIXFieldDescr const* fdescr, char const* dbegi
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
-static FIXErrCode fix_parser_parse_value(FIXMsg* msg, FIXGroup* group, FIXFieldDescr const* fdescr,
-      char const* dbegin, uint32_t len, char delimiter, char const** dend, FIXError** error)
-{
-   *dend = dbegin;
-   if (msg && fdescr && fdescr->type->valueType == FIXFieldValueType_Data) // Data field
-   {
-      int32_t dataLength;
-      int32_t err = fix_msg_get_int32(msg, group, fdescr->dataLenField->type->tag, &dataLength, error);
-      if (err < 0)
-      {
-         *error = fix_error_create(err, "Unable to get length field '%d'.", fdescr->dataLenField->type->tag);
-         return FIX_FAILED;
-      }
-      *dend = dbegin + dataLength;
-   }
-   else // get value till delimiter
-   {
-      for(;len > 0; --len)
-      {
-         if (**dend == delimiter)
-         {
-            break;
-         }
-         else
-         {
-            ++(*dend);
-         }
-      }
-      if (!len)
-      {
-         *error = fix_error_create(FIX_ERROR_NO_MORE_DATA, "Field value must be terminated with '%c' delimiter.", delimiter);
-         return FIX_FAILED;
-      }
-   }
-   return FIX_SUCCESS;
-}
-
-/*------------------------------------------------------------------------------------------------------------------------*/
-static FIXTagNum fix_parser_parse_tag(
-      FIXMsg* msg, FIXGroup* group, char const* data, uint32_t len, FIXTagNum* tag, FIXFieldDescr const** fdescr,
-      char const** dbegin, FIXError** error)
+static FIXErrCode fix_parser_parse_value(char const* dbegin, uint32_t len, char delimiter, char const** dend, FIXError** error)
 {
-   int32_t cnt;
-   FIXErrCode res = fix_utils_atoi32(data, len, '=', tag, &cnt);
-   if (res < 0)
+   *dend = fix_utils_find_char(dbegin, len, delimiter);
+   if (!*dend)
    {
-      *error = fix_error_create(res, "Unable to extract field number.");
+      *dend = dbegin + len;
+      *error = fix_error_create(FIX_ERROR_NO_MORE_DATA, "Field value must be terminated with '%c' delimiter.", delimiter);
       return FIX_FAILED;
    }
-   *dbegin = data + cnt + 1;
-   if (fdescr)
-   {
-      *fdescr = group ? fix_protocol_get_group_descr(group->parent_fdescr, *tag)
-         : fix_protocol_get_field_descr(msg->descr, *tag);
-   }
    return FIX_SUCCESS;
 }
 
@@ -227,11 +385,15 @@ FIXTagNum fix_parser_parse_mandatory_field(
       char const* data, uint32_t len, char delimiter, char const** dbegin, char const** dend, FIXError** error)
 {
    FIXTagNum tag = 0;
-   if(FIX_FAILED == fix_parser_parse_tag(NULL, NULL, data, len, &tag, NULL, dbegin, error))
+   int32_t cnt;
+   FIXErrCode res = fix_utils_atoi32(data, len, '=', &tag, &cnt);
+   if (res < 0)
    {
+      *error = fix_error_create(res, "Unable to extract field number.");
       return FIX_FAILED;
    }
-   if (FIX_FAILED == fix_parser_parse_value(NULL, NULL, NULL, *dbegin, len - (*dbegin - data) , delimiter, dend, error))
+   *dbegin = data + cnt + 1;
+   if (FIX_FAILED == fix_parser_parse_value(*dbegin, len - (*dbegin - data), delimiter, dend, error))
    {
       return FIX_FAILED;
    }
@@ -239,73 +401,68 @@ FIXTagNum fix_parser_parse_mandatory_field(
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
-FIXTagNum fix_parser_parse_field(
-      FIXParser* parser, FIXMsg* msg, FIXGroup* group, char const* data, uint32_t len, char delimiter, FIXFieldDescr const** fdescr,
-      char const** dbegin, char const** dend, FIXError** error)
+static FIXErrCode fix_parser_set_value(FIXParser* parser, FIXMsg* msg, FIXGroup* group, FIXFieldDescr const* fdescr,
+      char const* data, FIXFieldIndex const** it, FIXFieldIndex const* end, char delimiter, FIXError** error)
 {
-   FIXTagNum tag = 0;
-   if (FIX_FAILED == fix_parser_parse_tag(msg, group, data, len, &tag, fdescr, dbegin, error))
-   {
-      return FIX_FAILED;
-   }
-   if (!(*fdescr))
+   FIXFieldIndex const* field = (*it)++;
+   char const* dbegin = data + field->offset;
+   if (parser->flags & PARSER_FLAG_CHECK_VALUE)
    {
-      if (parser->flags & PARSER_FLAG_CHECK_UNKNOWN_FIELDS)
+      if (fix_parser_check_value(fdescr, dbegin, dbegin + field->len, delimiter, error) == FIX_FAILED)
       {
-         *error = fix_error_create(FIX_ERROR_UNKNOWN_FIELD, "Field '%d' not found in description.", tag);
          return FIX_FAILED;
       }
-      else // just skip field value
+   }
+   if (fdescr->category == FIXFieldCategory_Value)
+   {
+      FIXField* fld = (parser->flags & PARSER_FLAG_ZERO_COPY)
+         ? fix_field_set_ref(msg, group, fdescr, dbegin, field->len, error)
+         : fix_field_set(msg, group, fdescr, (unsigned char*)dbegin, field->len, error);
+      if (!fld)
       {
-         if (FIX_FAILED == fix_parser_parse_value(NULL, NULL, NULL, *dbegin, len - (*dbegin - data), delimiter, dend, error))
-         {
-            return FIX_FAILED;
-         }
+         return FIX_FAILED;
       }
    }
-   if (FIX_FAILED == fix_parser_parse_value(msg, group, *fdescr, *dbegin, len - (*dbegin - data), delimiter, dend, error))
+   else if (fdescr->category == FIXFieldCategory_Group)
    {
-      return FIX_FAILED;
+      int64_t numGroups = 0;
+      int32_t cnt;
+      FIXErrCode err = fix_utils_atoi64(dbegin, field->len, 0, &numGroups, &cnt);
+      if (err < 0)
+      {
+         *error = fix_error_create(err, "Unable to get group tag %d value.", field->tag);
+         return FIX_FAILED;
+      }
+      if (FIX_FAILED == fix_parser_parse_group(parser, msg, group, fdescr, numGroups, data, it, end, delimiter, error))
+      {
+         return FIX_FAILED;
+      }
    }
-   return tag;
+   return FIX_SUCCESS;
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIXErrCode fix_parser_parse_group(
       FIXParser* parser, FIXMsg* msg, FIXGroup* parentGroup, FIXFieldDescr const* gdescr, int64_t numGroups, char const* data,
-      char const* bodyEnd, char delimiter, char const** stop, FIXError** error)
+      FIXFieldIndex const** it, FIXFieldIndex const* end, char delimiter, FIXError** error)
 {
    FIXFieldDescr* first_req_field = &gdescr->group[0]; // first required field MUST be present in string
    FIXGroup* group = NULL;
    int32_t groupCount = 0;
-   *stop = data;
-   while(numGroups && bodyEnd != *stop) // if number of groups = 0, nothing to do
+   while(numGroups && *it != end) // if number of groups = 0, nothing to do
    {
-      FIXTagNum tag = 0;
-      char const* dbegin = NULL;
+      FIXTagNum const tag = (*it)->tag;
       FIXFieldDescr const* fdescr = NULL;
-      if(FIX_FAILED == fix_parser_parse_tag(NULL, NULL, *stop + 1, bodyEnd - *stop, &tag, NULL, &dbegin, error))
-      {
-         return FIX_FAILED;
-      }
       if (tag == first_req_field->type->tag) // start of new group
       {
-         if (group && (parser->flags & PARSER_FLAG_CHECK_REQUIRED)) // previous group has already parsed, check it if needed
+         // previous group has already parsed, check it if needed
+         int32_t const missing = (group && (parser->flags & PARSER_FLAG_CHECK_REQUIRED)) ? fix_field_get_missing(msg, group, 0) : -1;
+         if (missing >= 0)
          {
-            for(uint32_t i = 0; i < gdescr->group_count; ++i)
-            {
-               FIXFieldDescr* fdescr = &gdescr->group[i];
-               if (fdescr->flags & FIELD_FLAG_REQUIRED)
-               {
-                  if (!fix_field_get(msg, group, fdescr->type->tag))
-                  {
-                     *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND,
-                           "Required field '%s' not found in group '%s'.",
-                           fdescr->type->name, group->parent_fdescr->type->name);
-                     return FIX_FAILED;
-                  }
-               }
-            }
+            *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND,
+                  "Required field '%s' not found in group '%s'.",
+                  gdescr->group[missing].type->name, group->parent_fdescr->type->name);
+            return FIX_FAILED;
          }
          group = fix_msg_add_group(msg, parentGroup, gdescr->type->tag, error);
          if (!group)
@@ -317,7 +474,7 @@ FIXErrCode fix_parser_parse_group(
       }
       else
       {
-         fdescr = fix_protocol_get_group_descr(group->parent_fdescr, tag);
+         fdescr = group ? fix_protocol_get_group_descr(group->parent_fdescr, tag) : NULL;
          if (!fdescr)
          {
             if (groupCount == numGroups) // looks like we finished
@@ -332,40 +489,282 @@ FIXErrCode fix_parser_parse_group(
             }
          }
       }
-      if (FIX_FAILED == fix_parser_parse_value(msg, group, fdescr, dbegin, bodyEnd - dbegin + 1, delimiter, stop, error))
+      if (FIX_FAILED == fix_parser_set_value(parser, msg, group, fdescr, data, it, end, delimiter, error))
       {
          return FIX_FAILED;
       }
-      if (parser->flags & PARSER_FLAG_CHECK_VALUE)
+   }
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXErrCode fix_parser_skip_group(FIXFieldDescr const* gdescr, int64_t numGroups, char const* data,
+      FIXFieldIndex const** it, FIXFieldIndex const* end, FIXError** error)
+{
+   FIXFieldDescr const* first_req_field = &gdescr->group[0]; // first required field MUST be present in string
+   int64_t groupCount = 0;
+   while(numGroups && *it != end)
+   {
+      FIXTagNum const tag = (*it)->tag;
+      FIXFieldDescr const* fdescr = NULL;
+      if (tag == first_req_field->type->tag) // start of new group
+      {
+         ++groupCount;
+         fdescr = first_req_field;
+      }
+      else
       {
-         if (fix_parser_check_value(fdescr, dbegin, *stop, delimiter, error) == FIX_FAILED)
+         fdescr = groupCount ? fix_protocol_get_group_descr(gdescr, tag) : NULL;
+         if (!fdescr)
          {
+            if (groupCount == numGroups) // looks like we finished
+            {
+               return FIX_SUCCESS;
+            }
+            *error = fix_error_create(
+                  FIX_ERROR_UNKNOWN_FIELD, "Field '%d' not found in group '%s' description.", tag, gdescr->type->name);
             return FIX_FAILED;
          }
       }
-      if (fdescr->category == FIXFieldCategory_Value)
+      FIXFieldIndex const* field = (*it)++;
+      if (fdescr->category == FIXFieldCategory_Group)
+      {
+         int64_t nestedGroups = 0;
+         int32_t cnt;
+         FIXErrCode err = fix_utils_atoi64(data + field->offset, field->len, 0, &nestedGroups, &cnt);
+         if (err < 0)
+         {
+            *error = fix_error_create(err, "Unable to get group tag %d value.", tag);
+            return FIX_FAILED;
+         }
+         if (FIX_FAILED == fix_parser_skip_group(fdescr, nestedGroups, data, it, end, error))
+         {
+            return FIX_FAILED;
+         }
+      }
+   }
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode fix_parser_lazy_index(FIXParser* parser, FIXMsg* msg, char const* data, FIXFieldIndex const* index,
+      uint32_t count, char delimiter, FIXError** error)
+{
+   uint32_t const descr_count = msg->descr->field_count;
+   uint32_t const field_count = count < descr_count ? count : descr_count; // repeated field takes the same lazy field
+   FIXMsgLazy* lazy = (FIXMsgLazy*)fix_msg_alloc(msg, sizeof(FIXMsgLazy) + sizeof(FIXLazyField) * field_count, error);
+   if (!lazy)
+   {
+      return FIX_FAILED;
+   }
+   FIXFieldIndex* lindex = (FIXFieldIndex*)fix_msg_alloc(msg, sizeof(FIXFieldIndex) * count, error);
+   if (!lindex)
+   {
+      return FIX_FAILED;
+   }
+   uint32_t const words = REQUIRED_WORDS(descr_count);
+   char* buff = (char*)fix_msg_alloc(msg, (words + 1) * sizeof(uint64_t) + descr_count * sizeof(uint16_t), error);
+   if (!buff)
+   {
+      return FIX_FAILED;
+   }
+   memcpy(lindex, index, sizeof(FIXFieldIndex) * count);
+   lazy->data = data;
+   lazy->index = lindex;
+   lazy->present = (uint64_t*)(((uintptr_t)buff + sizeof(uint64_t) - 1) & ~(uintptr_t)(sizeof(uint64_t) - 1));
+   lazy->slots = (uint16_t*)(lazy->present + words);
+   memset(lazy->present, 0, words * sizeof(uint64_t) + descr_count * sizeof(uint16_t));
+   lazy->delimiter = delimiter;
+   lazy->field_count = 0;
+   FIXFieldIndex const* it = &lindex[3]; // BeginString, BodyLength and MsgType are already parsed
+   FIXFieldIndex const* end = &lindex[count - 1];
+   while(it != end)
+   {
+      FIXFieldDescr const* fdescr = fix_protocol_get_field_descr(msg->descr, it->tag);
+      if (!fdescr)
       {
-         if (!fix_field_set(msg, group, fdescr, (unsigned char*)dbegin, *stop - dbegin, error))
+         if (parser->flags & PARSER_FLAG_CHECK_UNKNOWN_FIELDS)
          {
+            *error = fix_error_create(FIX_ERROR_UNKNOWN_FIELD, "Field '%d' not found in description.", it->tag);
             return FIX_FAILED;
          }
+         ++it; // just skip field value
+         continue;
+      }
+      uint32_t const slot = fdescr - msg->descr->fields;
+      if (!lazy->slots[slot])
+      {
+         lazy->slots[slot] = ++lazy->field_count;
+         lazy->present[slot / 64] |= 1ULL << (slot % 64);
       }
-      else if (fdescr->category == FIXFieldCategory_Group)
+      FIXLazyField* field = &lazy->fields[lazy->slots[slot] - 1]; // the last of repeated fields wins, as in full parsing
+      field->descr = fdescr;
+      field->begin = it - lindex;
+      FIXFieldIndex const* fld = it++;
+      if (fdescr->category == FIXFieldCategory_Group)
       {
-         int32_t numGroups = 0;
+         int64_t numGroups = 0;
          int32_t cnt;
-         FIXErrCode err = fix_utils_atoi32(dbegin, *stop - dbegin, delimiter, &numGroups, &cnt);
+         FIXErrCode err = fix_utils_atoi64(data + fld->offset, fld->len, 0, &numGroups, &cnt);
          if (err < 0)
          {
-            *error = fix_error_create(err, "Unable to get group tag %d value.", tag);
+            *error = fix_error_create(err, "Unable to get group tag %d value.", fld->tag);
             return FIX_FAILED;
          }
-         err = fix_parser_parse_group(parser, msg, group, fdescr, numGroups, *stop, bodyEnd, delimiter, stop, error);
-         if (err == FIX_FAILED)
+         if (FIX_FAILED == fix_parser_skip_group(fdescr, numGroups, data, &it, end, error))
          {
             return FIX_FAILED;
          }
       }
+      field->end = it - lindex;
    }
+   msg->lazy = lazy;
    return FIX_SUCCESS;
 }
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode fix_parser_lazy_parse(FIXMsg* msg, FIXLazyField* field, FIXError** error)
+{
+   FIXMsgLazy* lazy = msg->lazy;
+   FIXFieldDescr const* fdescr = field->descr;
+   FIXFieldIndex const* it = &lazy->index[field->begin];
+   field->descr = NULL;
+   msg->lazy = NULL; // message is changed by parser, so don't trigger full parsing
+   FIXErrCode res = fix_parser_set_value(
+         msg->parser, msg, NULL, fdescr, lazy->data, &it, &lazy->index[field->end], lazy->delimiter, error);
+   msg->lazy = lazy;
+   return res;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXErrCode fix_parser_lazy_get(FIXMsg* msg, FIXTagNum tag, FIXError** error)
+{
+   if (fix_field_get(msg, NULL, tag))
+   {
+      return FIX_SUCCESS;
+   }
+   FIXFieldDescr const* fdescr = fix_protocol_get_field_descr(msg->descr, tag);
+   uint16_t const idx = fdescr ? msg->lazy->slots[fdescr - msg->descr->fields] : 0;
+   FIXLazyField* field = idx ? &msg->lazy->fields[idx - 1] : NULL;
+   if (field && field->descr)
+   {
+      return fix_parser_lazy_parse(msg, field, error);
+   }
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXErrCode fix_parser_lazy_parse_all(FIXMsg* msg, FIXError** error)
+{
+   FIXMsgLazy* lazy = msg->lazy;
+   for(uint32_t i = 0; i < lazy->field_count; ++i)
+   {
+      FIXLazyField* field = &lazy->fields[i];
+      if (field->descr && FIX_FAILED == fix_parser_lazy_parse(msg, field, error))
+      {
+         return FIX_FAILED;
+      }
+   }
+   msg->lazy = NULL;
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXMsg* fix_parser_index_to_msg(FIXParser* parser, char const* data, FIXFieldIndex const* index, uint32_t count, int32_t checkSum,
+      char delimiter, FIXError** error)
+{
+   int32_t cnt;
+   FIXFieldIndex const* crcField = &index[count - 1];
+   if (parser->flags & PARSER_FLAG_CHECK_CRC)
+   {
+      int32_t check_sum = 0;
+      if (fix_utils_atoi32(data + crcField->offset, crcField->len, 0, &check_sum, &cnt) < 0)
+      {
+         *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "CheckSum value not a number.");
+         return NULL;
+      }
+      if (checkSum != check_sum)
+      {
+         *error = fix_error_create(
+               FIX_ERROR_INTEGRITY_CHECK, "CheckSum check failed. Expected '%d', actual '%d'.", check_sum, checkSum);
+         return NULL;
+      }
+   }
+   FIXFieldIndex const* it = &index[2];
+   if (it->tag != FIXFieldTag_MsgType)
+   {
+      *error = fix_error_create(FIX_ERROR_WRONG_FIELD, "Field is '%d', but must be MsgType.", it->tag);
+      return NULL;
+   }
+   char* msgType = (char*)calloc(it->len + 1, 1);
+   memcpy(msgType, data + it->offset, it->len);
+   FIXMsg* msg = fix_msg_create(parser, msgType, error);
+   free(msgType);
+   if (!msg)
+   {
+      return NULL;
+   }
+   FIXFieldDescr const* fdescr = NULL;
+   int32_t bodyLen = 0;
+   fix_utils_atoi32(data + index[1].offset, index[1].len, 0, &bodyLen, &cnt); // already validated by fix_parser_index
+   if (fix_msg_set_int32(msg, NULL, FIXFieldTag_BodyLength, bodyLen, error) != FIX_SUCCESS)
+   {
+      goto error;
+   }
+   fdescr = fix_protocol_get_field_descr(msg->descr, FIXFieldTag_CheckSum);
+   if (!fdescr)
+   {
+      *error = fix_error_create(FIX_ERROR_UNKNOWN_FIELD, "Field with tag %d not found in message '%s' description.",
+            FIXFieldTag_CheckSum, msg->descr->name);
+      goto error;
+   }
+   if (!fix_field_set(msg, NULL, fdescr, (unsigned char*)data + crcField->offset, crcField->len, error))
+   {
+      goto error;
+   }
+   ++it;
+   if (parser->flags & PARSER_FLAG_LAZY)
+   {
+      if (FIX_FAILED == fix_parser_lazy_index(parser, msg, data, index, count, delimiter, error))
+      {
+         goto error;
+      }
+      it = crcField;
+   }
+   while(it != crcField)
+   {
+      fdescr = fix_protocol_get_field_descr(msg->descr, it->tag);
+      if (!fdescr)
+      {
+         if (parser->flags & PARSER_FLAG_CHECK_UNKNOWN_FIELDS)
+         {
+            *error = fix_error_create(FIX_ERROR_UNKNOWN_FIELD, "Field '%d' not found in description.", it->tag);
+            goto error;
+         }
+         ++it; // just skip field value
+      }
+      else if (FIX_FAILED == fix_parser_set_value(parser, msg, NULL, fdescr, data, &it, crcField, delimiter, error))
+      {
+         goto error;
+      }
+   }
+   if (parser->flags & PARSER_FLAG_CHECK_REQUIRED)
+   {
+      FIXGroup* group = msg->fields;
+      for(uint32_t i = 0; msg->lazy && group->present && i < REQUIRED_WORDS(msg->descr->field_count); ++i)
+      {
+         group->present[i] |= msg->lazy->present[i]; // lazy fields are not parsed yet, but they are in message
+      }
+      int32_t const missing = fix_field_get_missing(msg, NULL, 0);
+      if (missing >= 0)
+      {
+         *error = fix_error_create(
+               FIX_ERROR_UNKNOWN_FIELD, "Required field '%s' not found.", msg->descr->fields[missing].type->name);
+         goto error;
+      }
+   }
+   return msg;
+error:
+   fix_msg_free(msg);
+   return NULL;
+}
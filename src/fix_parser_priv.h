@@ -20,6 +20,35 @@ extern "C"
 {
 #endif
 
+#define CRC_FIELD_LEN 7 ///< length of CheckSum field including delimiter, e.g. '10=123|'
+#define INDEX_LEN_FIELDS 8 ///< count of last Length fields, remembered by fix_parser_index to bound Data fields
+#define POOL_CACHE_COUNT 16 ///< count of per-thread caches of free pages and groups
+#define POOL_CACHE_LIMIT 64 ///< max count of free pages (groups) in cache. Above it they are returned to parser pool
+#define CACHE_LINE_SIZE 64 ///< size of CPU cache line. Each pool cache occupies its own line to avoid false sharing
+
+/**
+ * cache of free pages and groups. Used by one thread at time, see fix_parser_lock_cache
+ */
+typedef struct FIXPoolCache_
+{
+   int32_t volatile lock;              ///< 1 - cache is used by some thread
+   uint32_t page_count;                ///< count of pages in cache
+   FIXPage* page;                      ///< free pages
+   FIXPage* page_tail;                 ///< last free page
+   uint32_t group_count;               ///< count of groups in cache
+   FIXGroup* group;                    ///< free groups
+   FIXGroup* group_tail;               ///< last free group
+} FIXPoolCache;
+
+/**
+ * pool cache padded to CACHE_LINE_SIZE
+ */
+typedef union FIXPoolCacheLine_
+{
+   FIXPoolCache cache;                 ///< pool cache
+   char pad[CACHE_LINE_SIZE];          ///< padding
+} FIXPoolCacheLine;
+
 /**
  * FIX parser data
  */
@@ -28,10 +57,37 @@ struct FIXParser_
    FIXProtocolDescr const* protocol;   ///< FIX protocol
    FIXParserAttrs attrs;               ///< attributes
    int32_t  flags;                     ///< flags
-   FIXPage* page;                      ///< list of allocated memory pages
-   uint32_t used_pages;                ///< count of memory pages in use
-   FIXGroup* group;                    ///< allocated FIX groups
-   uint32_t used_groups;               ///< count of used groups
+   FIXPage* volatile page;             ///< lock-free pool of free memory pages, shared by all threads
+   uint32_t volatile used_pages;       ///< count of memory pages in use
+   FIXGroup* volatile group;           ///< lock-free pool of free FIX groups, shared by all threads
+   uint32_t volatile used_groups;      ///< count of used groups
+   FIXPoolCacheLine* cache;            ///< per-thread caches of free pages and groups, aligned to CACHE_LINE_SIZE
+   FIXPoolCacheLine cache_buff[POOL_CACHE_COUNT + 1]; ///< storage of caches, extra line is reserved for alignment
+   FIXFieldIndex* index;               ///< message index used by fix_parser_str_to_msg
+   uint32_t index_size;                ///< count of entries in index
+   int32_t volatile index_lock;        ///< 1 - index is used by some thread
+};
+
+/**
+ * FIX stream parser data. Current message consists of buff data followed by chunk[msg_begin, chunk_pos)
+ */
+struct FIXStreamParser_
+{
+   FIXParser* parser;                  ///< parser of complete messages
+   char delimiter;                     ///< FIX field SOH
+   char* buff;                         ///< beginning of current message, received with previous chunks
+   uint32_t buff_size;                 ///< allocated size of buff
+   uint32_t buff_len;                  ///< count of bytes in buff
+   char const* chunk;                  ///< current data chunk
+   uint32_t chunk_len;                 ///< length of current data chunk
+   uint32_t chunk_pos;                 ///< count of processed bytes of current chunk
+   uint32_t msg_begin;                 ///< position of current message in chunk, if message began in this chunk
+   uint32_t msg_len;                   ///< length of current message. 0 - message header is not received yet
+   uint32_t hdr_len;                   ///< count of processed bytes of message header
+   uint32_t field_pos;                 ///< position in current header field
+   uint32_t field;                     ///< current header field. 0 - BeginString, 1 - BodyLength
+   uint32_t body_len;                  ///< BodyLength value
+   int32_t skip;                       ///< skip data till next delimiter after header error
 };
 
 /**
@@ -44,7 +100,7 @@ struct FIXParser_
 FIXPage* fix_parser_alloc_page(FIXParser* parser, uint32_t pageSize, FIXError** error);
 
 /**
- * free allocated page
+ * free allocated page. Page may be freed by any thread, not only by one, which allocated it
  * @param[in] parser - page holder
  * @param[in] page - deallocated page
  * @return next used page or NULL if no more pages are used
@@ -60,7 +116,7 @@ FIXPage* fix_parser_free_page(FIXParser* parser, FIXPage* page);
 FIXGroup* fix_parser_alloc_group(FIXParser* parser, FIXError** error);
 
 /**
- * free allocated group
+ * free allocated group. Group may be freed by any thread, not only by one, which allocated it
  * @param[in] parser - group holder
  * @param[in] group - deallocated group
  * @return next used group or NULL
@@ -80,24 +136,6 @@ FIXGroup* fix_parser_free_group(FIXParser* parser, FIXGroup* group);
 FIXTagNum fix_parser_parse_mandatory_field(
       char const* data, uint32_t len, char delimiter, char const** dbegin, char const** dend, FIXError** error);
 
-/**
- * parser string with FIX field
- * @param[in] parser - FIX parser
- * @param[in] msg - FIX message, which will hold parsed field
- * @param[in] group - FIX group, which will hold parsed field. Can be NULL
- * @param[in] data - string to parser
- * @param[in] len - length of data
- * @param[in] delimiter - FIX field SOH
- * @param[out] fdescr - description of field
- * @param[out] dbegin - points to begin of field value
- * @param[out] dend - points to end of field value
- * @param[out] error - error description
- * @return FIX field tag number or FIX_FAILED
- */
-FIXTagNum fix_parser_parse_field(
-      FIXParser* parser, FIXMsg* msg, FIXGroup* group, char const* data, uint32_t len, char delimiter, FIXFieldDescr const** fdescr,
-      char const** dbegin, char const** dend, FIXError** error);
-
 /**
  * validate parser attributes
  * @param[in] attrs - attributes to validate
@@ -129,19 +167,65 @@ FIXErrCode fix_parser_get_value(char const* dbegin, uint32_t len, char delimiter
 FIXErrCode fix_parser_check_value(FIXFieldDescr const* fdescr, char const* dbegin, char const* dend, char delimiter, FIXError** error);
 
 /**
- * parse string with group
+ * parse indexed group entries
  * @param[in] parser - FIX parser
  * @param[in] msg - FIX message, which will hold parsed group
  * @param[in] parentGroup - FIX group, which will hold nested group
  * @param[in] gdescr - FIX group description
- * @param[in] data - string to parser
- * @param[in] bodyEnd - end of data t parse
- * @param[out] stop - parse stop pointer
+ * @param[in] numGroups - number of group entries
+ * @param[in] data - message data, index offsets are relative to it
+ * @param[in,out] it - first index entry of group. On return points to the first entry after group
+ * @param[in] end - end of index entries
+ * @param[in] delimiter - FIX field SOH
  * @param[out] error - error description
  * @return FIX_SUCCESS - ok, FIX_FAILED - error
  */
 FIXErrCode fix_parser_parse_group(FIXParser* parser, FIXMsg* msg, FIXGroup* parentGroup, FIXFieldDescr const* gdescr, int64_t numGroups,
-      char const* data, char const* bodyEnd, char delimiter, char const** stop, FIXError** error);
+      char const* data, FIXFieldIndex const** it, FIXFieldIndex const* end, char delimiter, FIXError** error);
+
+/**
+ * create FIX message from message index
+ * @param[in] parser - FIX parser
+ * @param[in] data - message data, index offsets are relative to it
+ * @param[in] index - message index, see fix_parser_index
+ * @param[in] count - count of index entries
+ * @param[in] checkSum - calculated message CheckSum
+ * @param[in] delimiter - FIX field SOH
+ * @param[out] error - error description
+ * @return new message, NULL - see error description
+ */
+FIXMsg* fix_parser_index_to_msg(FIXParser* parser, char const* data, FIXFieldIndex const* index, uint32_t count, int32_t checkSum,
+      char delimiter, FIXError** error);
+
+/**
+ * skip indexed group entries without parsing them
+ * @param[in] gdescr - FIX group description
+ * @param[in] numGroups - number of group entries
+ * @param[in] data - message data, index offsets are relative to it
+ * @param[in,out] it - first index entry of group. On return points to the first entry after group
+ * @param[in] end - end of index entries
+ * @param[out] error - error description
+ * @return FIX_SUCCESS - ok, FIX_FAILED - error
+ */
+FIXErrCode fix_parser_skip_group(FIXFieldDescr const* gdescr, int64_t numGroups, char const* data,
+      FIXFieldIndex const** it, FIXFieldIndex const* end, FIXError** error);
+
+/**
+ * parse not parsed top-level field of lazy message
+ * @param[in] msg - FIX message, created with PARSER_FLAG_LAZY
+ * @param[in] tag - tag of field
+ * @param[out] error - error description
+ * @return FIX_SUCCESS - ok (field is parsed or not found), FIX_FAILED - error
+ */
+FIXErrCode fix_parser_lazy_get(FIXMsg* msg, FIXTagNum tag, FIXError** error);
+
+/**
+ * parse all not parsed fields of lazy message. After that message becomes usual one
+ * @param[in] msg - FIX message, created with PARSER_FLAG_LAZY
+ * @param[out] error - error description
+ * @return FIX_SUCCESS - ok, FIX_FAILED - error
+ */
+FIXErrCode fix_parser_lazy_parse_all(FIXMsg* msg, FIXError** error);
 
 #ifdef __cplusplus
 }
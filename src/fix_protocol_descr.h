@@ -7,6 +7,7 @@
 #ifndef FIX_PARSER_FIX_PROTOCOL_DESCR_H
 #define FIX_PARSER_FIX_PROTOCOL_DESCR_H
 
+#include "fix_protocol_tables.h"
 #include "fix_types.h"
 #include "fix_error.h"
 
@@ -19,79 +20,74 @@ extern "C"
 {
 #endif
 
-#define FIELD_VALUE_CNT 20
-#define FIELD_TYPE_CNT 1000
-#define FIELD_DESCR_CNT 100
-#define MSG_CNT   100
-#define FIELD_FLAG_REQUIRED 0x01
+#define FIELD_VALUE_TABLE_MAX 0x10000
+#define REQUIRED_WORDS(count) (((count) + 63) / 64) ///< count of words in bitmap of required fields
 
 /**
- * FIX field possible value
+ * parse protocol xml file and create protocol description
+ * @param[in] file - protocol xml file
+ * @param[out] error - in case of parse error, this error is set
  */
-typedef struct FIXFieldValue_
-{
-   char const* value;               ///< field value
-   struct FIXFieldValue_* next;     ///< next field value
-} FIXFieldValue;
+FIXProtocolDescr const* fix_protocol_descr_create(char const* file, FIXError** error);
 
 /**
- * description of FIX field type (entry in dictionary types)
+ * load protocol description from binary image, created by fix_protocol_descr_save_image. Image is mapped read-only, so
+ * its pages are shared by all processes, which load it. Strings of description refer to the image
+ * @param[in] file - image file
+ * @param[out] error - in case of load error, this error is set
  */
-typedef struct FIXFieldType_
-{
-   FIXTagNum tag;                   ///< tag number
-   FIXFieldValueTypeEnum valueType; ///< type of field (string, number, length, etc)
-   char* name;                      ///< textual representation of field
-   FIXFieldValue** values;          ///< hash table with possible field values
-   struct FIXFieldType_* next;      ///< next type in chain
-} FIXFieldType;
+FIXProtocolDescr const* fix_protocol_descr_load_image(char const* file, FIXError** error);
 
 /**
- * descrion of FIX field
+ * save protocol description (with its transport protocol) as relocatable binary image
+ * @param[in] prot - protocol description
+ * @param[in] file - image file
+ * @param[out] error - in case of error, this error is set
+ * @return FIX_SUCCESS - ok, FIX_FAILED - see error description
  */
-typedef struct FIXFieldDescr_
-{
-   FIXFieldType* type;                  ///< type of FIX field
-   FIXFieldCategoryEnum category;       ///< category - value or group
-   uint8_t flags;                       ///< only FIELD_FLAG_REQUIRED is used
-   uint32_t group_count;                ///< count of field descriptions in group
-   struct FIXFieldDescr_*  group;       ///< all field descriptions indexed as array
-   struct FIXFieldDescr_** group_index; ///< hash table with field descriptions
-   struct FIXFieldDescr_*  next;        ///< next field description in hash table
-   struct FIXFieldDescr_*  dataLenField; ///< reference to field description. Not NULL if this field has valueType == Data.
-} FIXFieldDescr;
+FIXErrCode fix_protocol_descr_save_image(FIXProtocolDescr const* prot, char const* file, FIXError** error);
 
 /**
- * FIX message description
+ * fill serialized "tag=" prefix of field type
+ * @param[in] ftype - field type with tag number set
  */
-typedef struct FIXMsgDescr_
-{
-   char* type;                   ///< type. E.g. "A", "AE", "D"
-   char* name;                   ///< textual message name
-   uint32_t field_count;         ///< count of field descriptions
-   FIXFieldDescr* fields;        ///< all fields indexed as array
-   FIXFieldDescr** field_index;  ///< hash table with fields
-   struct FIXMsgDescr_* next;    ///< next description with the same hash key
-} FIXMsgDescr;
+void fix_protocol_init_prefix(FIXFieldType* ftype);
 
 /**
- * FIX protocol description
+ * set bits of required fields
+ * @param[in] fields - field descriptions of message or group
+ * @param[in] count - count of field descriptions
+ * @param[out] required - zeroed bitmap of REQUIRED_WORDS(count) words
  */
-typedef struct FIXProtocolDescr_
-{
-   char* version;                                        ///< protocol version ("FIX.4.4", "FIX.5.0", etc)
-   char* transportVersion;                               ///< version of transport protocol. If protocol doesn't have a transport transportVersion == version
-   FIXFieldType* field_types[FIELD_TYPE_CNT];            ///< array of field types
-   FIXFieldType* transport_field_types[FIELD_TYPE_CNT];  ///< field types of transport protocol
-   FIXMsgDescr* messages[MSG_CNT];                       ///< message descriptions (transport and application levels)
-} FIXProtocolDescr;
+void fix_protocol_init_required(FIXFieldDescr const* fields, uint32_t count, uint64_t* required);
 
 /**
- * parse protocol xml file and create protocol description
- * @param[in] file - protocol xml file
- * @param[out] error - in case of parse error, this error is set
+ * collect tags of Data fields and their Length fields, groups are visited in depth
+ * @param[in] fields - field descriptions of message
+ * @param[in] count - count of field descriptions
+ * @param[out] data_lens - pairs of Data field tag and Length field tag. NULL - pairs are only counted
+ * @return count of pairs
  */
-FIXProtocolDescr const* fix_protocol_descr_create(char const* file, FIXError** error);
+uint32_t fix_protocol_init_data_lens(FIXFieldDescr const* fields, uint32_t count, FIXTagNum* data_lens);
+
+/**
+ * fill bitmap of one char values and place longer values to table. Table must be zeroed, its size and seed must be set
+ * @param[in] values - possible values of field type
+ * @return 1 - every longer value has own slot, else - 0
+ */
+int32_t fix_protocol_place_values(FIXFieldValues* values);
+
+/**
+ * destroy field description, loaded from xml, and its group
+ * @param[in] fd - field description
+ */
+void fix_protocol_free_field_descr(FIXFieldDescr* fd);
+
+/**
+ * destroy message description, loaded from xml
+ * @param[in] msg - message description
+ */
+void fix_protocol_free_msg_descr(FIXMsgDescr const* msg);
 
 /**
  * destroy protocol description
@@ -107,6 +103,14 @@ void fix_protocol_descr_free(FIXProtocolDescr const* prot);
  */
 FIXFieldType* fix_protocol_get_field_type(FIXFieldType* (*ftypes)[FIELD_TYPE_CNT], char const* name);
 
+/**
+ * return field type by tag number
+ * @param[in] prot - protocol description
+ * @param[in] tag - field tag number
+ * @return field type, NULL - not found
+ */
+FIXFieldType const* fix_protocol_get_field_type_by_tag(FIXProtocolDescr const* prot, FIXTagNum tag);
+
 /**
  * get FIX message description by type
  * @param[in] parser - only used for setting parser error
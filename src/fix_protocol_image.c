@@ -0,0 +1,641 @@
+/**
+ * @file   fix_protocol_image.c
+ * @author Dmitry S. Melnikov, dmitryme@gmail.com
+ * @date   Created on: 10/16/2026 06:12:40 PM
+ */
+
+#include "fix_protocol_descr.h"
+#include "fix_utils.h"
+#include "fix_types.h"
+#include "fix_error_priv.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define IMAGE_MAGIC  "FIXDICT" ///< first bytes of image, terminating zero included
+#define IMAGE_FORMAT 2         ///< version of image layout. Must be changed on every layout change
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+/* PRIVATES                                                                                                              */
+/*-----------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * image header. All references inside image are offsets from image beginning or numbers of array items, so image can
+ * be mapped at any address
+ */
+typedef struct ImageHeader_
+{
+   char magic[8];              ///< IMAGE_MAGIC
+   uint32_t format;            ///< IMAGE_FORMAT
+   uint32_t size;              ///< size of whole image
+   uint32_t version;           ///< offset of protocol version
+   uint32_t transport_version; ///< offset of transport protocol version
+   uint32_t type_count;        ///< count of field types
+   uint32_t types;             ///< offset of ImageFieldType array
+   uint32_t msg_count;         ///< count of message descriptions
+   uint32_t msgs;              ///< offset of ImageMsgDescr array
+   uint32_t descr_count;       ///< count of field descriptions of all messages and groups
+   uint32_t descrs;            ///< offset of ImageFieldDescr array
+   uint32_t slot_count;        ///< count of index slots of all messages and groups
+   uint32_t slots;             ///< offset of index slots. Each slot is number of field description + 1 or 0 - if slot is free
+   uint32_t value_count;       ///< count of possible field values
+   uint32_t values;            ///< offset of value offsets array
+} ImageHeader;
+
+/**
+ * field type in image
+ */
+typedef struct ImageFieldType_
+{
+   int32_t tag;           ///< tag number
+   int32_t value_type;    ///< FIXFieldValueTypeEnum
+   uint32_t name;         ///< offset of field type name
+   uint32_t transport;    ///< 1 - type of transport protocol, 0 - type of application protocol
+   uint32_t value_count;  ///< count of possible values. 0 - any value is allowed
+   uint32_t values;       ///< number of first possible value
+   uint32_t value_size;   ///< size of table of values longer than one char
+   uint32_t value_seed;   ///< hash seed of table of values
+} ImageFieldType;
+
+/**
+ * field description in image
+ */
+typedef struct ImageFieldDescr_
+{
+   uint32_t type;             ///< number of field type
+   int32_t category;          ///< FIXFieldCategoryEnum
+   uint32_t flags;            ///< FIELD_FLAG_* values
+   uint32_t group_count;      ///< count of field descriptions in group
+   uint32_t group;            ///< number of first field description of group
+   uint32_t group_index_size; ///< count of group index slots
+   uint32_t group_index;      ///< number of first group index slot
+   uint32_t data_len_field;   ///< number of length field description + 1, 0 - field has no length field
+} ImageFieldDescr;
+
+/**
+ * message description in image
+ */
+typedef struct ImageMsgDescr_
+{
+   uint32_t type;             ///< offset of message type
+   uint32_t name;             ///< offset of message name
+   uint32_t field_count;      ///< count of field descriptions
+   uint32_t fields;           ///< number of first field description
+   uint32_t field_index_size; ///< count of index slots
+   uint32_t field_index;      ///< number of first index slot
+} ImageMsgDescr;
+
+/**
+ * field type reference, used by image writer to find type number
+ */
+typedef struct TypeRef_
+{
+   FIXFieldType const* type; ///< field type
+   uint32_t transport;       ///< 1 - type of transport protocol
+} TypeRef;
+
+/**
+ * state of image writer
+ */
+typedef struct ImageWriter_
+{
+   TypeRef* types;            ///< all field types, sorted by address
+   uint32_t type_count;       ///< count of field types
+   char* data;                ///< header and all arrays
+   uint32_t data_size;        ///< size of data, strings are placed just after it
+   char* strings;             ///< all strings
+   uint32_t strings_size;     ///< used size of strings
+   uint32_t strings_capacity; ///< allocated size of strings
+   uint32_t descr_count;      ///< count of written field descriptions
+   uint32_t slot_count;       ///< count of written index slots
+} ImageWriter;
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static int compare_type_refs(void const* l, void const* r)
+{
+   FIXFieldType const* ltype = ((TypeRef const*)l)->type;
+   FIXFieldType const* rtype = ((TypeRef const*)r)->type;
+   return ltype < rtype ? -1 : (ltype > rtype ? 1 : 0);
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static uint32_t get_type_num(ImageWriter const* w, FIXFieldType const* type)
+{
+   TypeRef key = {type, 0};
+   TypeRef const* ref = (TypeRef const*)bsearch(&key, w->types, w->type_count, sizeof(TypeRef), &compare_type_refs);
+   return (uint32_t)(ref - w->types);
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static uint32_t put_string(ImageWriter* w, char const* str)
+{
+   uint32_t const len = strlen(str) + 1;
+   if (w->strings_size + len > w->strings_capacity)
+   {
+      w->strings_capacity = (w->strings_size + len) * 2;
+      w->strings = (char*)realloc(w->strings, w->strings_capacity);
+   }
+   memcpy(w->strings + w->strings_size, str, len);
+   w->strings_size += len;
+   return w->data_size + w->strings_size - len;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static uint32_t count_descrs(FIXFieldDescr const* fields, uint32_t count, uint32_t* slot_count)
+{
+   uint32_t res = count;
+   for(uint32_t i = 0; i < count; ++i)
+   {
+      if (fields[i].group_count)
+      {
+         res += count_descrs(fields[i].group, fields[i].group_count, slot_count);
+         *slot_count += fields[i].group_index_size;
+      }
+   }
+   return res;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static uint32_t put_index(ImageWriter* w, FIXFieldDescr* const* index, uint32_t size, FIXFieldDescr const* fields,
+      uint32_t first_descr)
+{
+   ImageHeader const* hdr = (ImageHeader const*)w->data;
+   uint32_t* slots = (uint32_t*)(w->data + hdr->slots);
+   uint32_t const first = w->slot_count;
+   w->slot_count += size;
+   for(uint32_t i = 0; i < size; ++i)
+   {
+      slots[first + i] = index[i] ? first_descr + (uint32_t)(index[i] - fields) + 1 : 0;
+   }
+   return first;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static uint32_t put_descrs(ImageWriter* w, FIXFieldDescr const* fields, uint32_t count)
+{
+   ImageHeader const* hdr = (ImageHeader const*)w->data;
+   ImageFieldDescr* descrs = (ImageFieldDescr*)(w->data + hdr->descrs);
+   uint32_t const first = w->descr_count;
+   w->descr_count += count;
+   for(uint32_t i = 0; i < count; ++i)
+   {
+      FIXFieldDescr const* fld = &fields[i];
+      ImageFieldDescr* descr = &descrs[first + i];
+      descr->type = get_type_num(w, fld->type);
+      descr->category = fld->category;
+      descr->flags = fld->flags;
+      descr->data_len_field = fld->dataLenField ? first + (uint32_t)(fld->dataLenField - fields) + 1 : 0;
+      if (fld->group_count)
+      {
+         descr->group_count = fld->group_count;
+         descr->group = put_descrs(w, fld->group, fld->group_count);
+         descr->group_index_size = fld->group_index_size;
+         descr->group_index = put_index(w, fld->group_index, fld->group_index_size, fld->group, descr->group);
+      }
+   }
+   return first;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void collect_types(ImageWriter* w, FIXFieldType* const* ftypes, uint32_t transport, uint32_t* value_count)
+{
+   for(uint32_t i = 0; i < FIELD_TYPE_CNT; ++i)
+   {
+      for(FIXFieldType const* ft = ftypes[i]; ft; ft = ft->next)
+      {
+         if (w->types)
+         {
+            w->types[w->type_count].type = ft;
+            w->types[w->type_count].transport = transport;
+         }
+         ++w->type_count;
+         *value_count += ft->values ? ft->values->count : 0;
+      }
+   }
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static char const* get_string(char const* image, uint32_t size, uint32_t offset)
+{
+   return offset < size ? image + offset : NULL; // image ends with zero, so every string is terminated
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static int32_t check_array(ImageHeader const* hdr, uint32_t offset, uint32_t count, uint32_t item_size)
+{
+   return (offset % sizeof(uint32_t)) == 0 && (uint64_t)offset + (uint64_t)count * item_size <= hdr->size;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode check_image(char const* image, uint32_t size)
+{
+   ImageHeader const* hdr = (ImageHeader const*)image;
+   if (size < sizeof(ImageHeader) || memcmp(hdr->magic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC)) || hdr->format != IMAGE_FORMAT ||
+       hdr->size != size || image[size - 1])
+   {
+      return FIX_FAILED;
+   }
+   if (!check_array(hdr, hdr->types, hdr->type_count, sizeof(ImageFieldType)) ||
+       !check_array(hdr, hdr->msgs, hdr->msg_count, sizeof(ImageMsgDescr)) ||
+       !check_array(hdr, hdr->descrs, hdr->descr_count, sizeof(ImageFieldDescr)) ||
+       !check_array(hdr, hdr->slots, hdr->slot_count, sizeof(uint32_t)) ||
+       !check_array(hdr, hdr->values, hdr->value_count, sizeof(uint32_t)))
+   {
+      return FIX_FAILED;
+   }
+   if (!get_string(image, size, hdr->version) || !get_string(image, size, hdr->transport_version))
+   {
+      return FIX_FAILED;
+   }
+   return FIX_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode load_types(FIXProtocolDescr* prot, FIXFieldType* types, FIXFieldValues* values, char const** value_ptrs,
+      FIXFieldValueSlot* value_slots)
+{
+   char const* image = (char const*)prot->image;
+   ImageHeader const* hdr = (ImageHeader const*)image;
+   ImageFieldType const* itypes = (ImageFieldType const*)(image + hdr->types);
+   uint32_t const* ivalues = (uint32_t const*)(image + hdr->values);
+   for(uint32_t i = 0; i < hdr->type_count; ++i)
+   {
+      ImageFieldType const* itype = &itypes[i];
+      FIXFieldType* ft = &types[i];
+      ft->tag = itype->tag;
+      fix_protocol_init_prefix(ft);
+      ft->valueType = (FIXFieldValueTypeEnum)itype->value_type;
+      ft->name = (char*)get_string(image, prot->image_size, itype->name);
+      if (!ft->name || (uint64_t)itype->values + itype->value_count > hdr->value_count)
+      {
+         return FIX_FAILED;
+      }
+      if (itype->value_count)
+      {
+         ft->values = values++;
+         ft->values->count = itype->value_count;
+         ft->values->values = value_ptrs;
+         value_ptrs += itype->value_count;
+         ft->values->size = itype->value_size;
+         ft->values->seed = itype->value_seed;
+         ft->values->table = value_slots;
+         value_slots += itype->value_size;
+         for(uint32_t j = 0; j < itype->value_count; ++j)
+         {
+            ft->values->values[j] = get_string(image, prot->image_size, ivalues[itype->values + j]);
+            if (!ft->values->values[j])
+            {
+               return FIX_FAILED;
+            }
+         }
+         if (!fix_protocol_place_values(ft->values))
+         {
+            return FIX_FAILED;
+         }
+      }
+      FIXFieldType** ftypes = itype->transport ? prot->transport_field_types : prot->field_types;
+      uint32_t const idx = fix_utils_hash_string(ft->name, strlen(ft->name)) % FIELD_TYPE_CNT;
+      ft->next = ftypes[idx];
+      ftypes[idx] = ft;
+   }
+   return FIX_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode load_descrs(FIXProtocolDescr const* prot, FIXFieldType* types, FIXFieldDescr* descrs, FIXFieldDescr** slots)
+{
+   char const* image = (char const*)prot->image;
+   ImageHeader const* hdr = (ImageHeader const*)image;
+   ImageFieldDescr const* idescrs = (ImageFieldDescr const*)(image + hdr->descrs);
+   uint32_t const* islots = (uint32_t const*)(image + hdr->slots);
+   for(uint32_t i = 0; i < hdr->slot_count; ++i)
+   {
+      if (islots[i] > hdr->descr_count)
+      {
+         return FIX_FAILED;
+      }
+      slots[i] = islots[i] ? &descrs[islots[i] - 1] : NULL;
+   }
+   for(uint32_t i = 0; i < hdr->descr_count; ++i)
+   {
+      ImageFieldDescr const* idescr = &idescrs[i];
+      FIXFieldDescr* fd = &descrs[i];
+      if (idescr->type >= hdr->type_count || idescr->data_len_field > hdr->descr_count ||
+          (uint64_t)idescr->group + idescr->group_count > hdr->descr_count ||
+          (uint64_t)idescr->group_index + idescr->group_index_size > hdr->slot_count ||
+          (idescr->group_count && !idescr->group_index_size))
+      {
+         return FIX_FAILED;
+      }
+      fd->type = &types[idescr->type];
+      fd->category = (FIXFieldCategoryEnum)idescr->category;
+      fd->flags = idescr->flags;
+      fd->dataLenField = idescr->data_len_field ? &descrs[idescr->data_len_field - 1] : NULL;
+      if (idescr->group_count)
+      {
+         fd->group_count = idescr->group_count;
+         fd->group = &descrs[idescr->group];
+         fd->group_index_size = idescr->group_index_size;
+         fd->group_index = &slots[idescr->group_index];
+      }
+   }
+   return FIX_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode load_msgs(FIXProtocolDescr* prot, FIXMsgDescr* msgs, FIXFieldDescr* descrs, FIXFieldDescr** slots)
+{
+   char const* image = (char const*)prot->image;
+   ImageHeader const* hdr = (ImageHeader const*)image;
+   ImageMsgDescr const* imsgs = (ImageMsgDescr const*)(image + hdr->msgs);
+   FIXMsgDescr* tails[MSG_CNT] = {};
+   for(uint32_t i = 0; i < hdr->msg_count; ++i)
+   {
+      ImageMsgDescr const* imsg = &imsgs[i];
+      FIXMsgDescr* msg = &msgs[i];
+      msg->type = (char*)get_string(image, prot->image_size, imsg->type);
+      msg->name = (char*)get_string(image, prot->image_size, imsg->name);
+      if (!msg->type || !msg->name || !imsg->field_index_size ||
+          (uint64_t)imsg->fields + imsg->field_count > hdr->descr_count ||
+          (uint64_t)imsg->field_index + imsg->field_index_size > hdr->slot_count)
+      {
+         return FIX_FAILED;
+      }
+      msg->field_count = imsg->field_count;
+      msg->fields = &descrs[imsg->fields];
+      msg->field_index_size = imsg->field_index_size;
+      msg->field_index = &slots[imsg->field_index];
+      uint32_t const idx = fix_utils_hash_string(msg->type, strlen(msg->type)) % MSG_CNT;
+      if (tails[idx]) // messages are stored in lookup order, so order of chain is kept
+      {
+         tails[idx]->next = msg;
+      }
+      else
+      {
+         prot->messages[idx] = msg;
+      }
+      tails[idx] = msg;
+   }
+   return FIX_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void init_required(FIXProtocolDescr const* prot, FIXMsgDescr* msgs, FIXFieldDescr* descrs, uint64_t* required)
+{
+   ImageHeader const* hdr = (ImageHeader const*)prot->image;
+   for(uint32_t i = 0; i < hdr->msg_count; ++i)
+   {
+      msgs[i].required = required;
+      fix_protocol_init_required(msgs[i].fields, msgs[i].field_count, required);
+      required += REQUIRED_WORDS(msgs[i].field_count);
+   }
+   for(uint32_t i = 0; i < hdr->descr_count; ++i)
+   {
+      if (descrs[i].group_count)
+      {
+         descrs[i].group_required = required;
+         fix_protocol_init_required(descrs[i].group, descrs[i].group_count, required);
+         required += REQUIRED_WORDS(descrs[i].group_count);
+      }
+   }
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode init_data_lens(FIXProtocolDescr const* prot, FIXMsgDescr* msgs, FIXTagNum* data_lens, uint32_t count)
+{
+   ImageHeader const* hdr = (ImageHeader const*)prot->image;
+   for(uint32_t i = 0; i < hdr->msg_count; ++i)
+   {
+      uint32_t const data_len_count = fix_protocol_init_data_lens(msgs[i].fields, msgs[i].field_count, NULL);
+      if (data_len_count > count) // every Data field belongs to one message
+      {
+         return FIX_FAILED;
+      }
+      msgs[i].data_lens = data_len_count ? data_lens : NULL;
+      msgs[i].data_len_count = fix_protocol_init_data_lens(msgs[i].fields, msgs[i].field_count, msgs[i].data_lens);
+      data_lens += data_len_count * 2;
+      count -= data_len_count;
+   }
+   return FIX_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode load_image(FIXProtocolDescr* prot)
+{
+   char const* image = (char const*)prot->image;
+   ImageHeader const* hdr = (ImageHeader const*)image;
+   ImageFieldType const* itypes = (ImageFieldType const*)(image + hdr->types);
+   FIXTagNum max_tag = 0;
+   uint32_t value_sets = 0;
+   uint64_t value_slots = 0;
+   for(uint32_t i = 0; i < hdr->type_count; ++i)
+   {
+      uint32_t const value_size = itypes[i].value_size;
+      if (value_size > FIELD_VALUE_TABLE_MAX || (value_size & (value_size - 1)))
+      {
+         return FIX_FAILED;
+      }
+      max_tag = itypes[i].tag > max_tag ? itypes[i].tag : max_tag;
+      value_sets += (itypes[i].value_count != 0);
+      value_slots += itypes[i].value_count ? value_size : 0;
+   }
+   ImageFieldDescr const* idescrs = (ImageFieldDescr const*)(image + hdr->descrs);
+   ImageMsgDescr const* imsgs = (ImageMsgDescr const*)(image + hdr->msgs);
+   uint64_t required_words = 0;
+   uint32_t data_lens = 0;
+   for(uint32_t i = 0; i < hdr->descr_count; ++i)
+   {
+      required_words += REQUIRED_WORDS((uint64_t)idescrs[i].group_count);
+      data_lens += (idescrs[i].data_len_field != 0);
+   }
+   for(uint32_t i = 0; i < hdr->msg_count; ++i)
+   {
+      required_words += REQUIRED_WORDS((uint64_t)imsgs[i].field_count);
+   }
+   prot->version = (char*)get_string(image, prot->image_size, hdr->version);
+   prot->transportVersion = (char*)get_string(image, prot->image_size, hdr->transport_version);
+   prot->tag_types_count = max_tag + 1;
+   // bitmaps and pointer tables are placed first, so they are aligned
+   uint64_t const arena_size =
+      sizeof(uint64_t) * required_words +
+      (uint64_t)sizeof(FIXFieldType*) * prot->tag_types_count +
+      (uint64_t)sizeof(char const*) * hdr->value_count +
+      (uint64_t)sizeof(FIXFieldDescr*) * hdr->slot_count +
+      (uint64_t)sizeof(FIXFieldValueSlot) * value_slots +
+      (uint64_t)sizeof(FIXTagNum) * 2 * data_lens +
+      (uint64_t)sizeof(FIXFieldType) * hdr->type_count +
+      (uint64_t)sizeof(FIXFieldValues) * value_sets +
+      (uint64_t)sizeof(FIXFieldDescr) * hdr->descr_count +
+      (uint64_t)sizeof(FIXMsgDescr) * hdr->msg_count;
+   prot->arena = (arena_size < UINT32_MAX) ? calloc(1, arena_size) : NULL;
+   if (!prot->arena)
+   {
+      return FIX_FAILED;
+   }
+   char* arena = (char*)prot->arena;
+   uint64_t* required = (uint64_t*)arena;
+   arena += sizeof(uint64_t) * required_words;
+   prot->tag_types = (FIXFieldType**)arena;
+   arena += sizeof(FIXFieldType*) * prot->tag_types_count;
+   char const** value_ptrs = (char const**)arena;
+   arena += sizeof(char const*) * hdr->value_count;
+   FIXFieldDescr** slots = (FIXFieldDescr**)arena;
+   arena += sizeof(FIXFieldDescr*) * hdr->slot_count;
+   FIXFieldValueSlot* value_table = (FIXFieldValueSlot*)arena;
+   arena += sizeof(FIXFieldValueSlot) * value_slots;
+   FIXTagNum* data_len_tags = (FIXTagNum*)arena;
+   arena += sizeof(FIXTagNum) * 2 * data_lens;
+   FIXFieldType* types = (FIXFieldType*)arena;
+   arena += sizeof(FIXFieldType) * hdr->type_count;
+   FIXFieldValues* values = (FIXFieldValues*)arena;
+   arena += sizeof(FIXFieldValues) * value_sets;
+   FIXFieldDescr* descrs = (FIXFieldDescr*)arena;
+   arena += sizeof(FIXFieldDescr) * hdr->descr_count;
+   FIXMsgDescr* msgs = (FIXMsgDescr*)arena;
+   if (load_types(prot, types, values, value_ptrs, value_table) == FIX_FAILED ||
+       load_descrs(prot, types, descrs, slots) == FIX_FAILED ||
+       load_msgs(prot, msgs, descrs, slots) == FIX_FAILED ||
+       init_data_lens(prot, msgs, data_len_tags, data_lens) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
+   init_required(prot, msgs, descrs, required);
+   for(uint32_t transport = 2; transport-- > 0;) // application types override transport ones
+   {
+      for(uint32_t i = 0; i < hdr->type_count; ++i)
+      {
+         if (itypes[i].transport == transport && itypes[i].tag >= 0)
+         {
+            prot->tag_types[itypes[i].tag] = &types[i];
+         }
+      }
+   }
+   return FIX_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+/* PUBLICS                                                                                                               */
+/*-----------------------------------------------------------------------------------------------------------------------*/
+FIXProtocolDescr const* fix_protocol_descr_load_image(char const* file, FIXError** error)
+{
+   uint32_t size = 0;
+   void const* image = fix_utils_map_file(file, &size);
+   if (!image)
+   {
+      *error = fix_error_create(FIX_ERROR_PROTOCOL_IMAGE_LOAD_FAILED, "Unable to map protocol image '%s'.", file);
+      return NULL;
+   }
+   if (check_image((char const*)image, size) == FIX_FAILED)
+   {
+      fix_utils_unmap_file(image, size);
+      *error = fix_error_create(FIX_ERROR_PROTOCOL_IMAGE_LOAD_FAILED, "Protocol image '%s' has wrong format.", file);
+      return NULL;
+   }
+   FIXProtocolDescr* prot = (FIXProtocolDescr*)calloc(1, sizeof(FIXProtocolDescr));
+   prot->ref_count = 1;
+   prot->image = image;
+   prot->image_size = size;
+   if (load_image(prot) == FIX_FAILED)
+   {
+      fix_protocol_descr_free(prot);
+      *error = fix_error_create(FIX_ERROR_PROTOCOL_IMAGE_LOAD_FAILED, "Protocol image '%s' is corrupted.", file);
+      return NULL;
+   }
+   return prot;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+FIXErrCode fix_protocol_descr_save_image(FIXProtocolDescr const* prot, char const* file, FIXError** error)
+{
+   ImageWriter w = {};
+   uint32_t value_count = 0;
+   collect_types(&w, prot->transport_field_types, 1, &value_count);
+   collect_types(&w, prot->field_types, 0, &value_count);
+   w.types = (TypeRef*)calloc(w.type_count ? w.type_count : 1, sizeof(TypeRef));
+   w.type_count = 0;
+   value_count = 0;
+   collect_types(&w, prot->transport_field_types, 1, &value_count);
+   collect_types(&w, prot->field_types, 0, &value_count);
+   qsort(w.types, w.type_count, sizeof(TypeRef), &compare_type_refs);
+   uint32_t msg_count = 0;
+   uint32_t descr_count = 0;
+   uint32_t slot_count = 0;
+   for(uint32_t i = 0; i < MSG_CNT; ++i)
+   {
+      for(FIXMsgDescr const* msg = prot->messages[i]; msg; msg = msg->next)
+      {
+         ++msg_count;
+         descr_count += count_descrs(msg->fields, msg->field_count, &slot_count);
+         slot_count += msg->field_index_size;
+      }
+   }
+   ImageHeader hdr = {IMAGE_MAGIC, IMAGE_FORMAT};
+   hdr.type_count = w.type_count;
+   hdr.types = sizeof(ImageHeader);
+   hdr.msg_count = msg_count;
+   hdr.msgs = hdr.types + sizeof(ImageFieldType) * hdr.type_count;
+   hdr.descr_count = descr_count;
+   hdr.descrs = hdr.msgs + sizeof(ImageMsgDescr) * hdr.msg_count;
+   hdr.slot_count = slot_count;
+   hdr.slots = hdr.descrs + sizeof(ImageFieldDescr) * hdr.descr_count;
+   hdr.value_count = value_count;
+   hdr.values = hdr.slots + sizeof(uint32_t) * hdr.slot_count;
+   w.data_size = hdr.values + sizeof(uint32_t) * hdr.value_count;
+   w.data = (char*)calloc(1, w.data_size);
+   memcpy(w.data, &hdr, sizeof(hdr));
+   ImageHeader* image_hdr = (ImageHeader*)w.data;
+   image_hdr->version = put_string(&w, prot->version);
+   image_hdr->transport_version = put_string(&w, prot->transportVersion);
+   ImageFieldType* types = (ImageFieldType*)(w.data + hdr.types);
+   uint32_t* values = (uint32_t*)(w.data + hdr.values);
+   value_count = 0;
+   for(uint32_t i = 0; i < w.type_count; ++i)
+   {
+      FIXFieldType const* ft = w.types[i].type;
+      types[i].tag = ft->tag;
+      types[i].value_type = ft->valueType;
+      types[i].name = put_string(&w, ft->name);
+      types[i].transport = w.types[i].transport;
+      types[i].values = value_count;
+      for(uint32_t j = 0; ft->values && j < ft->values->count; ++j)
+      {
+         values[value_count++] = put_string(&w, ft->values->values[j]);
+      }
+      types[i].value_count = value_count - types[i].values;
+      types[i].value_size = ft->values ? ft->values->size : 0;
+      types[i].value_seed = ft->values ? ft->values->seed : 0;
+   }
+   ImageMsgDescr* msgs = (ImageMsgDescr*)(w.data + hdr.msgs);
+   msg_count = 0;
+   for(uint32_t i = 0; i < MSG_CNT; ++i)
+   {
+      for(FIXMsgDescr const* msg = prot->messages[i]; msg; msg = msg->next)
+      {
+         ImageMsgDescr* imsg = &msgs[msg_count++];
+         imsg->type = put_string(&w, msg->type);
+         imsg->name = put_string(&w, msg->name);
+         imsg->field_count = msg->field_count;
+         imsg->fields = put_descrs(&w, msg->fields, msg->field_count);
+         imsg->field_index_size = msg->field_index_size;
+         imsg->field_index = put_index(&w, msg->field_index, msg->field_index_size, msg->fields, imsg->fields);
+      }
+   }
+   image_hdr->size = w.data_size + w.strings_size;
+   FIXErrCode res = FIX_SUCCESS;
+   FILE* f = fopen(file, "wb");
+   if (!f || fwrite(w.data, 1, w.data_size, f) != w.data_size || fwrite(w.strings, 1, w.strings_size, f) != w.strings_size)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Unable to write protocol image '%s'.", file);
+      res = FIX_FAILED;
+   }
+   if (f && fclose(f) && res == FIX_SUCCESS)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Unable to write protocol image '%s'.", file);
+      res = FIX_FAILED;
+   }
+   free(w.types);
+   free(w.data);
+   free(w.strings);
+   return res;
+}
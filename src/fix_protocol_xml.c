@@ -0,0 +1,760 @@
+/**
+ * @file   fix_protocol_xml.c
+ * @author Dmitry S. Melnikov, dmitryme@gmail.com
+ * @date   Created on: 07/27/2012 06:14:53 PM
+ */
+
+#include "fix_protocol_descr.h"
+#include "fix_utils.h"
+#include "fix_types.h"
+#include "fix_error_priv.h"
+
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef FIX_PARSER_WITHOUT_XML
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+/* PUBLICS                                                                                                               */
+/*-----------------------------------------------------------------------------------------------------------------------*/
+FIXProtocolDescr const* fix_protocol_descr_create(char const* file, FIXError** error)
+{
+   *error = fix_error_create(
+         FIX_ERROR_PROTOCOL_XML_LOAD_FAILED, "Unable to load '%s', library is built without xml support.", file);
+   return NULL;
+}
+
+#else
+
+#include "fix_descr_xsd.h"
+
+#include <libxml/parser.h>
+#include <libxml/xmlschemas.h>
+#include  <libxml/tree.h>
+#include <limits.h>
+#include <assert.h>
+
+#define VALUE_SEED_CNT 64 ///< count of hash seeds tried for each size of value table
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+/* PRIVATES                                                                                                              */
+/*-----------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * temporary buffers used by build_index
+ */
+typedef struct IndexBuffer_
+{
+   uint32_t* tags;         ///< tags of fields being indexed
+   uint32_t tags_size;     ///< allocated size of tags
+   uint8_t* diffs;         ///< diffs[d] is 1, if some two tags differ by d
+   uint32_t diffs_size;    ///< allocated size of diffs
+} IndexBuffer;
+
+/**
+ * component of protocol XML document. Its fields are flattened once and copied to every message or group using it
+ */
+typedef struct Component_
+{
+   char const* name;          ///< component name, points to XML document
+   xmlNode const* node;       ///< component node
+   int32_t field_count;       ///< count of flattened fields, -1 - not counted yet
+   FIXFieldDescr* fields;     ///< flattened fields
+   int32_t loaded;            ///< 1 - fields are loaded
+   int32_t busy;              ///< 1 - component is being counted or loaded, used to catch component including itself
+   struct Component_* next;   ///< next component with the same hash
+} Component;
+
+/**
+ * components of protocol XML document indexed by name
+ */
+typedef struct ComponentIndex_
+{
+   Component* components;     ///< all components of document
+   uint32_t count;            ///< count of components
+   Component** table;         ///< hash table of components
+   uint32_t size;             ///< size of hash table
+} ComponentIndex;
+
+static uint32_t count_msg_fields(xmlNode const* msg_node, ComponentIndex* components);
+static FIXErrCode load_fields(
+      FIXFieldDescr* fields, uint32_t* count, xmlNode const* msg_node, ComponentIndex* components,
+      FIXFieldType* (*ftypes)[FIELD_TYPE_CNT], FIXError** error);
+static void xmlErrorHandler(void* ctx, char const* msg, ...)
+{
+   va_list ap;
+   va_start(ap, msg);
+   FIXError** error = (FIXError**)ctx;
+   *error = fix_error_create_va(FIX_ERROR_LIBXML, msg, ap);
+   va_end(ap);
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static int32_t initLibXml(FIXError** error)
+{
+   xmlSetGenericErrorFunc(error, xmlErrorHandler);
+   return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode xml_validate(xmlDoc* doc, FIXError** error)
+{
+   xmlSchemaParserCtxtPtr pctx = xmlSchemaNewMemParserCtxt(fix_xsd, strlen(fix_xsd));
+   xmlSchemaPtr schema = xmlSchemaParse(pctx);
+   if (!schema)
+   {
+      return FIX_FAILED;
+   }
+   xmlSchemaValidCtxtPtr validCtx = xmlSchemaNewValidCtxt(schema);
+   xmlSchemaSetValidErrors(validCtx, &xmlErrorHandler, &xmlErrorHandler, error);
+
+   int32_t res = xmlSchemaValidateDoc(validCtx, doc);
+
+   xmlSchemaFreeValidCtxt(validCtx);
+   xmlSchemaFree(schema);
+   xmlSchemaFreeParserCtxt(pctx);
+
+   return res ? FIX_FAILED : FIX_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static char const* get_attr(xmlNode const* node, char const* attrName, char const* defVal)
+{
+   if (!node)
+   {
+      return NULL;
+   }
+   xmlAttr const* attr = node->properties;
+   while(attr)
+   {
+      if (!strcmp((char const*)attr->name, attrName))
+      {
+         return (char const*)attr->children->content;
+      }
+      attr = attr->next;
+   }
+   return defVal;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static xmlNode* get_first(xmlNode const* node, char const* name)
+{
+   xmlNode* child = node->children;
+   while(child)
+   {
+      if (child->type == XML_ELEMENT_NODE && !strcmp((char const*)child->name, name))
+      {
+         return child;
+      }
+      child = child->next;
+   }
+   return NULL;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode build_values(FIXFieldValues* values)
+{
+   uint32_t count = 0;
+   for(uint32_t i = 0; i < values->count; ++i)
+   {
+      count += (strlen(values->values[i]) != 1);
+   }
+   if (!count)
+   {
+      fix_protocol_place_values(values);
+      return FIX_SUCCESS;
+   }
+   // find the smallest table and seed, with which each value has own slot, so check is a single compare
+   values->size = 2;
+   while(values->size < count * 2)
+   {
+      values->size *= 2;
+   }
+   for(; values->size <= FIELD_VALUE_TABLE_MAX; values->size *= 2)
+   {
+      values->table = (FIXFieldValueSlot*)realloc(values->table, values->size * sizeof(FIXFieldValueSlot));
+      for(values->seed = 0; values->seed < VALUE_SEED_CNT; ++values->seed)
+      {
+         memset(values->table, 0, values->size * sizeof(FIXFieldValueSlot));
+         if (fix_protocol_place_values(values))
+         {
+            return FIX_SUCCESS;
+         }
+      }
+   }
+   return FIX_FAILED;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode load_field_types(FIXFieldType* (*ftypes)[FIELD_TYPE_CNT], xmlNode const* root, FIXError** error)
+{
+   xmlNode const* field = get_first(get_first(root, "fields"), "field");
+   while(field)
+   {
+      if (field->type == XML_ELEMENT_NODE && !strcmp((char const*)field->name, "field"))
+      {
+         if (fix_protocol_get_field_type(ftypes, get_attr(field, "name", NULL)))
+         {
+            *error = fix_error_create(FIX_ERROR_FIELD_TYPE_EXISTS, "FIXFieldType '%s' already exists", (char const*)field->name);
+            return FIX_FAILED;
+         }
+         FIXFieldType* fld = (FIXFieldType*)calloc(1, sizeof(FIXFieldType));
+         fld->tag = atoi(get_attr(field, "number", NULL));
+         fix_protocol_init_prefix(fld);
+         fld->name = _strdup(get_attr(field, "name", NULL));
+         fld->valueType = str2FIXFieldValueType(get_attr(field, "type", NULL));
+         uint32_t idx = fix_utils_hash_string(fld->name, strlen(fld->name)) % FIELD_TYPE_CNT;
+         fld->next = (*ftypes)[idx];
+         (*ftypes)[idx] = fld;
+         xmlNode const* value = get_first(field, "value");
+         if (value)
+         {
+            fld->values = (FIXFieldValues*)calloc(1, sizeof(FIXFieldValues));
+            for(xmlNode const* v = value; v; v = v->next)
+            {
+               fld->values->count += (v->type == XML_ELEMENT_NODE && !strcmp((char const*)v->name, "value"));
+            }
+            fld->values->values = (char const**)calloc(fld->values->count, sizeof(char const*));
+            uint32_t count = 0;
+            for(; value; value = value->next)
+            {
+               if (value->type == XML_ELEMENT_NODE && !strcmp((char const*)value->name, "value"))
+               {
+                  fld->values->values[count++] = strdup(get_attr(value, "enum", NULL));
+               }
+            }
+            if (build_values(fld->values) == FIX_FAILED)
+            {
+               *error = fix_error_create(FIX_ERROR_WRONG_FIELD_VALUE, "Unable to build value table of field '%s'", fld->name);
+               return FIX_FAILED;
+            }
+         }
+      }
+      field = field->next;
+   }
+   return FIX_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static Component* find_component(ComponentIndex* components, char const* name)
+{
+   if (!name)
+   {
+      return NULL;
+   }
+   uint32_t idx = fix_utils_hash_string(name, strlen(name)) % components->size;
+   for(Component* component = components->table[idx]; component; component = component->next)
+   {
+      if (!strcmp(component->name, name))
+      {
+         return component;
+      }
+   }
+   return NULL;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void build_component_index(ComponentIndex* components, xmlNode const* components_node)
+{
+   memset(components, 0, sizeof(ComponentIndex));
+   xmlNode const* node = components_node ? get_first(components_node, "component") : NULL;
+   for(xmlNode const* n = node; n; n = n->next)
+   {
+      components->count += (n->type == XML_ELEMENT_NODE);
+   }
+   components->size = components->count * 2 + 1;
+   components->components = (Component*)calloc(components->count ? components->count : 1, sizeof(Component));
+   components->table = (Component**)calloc(components->size, sizeof(Component*));
+   uint32_t count = 0;
+   for(xmlNode const* n = node; n; n = n->next)
+   {
+      if (n->type != XML_ELEMENT_NODE)
+      {
+         continue;
+      }
+      char const* name = get_attr(n, "name", NULL);
+      if (!name || find_component(components, name)) // the first component with the same name is used
+      {
+         continue;
+      }
+      Component* component = &components->components[count++];
+      component->name = name;
+      component->node = n;
+      component->field_count = -1;
+      uint32_t idx = fix_utils_hash_string(name, strlen(name)) % components->size;
+      component->next = components->table[idx];
+      components->table[idx] = component;
+   }
+   components->count = count;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void free_component_index(ComponentIndex* components)
+{
+   for(uint32_t i = 0; i < components->count; ++i)
+   {
+      Component* component = &components->components[i];
+      for(int32_t j = 0; component->fields && j < component->field_count; ++j)
+      {
+         fix_protocol_free_field_descr(&component->fields[j]);
+      }
+      free(component->fields);
+   }
+   free(components->components);
+   free(components->table);
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static uint32_t count_component_fields(Component* component, ComponentIndex* components)
+{
+   if (component->field_count < 0 && !component->busy)
+   {
+      component->busy = 1;
+      component->field_count = count_msg_fields(component->node, components);
+      component->busy = 0;
+   }
+   return component->field_count < 0 ? 0 : component->field_count;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode load_component(Component* component, ComponentIndex* components,
+      FIXFieldType* (*ftypes)[FIELD_TYPE_CNT], FIXError** error)
+{
+   if (component->loaded)
+   {
+      return FIX_SUCCESS;
+   }
+   uint32_t const field_count = count_component_fields(component, components);
+   if (component->busy)
+   {
+      *error = fix_error_create(FIX_ERROR_WRONG_FIELD, "Component '%s' includes itself.", component->name);
+      return FIX_FAILED;
+   }
+   component->busy = 1;
+   component->fields = (FIXFieldDescr*)calloc(field_count ? field_count : 1, sizeof(FIXFieldDescr));
+   uint32_t count = 0;
+   FIXErrCode res = load_fields(component->fields, &count, component->node, components, ftypes, error);
+   component->busy = 0;
+   if (res == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
+   assert(count == field_count);
+   component->loaded = 1;
+   return FIX_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void copy_fields(FIXFieldDescr* dst, FIXFieldDescr const* src, uint32_t count)
+{
+   memcpy(dst, src, count * sizeof(FIXFieldDescr));
+   for(uint32_t i = 0; i < count; ++i)
+   {
+      if (src[i].group_count)
+      {
+         dst[i].group = (FIXFieldDescr*)calloc(src[i].group_count, sizeof(FIXFieldDescr));
+         copy_fields(dst[i].group, src[i].group, src[i].group_count);
+      }
+   }
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode link_data_fields(FIXFieldDescr* fields, uint32_t count, FIXError** error)
+{
+   // Data field is linked after fields are flattened, because its Length field can precede component
+   for(uint32_t i = 0; i < count; ++i)
+   {
+      FIXFieldDescr* fld = &fields[i];
+      if (fld->type->valueType == FIXFieldValueType_Data)
+      {
+         if (i == 0 || fields[i - 1].type->valueType != FIXFieldValueType_Length)
+         {
+            *error = fix_error_create(FIX_ERROR_WRONG_FIELD, "Previous field for field '%s' shall have Length type.",
+                  fld->type->name);
+            return FIX_FAILED;
+         }
+         fld->dataLenField = &fields[i - 1];
+      }
+      if (fld->group_count && link_data_fields(fld->group, fld->group_count, error) == FIX_FAILED)
+      {
+         return FIX_FAILED;
+      }
+   }
+   return FIX_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static uint32_t count_msg_fields(xmlNode const* msg_node, ComponentIndex* components)
+{
+   uint32_t count = 0;
+   xmlNode const* field = msg_node->children;
+   while(field)
+   {
+      if (field->type == XML_ELEMENT_NODE && !strcmp((char const*)field->name, "field"))
+      {
+         ++count;
+      }
+      else if (field->type == XML_ELEMENT_NODE && !strcmp((char const*)field->name, "component"))
+      {
+         Component* component = find_component(components, get_attr(field, "name", NULL));
+         if (component)
+         {
+            count += count_component_fields(component, components);
+         }
+      }
+      else if (field->type == XML_ELEMENT_NODE && !strcmp((char const*)field->name, "group"))
+      {
+         ++count;
+      }
+      field = field->next;
+   }
+   return count;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode load_fields(
+      FIXFieldDescr* fields, uint32_t* count, xmlNode const* msg_node, ComponentIndex* components,
+      FIXFieldType* (*ftypes)[FIELD_TYPE_CNT], FIXError** error)
+{
+   xmlNode const* field = msg_node->children;
+   while(field)
+   {
+      if (field->type == XML_ELEMENT_NODE && !strcmp((char const*)field->name, "field"))
+      {
+         char const* name = get_attr(field, "name", NULL);
+         char const* required = get_attr(field, "required", NULL);
+         FIXFieldDescr* fld = &fields[(*count)++];
+         fld->type = fix_protocol_get_field_type(ftypes, name);
+         fld->category = FIXFieldCategory_Value;
+         if (!fld->type)
+         {
+            *error = fix_error_create(FIX_ERROR_UNKNOWN_FIELD, "FIXFieldType '%s' is unknown", name);
+            return FIX_FAILED;
+         }
+         if (!strcmp(required, "Y"))
+         {
+            fld->flags |= FIELD_FLAG_REQUIRED;
+         }
+      }
+      else if (field->type == XML_ELEMENT_NODE && !strcmp((char const*)field->name, "component"))
+      {
+         Component* component = find_component(components, get_attr(field, "name", NULL));
+         if (component)
+         {
+            if (FIX_FAILED == load_component(component, components, ftypes, error))
+            {
+               return FIX_FAILED;
+            }
+            copy_fields(&fields[*count], component->fields, component->field_count);
+            *count += component->field_count;
+         }
+      }
+      else if (field->type == XML_ELEMENT_NODE && !strcmp((char const*)field->name, "group"))
+      {
+         char const* name = get_attr(field, "name", NULL);
+         char const* required = get_attr(field, "required", NULL);
+         FIXFieldDescr* fld = &fields[(*count)++];
+         memset(fld, 0, sizeof(FIXFieldDescr));
+         fld->type = fix_protocol_get_field_type(ftypes, name);
+         fld->category = FIXFieldCategory_Group;
+         if (!fld->type)
+         {
+            *error = fix_error_create(FIX_ERROR_UNKNOWN_FIELD, "FIXFieldType '%s' is unknown", name);
+            return FIX_FAILED;
+         }
+         if (!strcmp(required, "Y"))
+         {
+            fld->flags |= FIELD_FLAG_REQUIRED;
+         }
+         fld->group_count = count_msg_fields(field, components);
+         fld->group = (FIXFieldDescr*)calloc(fld->group_count, sizeof(FIXFieldDescr));
+         uint32_t count1 = 0;
+         if (FIX_FAILED == load_fields(fld->group, &count1, field, components, ftypes, error))
+         {
+            return FIX_FAILED;
+         }
+      }
+      field = field->next;
+   }
+   return FIX_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static int32_t try_index_size(uint8_t const* diffs, uint32_t max_diff, uint32_t size)
+{
+   // two tags share a slot only if size divides their difference
+   for(uint32_t d = size; d <= max_diff; d += size)
+   {
+      if (diffs[d])
+      {
+         return 0;
+      }
+   }
+   return 1;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static FIXFieldDescr** build_index(FIXFieldDescr* fields, uint32_t field_count, uint32_t* index_size, IndexBuffer* buff)
+{
+   // find the smallest table, where all tags are placed without collisions, so lookup is a single table access
+   if (field_count > buff->tags_size)
+   {
+      free(buff->tags);
+      buff->tags_size = field_count * 2;
+      buff->tags = (uint32_t*)malloc(buff->tags_size * sizeof(uint32_t));
+   }
+   uint32_t min_tag = UINT_MAX, max_tag = 0;
+   for(uint32_t i = 0; i < field_count; ++i)
+   {
+      buff->tags[i] = fields[i].type->tag;
+      min_tag = buff->tags[i] < min_tag ? buff->tags[i] : min_tag;
+      max_tag = buff->tags[i] > max_tag ? buff->tags[i] : max_tag;
+   }
+   uint32_t const max_diff = field_count ? max_tag - min_tag : 0;
+   if (max_diff >= buff->diffs_size)
+   {
+      free(buff->diffs);
+      buff->diffs_size = (max_diff + 1) * 2;
+      buff->diffs = (uint8_t*)calloc(buff->diffs_size, sizeof(uint8_t));
+   }
+   for(uint32_t i = 0; i < field_count; ++i)
+   {
+      for(uint32_t j = i + 1; j < field_count; ++j)
+      {
+         buff->diffs[buff->tags[i] > buff->tags[j] ? buff->tags[i] - buff->tags[j] : buff->tags[j] - buff->tags[i]] = 1;
+      }
+   }
+   buff->diffs[0] = 0; // field with duplicated tag is not a collision
+   uint32_t size = field_count ? field_count : 1;
+   while(!try_index_size(buff->diffs, max_diff, size))
+   {
+      ++size;
+   }
+   memset(buff->diffs, 0, max_diff + 1);
+   *index_size = size;
+   FIXFieldDescr** index = (FIXFieldDescr**)calloc(size, sizeof(FIXFieldDescr*));
+   for(uint32_t i = 0; i < field_count; ++i)
+   {
+      FIXFieldDescr* fld = &fields[i];
+      index[(uint32_t)fld->type->tag % size] = fld; // field with duplicated tag overrides previous one
+      if (fld->group_count)
+      {
+         fld->group_index = build_index(fld->group, fld->group_count, &fld->group_index_size, buff);
+         fld->group_required = (uint64_t*)calloc(REQUIRED_WORDS(fld->group_count), sizeof(uint64_t));
+         fix_protocol_init_required(fld->group, fld->group_count, fld->group_required);
+      }
+   }
+   return index;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static FIXMsgDescr* load_message(xmlNode const* msg_node, ComponentIndex* components,
+      FIXFieldType* (*ftypes)[FIELD_TYPE_CNT], FIXError** error)
+{
+   FIXMsgDescr* msg = (FIXMsgDescr*)calloc(1, sizeof(FIXMsgDescr));
+   msg->name = _strdup(get_attr(msg_node, "name", NULL));
+   msg->type = _strdup(get_attr(msg_node, "type", NULL));
+   msg->field_count = count_msg_fields(msg_node, components);
+   msg->fields = (FIXFieldDescr*)calloc(msg->field_count, sizeof(FIXFieldDescr));
+   uint32_t count = 0;
+   if (FIX_FAILED == load_fields(msg->fields, &count, msg_node, components, ftypes, error))
+   {
+      fix_protocol_free_msg_descr(msg);
+      return NULL;
+   }
+   assert(count == msg->field_count);
+   if (FIX_FAILED == link_data_fields(msg->fields, msg->field_count, error))
+   {
+      fix_protocol_free_msg_descr(msg);
+      return NULL;
+   }
+   IndexBuffer buff = {};
+   msg->field_index = build_index(msg->fields, msg->field_count, &msg->field_index_size, &buff);
+   msg->required = (uint64_t*)calloc(REQUIRED_WORDS(msg->field_count), sizeof(uint64_t));
+   fix_protocol_init_required(msg->fields, msg->field_count, msg->required);
+   msg->data_len_count = fix_protocol_init_data_lens(msg->fields, msg->field_count, NULL);
+   if (msg->data_len_count)
+   {
+      msg->data_lens = (FIXTagNum*)calloc(msg->data_len_count * 2, sizeof(FIXTagNum));
+      fix_protocol_init_data_lens(msg->fields, msg->field_count, msg->data_lens);
+   }
+   free(buff.tags);
+   free(buff.diffs);
+   return msg;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static int32_t load_messages(FIXProtocolDescr* prot, FIXFieldType* (*ftypes)[FIELD_TYPE_CNT], xmlNode const* root,
+      FIXError** error)
+{
+   ComponentIndex components;
+   build_component_index(&components, get_first(root, "components"));
+   xmlNode* msg_node = get_first(get_first(root, "messages"), "message");
+   while(msg_node)
+   {
+      if (msg_node->type == XML_ELEMENT_NODE && !strcmp((char const*)msg_node->name, "message"))
+      {
+         FIXMsgDescr* msg = load_message(msg_node, &components, ftypes, error);
+         if (!msg)
+         {
+            free_component_index(&components);
+            return FIX_FAILED;
+         }
+         int32_t idx = fix_utils_hash_string(msg->type, strlen(msg->type)) % MSG_CNT;
+         msg->next = prot->messages[idx];
+         prot->messages[idx] = msg;
+      }
+      msg_node = msg_node->next;
+   }
+   free_component_index(&components);
+   return FIX_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void index_field_types_by_tag(FIXProtocolDescr* prot, FIXFieldType* (*ftypes)[FIELD_TYPE_CNT])
+{
+   for(int32_t i = 0; i < FIELD_TYPE_CNT; ++i)
+   {
+      for(FIXFieldType* ft = (*ftypes)[i]; ft; ft = ft->next)
+      {
+         if (ft->tag >= 0 && (uint32_t)ft->tag < prot->tag_types_count)
+         {
+            prot->tag_types[ft->tag] = ft;
+         }
+      }
+   }
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void build_tag_index(FIXProtocolDescr* prot)
+{
+   FIXTagNum max_tag = 0;
+   for(int32_t i = 0; i < FIELD_TYPE_CNT; ++i)
+   {
+      for(FIXFieldType const* ft = prot->transport_field_types[i]; ft; ft = ft->next)
+      {
+         max_tag = ft->tag > max_tag ? ft->tag : max_tag;
+      }
+      for(FIXFieldType const* ft = prot->field_types[i]; ft; ft = ft->next)
+      {
+         max_tag = ft->tag > max_tag ? ft->tag : max_tag;
+      }
+   }
+   prot->tag_types_count = max_tag + 1;
+   prot->tag_types = (FIXFieldType**)calloc(prot->tag_types_count, sizeof(FIXFieldType*));
+   index_field_types_by_tag(prot, &prot->transport_field_types);
+   index_field_types_by_tag(prot, &prot->field_types); // application types override transport ones
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static int32_t load_transport_protocol(FIXProtocolDescr* prot, xmlNode* parentRoot, char const* parentFile, FIXError** error)
+{
+   int32_t res = FIX_SUCCESS;
+   xmlDoc* doc = NULL;
+   char const* transpFile = get_attr(parentRoot, "transport", parentFile);
+   if(!strcmp(transpFile, parentFile)) // transport is the same as protocol
+   {
+      prot->transportVersion = _strdup(prot->version);
+      goto ok;
+   }
+   char path[PATH_MAX] = {};
+   if (FIX_FAILED == fix_utils_make_path(parentFile, transpFile, path, PATH_MAX))
+   {
+      goto err;
+   }
+   doc = xmlParseFile(path);
+   if (!doc)
+   {
+      *error = fix_error_create(FIX_ERROR_PROTOCOL_XML_LOAD_FAILED, xmlGetLastError()->message);
+      goto err;
+   }
+   if (xml_validate(doc, error) == FIX_FAILED)
+   {
+      goto err;
+   }
+   xmlNode* root = xmlDocGetRootElement(doc);
+   prot->transportVersion = _strdup(get_attr(root, "version", NULL));
+   if (!strcmp(prot->version, prot->transportVersion)) // versions are the same, no need to process transport protocol
+   {
+      goto ok;
+   }
+   if (!root)
+   {
+      *error = fix_error_create(FIX_ERROR_PROTOCOL_XML_LOAD_FAILED, xmlGetLastError()->message);
+      goto err;
+   }
+   if (load_field_types(&prot->transport_field_types, root, error) == FIX_FAILED)
+   {
+      goto err;
+   }
+   if (load_messages(prot, &prot->transport_field_types, root, error) == FIX_FAILED)
+   {
+      goto err;
+   }
+   goto ok;
+err:
+   res = FIX_FAILED;
+ok:
+   if (doc)
+   {
+      xmlFreeDoc(doc);
+   }
+   return res;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+/* PUBLICS                                                                                                               */
+/*-----------------------------------------------------------------------------------------------------------------------*/
+FIXProtocolDescr const* fix_protocol_descr_create(char const* file, FIXError** error)
+{
+   FIXProtocolDescr* prot = NULL;
+   initLibXml(error);
+   xmlDoc* doc = xmlParseFile(file);
+   if (!doc)
+   {
+      *error = fix_error_create(FIX_ERROR_PROTOCOL_XML_LOAD_FAILED, xmlGetLastError()->message);
+      goto err;
+   }
+   if (xml_validate(doc, error) == FIX_FAILED)
+   {
+      goto err;
+   }
+   xmlNode* root = xmlDocGetRootElement(doc);
+   if (!root)
+   {
+      *error = fix_error_create(FIX_ERROR_PROTOCOL_XML_LOAD_FAILED, xmlGetLastError()->message);
+      goto err;
+   }
+   prot = (FIXProtocolDescr*)calloc(1, sizeof(FIXProtocolDescr));
+   prot->ref_count = 1;
+   prot->version = _strdup(get_attr(root, "version", NULL));
+   if (prot && load_transport_protocol(prot, root, file, error) == FIX_FAILED)
+   {
+      goto err;
+   }
+   else if (load_field_types(&prot->field_types, root, error) == FIX_FAILED)
+   {
+      goto err;
+   }
+   else if (load_messages(prot, &prot->field_types, root, error) == FIX_FAILED)
+   {
+      goto err;
+   }
+   build_tag_index(prot);
+   goto ok;
+err:
+   if (prot)
+   {
+      free(prot);
+      prot = NULL;
+   }
+ok:
+   if (doc)
+   {
+      xmlFreeDoc(doc);
+   }
+   return prot;
+}
+
+#endif /* FIX_PARSER_WITHOUT_XML */
@@ -0,0 +1,220 @@
+/**
+ * @file   fix_stream_parser.c
+ * @author Dmitry S. Melnikov, dmitryme@gmail.com
+ * @date   Created on: 10/16/2026 11:02:17 AM
+ */
+
+#include "fix_parser.h"
+#include "fix_parser_priv.h"
+#include "fix_utils.h"
+#include "fix_error_priv.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void fix_stream_parser_reset(FIXStreamParser* sparser)
+{
+   sparser->buff_len = 0;
+   sparser->msg_begin = sparser->chunk_pos;
+   sparser->msg_len = 0;
+   sparser->hdr_len = 0;
+   sparser->field_pos = 0;
+   sparser->field = 0;
+   sparser->body_len = 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode fix_stream_parser_append(FIXStreamParser* sparser, char const* data, uint32_t len, FIXError** error)
+{
+   if (sparser->buff_len + len > sparser->buff_size)
+   {
+      uint32_t size = sparser->buff_size * 2;
+      if (size < sparser->buff_len + len)
+      {
+         size = sparser->buff_len + len;
+      }
+      char* buff = (char*)realloc(sparser->buff, size);
+      if (!buff) // old buffer is still owned by stream parser
+      {
+         *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate %u bytes for message.", size);
+         return FIX_FAILED;
+      }
+      sparser->buff = buff;
+      sparser->buff_size = size;
+   }
+   memcpy(sparser->buff + sparser->buff_len, data, len);
+   sparser->buff_len += len;
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+/* process BeginString and BodyLength fields byte by byte. Header is short, so it is cheaper than searching of delimiter */
+static FIXErrCode fix_stream_parser_scan_header(FIXStreamParser* sparser, FIXError** error)
+{
+   while(sparser->chunk_pos < sparser->chunk_len)
+   {
+      char const ch = sparser->chunk[sparser->chunk_pos++];
+      ++sparser->hdr_len;
+      if (UNLIKE(sparser->skip)) // resynchronization after error
+      {
+         if (ch == sparser->delimiter)
+         {
+            sparser->skip = 0;
+            fix_stream_parser_reset(sparser);
+         }
+         continue;
+      }
+      uint32_t const pos = sparser->field_pos++;
+      if (sparser->field == 0) // BeginString
+      {
+         if ((pos == 0 && ch != '8') || (pos == 1 && ch != '='))
+         {
+            *error = fix_error_create(FIX_ERROR_WRONG_FIELD, "First field must be BeginString.");
+            goto err;
+         }
+         if (pos > 1 && ch == sparser->delimiter)
+         {
+            sparser->field = 1;
+            sparser->field_pos = 0;
+         }
+      }
+      else // BodyLength
+      {
+         if ((pos == 0 && ch != '9') || (pos == 1 && ch != '='))
+         {
+            *error = fix_error_create(FIX_ERROR_WRONG_FIELD, "Second field must be BodyLength.");
+            goto err;
+         }
+         if (pos > 1)
+         {
+            if (ch == sparser->delimiter && pos > 2)
+            {
+               uint32_t const maxMsgSize = sparser->parser->attrs.maxMsgSize;
+               if (sparser->body_len > maxMsgSize || sparser->hdr_len + sparser->body_len + CRC_FIELD_LEN > maxMsgSize)
+               {
+                  *error = fix_error_create(FIX_ERROR_TOO_BIG_MSG, "Message is too big. MaxMsgSize = %u, BodyLength = %u",
+                        maxMsgSize, sparser->body_len);
+                  goto err;
+               }
+               sparser->msg_len = sparser->hdr_len + sparser->body_len + CRC_FIELD_LEN;
+               return FIX_SUCCESS;
+            }
+            if (ch < '0' || ch > '9' || sparser->body_len > (UINT32_MAX - CRC_FIELD_LEN) / 100)
+            {
+               *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "BodyLength value not a number.");
+               goto err;
+            }
+            sparser->body_len = sparser->body_len * 10 + (ch - '0');
+         }
+      }
+   }
+   return FIX_SUCCESS;
+err:
+   sparser->skip = (sparser->chunk[sparser->chunk_pos - 1] != sparser->delimiter);
+   fix_stream_parser_reset(sparser);
+   return FIX_FAILED;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXStreamParser* fix_stream_parser_create(FIXParser* parser, char delimiter, FIXError** error)
+{
+   if (!parser)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Parser is NULL.");
+      return NULL;
+   }
+   FIXStreamParser* sparser = (FIXStreamParser*)calloc(1, sizeof(FIXStreamParser));
+   sparser->parser = parser;
+   sparser->delimiter = delimiter;
+   return sparser;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API void fix_stream_parser_free(FIXStreamParser* sparser)
+{
+   if (sparser)
+   {
+      free(sparser->buff);
+      free(sparser);
+   }
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_stream_parser_feed(FIXStreamParser* sparser, char const* data, uint32_t len, FIXError** error)
+{
+   if (!sparser || !data)
+   {
+      return FIX_FAILED;
+   }
+   if (sparser->chunk_pos < sparser->chunk_len)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Previous data chunk is not processed yet.");
+      return FIX_FAILED;
+   }
+   sparser->chunk = data;
+   sparser->chunk_len = len;
+   sparser->chunk_pos = 0;
+   sparser->msg_begin = 0;
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXMsg* fix_stream_parser_next(FIXStreamParser* sparser, FIXError** error)
+{
+   if (!sparser)
+   {
+      return NULL;
+   }
+   if (!sparser->msg_len && FIX_FAILED == fix_stream_parser_scan_header(sparser, error))
+   {
+      return NULL;
+   }
+   if (sparser->msg_len)
+   {
+      char const* data = NULL;
+      if (!sparser->buff_len) // whole message can be in current chunk, so parse it in place
+      {
+         if (sparser->chunk_len - sparser->msg_begin >= sparser->msg_len)
+         {
+            data = sparser->chunk + sparser->msg_begin;
+            sparser->chunk_pos = sparser->msg_begin + sparser->msg_len;
+         }
+      }
+      else
+      {
+         uint32_t const need = sparser->msg_len - sparser->buff_len - (sparser->chunk_pos - sparser->msg_begin);
+         if (sparser->chunk_len - sparser->chunk_pos >= need)
+         {
+            sparser->chunk_pos += need;
+            if (FIX_FAILED == fix_stream_parser_append(
+                     sparser, sparser->chunk + sparser->msg_begin, sparser->chunk_pos - sparser->msg_begin, error))
+            {
+               fix_stream_parser_reset(sparser);
+               return NULL;
+            }
+            data = sparser->buff;
+         }
+      }
+      if (data)
+      {
+         char const* stop = NULL;
+         FIXMsg* msg = fix_parser_str_to_msg(sparser->parser, data, sparser->msg_len, sparser->delimiter, &stop, error);
+         fix_stream_parser_reset(sparser);
+         return msg;
+      }
+   }
+   // chunk is over, but message is not complete, so save its beginning for the next chunk
+   FIXErrCode res = FIX_SUCCESS;
+   if (!sparser->skip)
+   {
+      res = fix_stream_parser_append(sparser, sparser->chunk + sparser->msg_begin, sparser->chunk_len - sparser->msg_begin, error);
+   }
+   sparser->chunk_pos = sparser->msg_begin = sparser->chunk_len;
+   if (res == FIX_FAILED) // message is lost, skip its rest in the next chunk
+   {
+      fix_stream_parser_reset(sparser);
+      sparser->skip = 1;
+   }
+   return NULL;
+}
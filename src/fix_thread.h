@@ -0,0 +1,126 @@
+/**
+ * @file   fix_thread.h
+ * @author Dmitry S. Melnikov, dmitryme@gmail.com
+ * @date   Created on: 10/16/2026 02:12:40 PM
+ */
+
+#ifndef FIX_PARSER_FIX_THREAD_H
+#define FIX_PARSER_FIX_THREAD_H
+
+#include "fix_types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct FIXThread_ FIXThread;
+typedef struct FIXMutex_ FIXMutex;
+typedef struct FIXCond_ FIXCond;
+
+typedef void (*FIXThreadFunc)(void* arg); ///< thread routine
+
+/**
+ * start new thread
+ * @param[in] func - thread routine
+ * @param[in] arg - argument of thread routine
+ * @return new thread, NULL - thread is not started
+ */
+FIXThread* fix_thread_create(FIXThreadFunc func, void* arg);
+
+/**
+ * wait for thread completion and free it
+ * @param[in] thread - thread to wait
+ */
+void fix_thread_join(FIXThread* thread);
+
+/**
+ * return count of available CPU cores
+ */
+uint32_t fix_thread_cpu_count(void);
+
+/**
+ * return small number of calling thread. Numbers are given sequentially to threads on first call
+ */
+uint32_t fix_thread_index(void);
+
+/**
+ * create new mutex
+ */
+FIXMutex* fix_mutex_create(void);
+
+/**
+ * free mutex
+ */
+void fix_mutex_free(FIXMutex* mutex);
+
+/**
+ * lock mutex
+ */
+void fix_mutex_lock(FIXMutex* mutex);
+
+/**
+ * unlock mutex
+ */
+void fix_mutex_unlock(FIXMutex* mutex);
+
+/**
+ * create new condition variable
+ */
+FIXCond* fix_cond_create(void);
+
+/**
+ * free condition variable
+ */
+void fix_cond_free(FIXCond* cond);
+
+/**
+ * wait for condition. Mutex must be locked
+ */
+void fix_cond_wait(FIXCond* cond, FIXMutex* mutex);
+
+/**
+ * wake up all threads, waiting for condition
+ */
+void fix_cond_broadcast(FIXCond* cond);
+
+/**
+ * atomically increment value
+ * @return incremented value
+ */
+int32_t fix_atomic_inc(int32_t volatile* val);
+
+/**
+ * atomically decrement value
+ * @return decremented value
+ */
+int32_t fix_atomic_dec(int32_t volatile* val);
+
+/**
+ * atomically set value to newVal, if it is equal to oldVal
+ * @return 1 - value is changed, 0 - value is not equal to oldVal
+ */
+int32_t fix_atomic_cas(int32_t volatile* val, int32_t oldVal, int32_t newVal);
+
+/**
+ * set value to zero with release semantic. Used for unlocking of flag, acquired by fix_atomic_cas
+ */
+void fix_atomic_release(int32_t volatile* val);
+
+/**
+ * atomically set pointer to newVal, if it is equal to oldVal
+ * @return 1 - pointer is changed, 0 - pointer is not equal to oldVal
+ */
+int32_t fix_atomic_cas_ptr(void* volatile* ptr, void* oldVal, void* newVal);
+
+/**
+ * atomically exchange pointer value
+ * @return previous pointer value
+ */
+void* fix_atomic_xchg_ptr(void* volatile* ptr, void* val);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FIX_PARSER_FIX_THREAD_H */
@@ -6,10 +6,224 @@
 
 #include "fix_utils.h"
 #include "fix_types.h"
+#include "fix_thread.h"
 
 #include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
 
-#define DOUBLE_MAX_DIGITS 15
+#ifdef FIX_UTILS_HAS_X86_SIMD
+#  include <immintrin.h>
+#endif
+
+#define DOUBLE_EXACT_INT   9007199254740992.0    ///< 2^53, doubles below this have exact integer part
+#define DOUBLE_INT64_LIMIT 9223372036854775808.0  ///< 2^63
+#define DOUBLE_MAX_PRECISION 17                   ///< max fraction digits of fast double formatting
+#define DOUBLE_EXACT_POW10 22                     ///< max power of ten, which is exactly represented by double
+#define DOUBLE_ROUND_TOLERANCE 8.881784197001252e-16 ///< 2^-50, four ulps of relative rounding error
+#define DTOA_BUFF_LEN 700                         ///< enough for any double in fixed notation
+
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#  define FIX_UTILS_SWAR 1 ///< digits are parsed 8 bytes per step, requires little-endian loads
+#endif
+
+typedef char const* (*FindCharFunc)(char const* buff, uint32_t buffLen, char ch);
+typedef uint32_t (*SumBytesFunc)(char const* buff, uint32_t buffLen);
+
+static char const* find_char_resolve(char const* buff, uint32_t buffLen, char ch);
+static uint32_t sum_bytes_resolve(char const* buff, uint32_t buffLen);
+
+static char const digit_pairs[201] =
+   "0001020304050607080910111213141516171819"
+   "2021222324252627282930313233343536373839"
+   "4041424344454647484950515253545556575859"
+   "6061626364656667686970717273747576777879"
+   "8081828384858687888990919293949596979899";
+
+static double const pow10d[DOUBLE_EXACT_POW10 + 1] =
+{
+   1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+   1e21, 1e22
+};
+
+static uint64_t const pow10u[9] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+
+// scanning functions are resolved on first call. They are shared by all threads, so they are changed by atomic stores only
+static int32_t volatile cpu_simd_level = -1;
+static int32_t volatile simd_level = -1;
+static void* volatile find_char = (void*)&find_char_resolve;
+static void* volatile sum_bytes = (void*)&sum_bytes_resolve;
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static char const* find_char_scalar(char const* buff, uint32_t buffLen, char ch)
+{
+   for(; buffLen > 0; --buffLen, ++buff)
+   {
+      if (*buff == ch)
+      {
+         return buff;
+      }
+   }
+   return NULL;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static uint32_t sum_bytes_scalar(char const* buff, uint32_t buffLen)
+{
+   uint32_t sum = 0;
+   for(; buffLen > 0; --buffLen, ++buff)
+   {
+      sum += (unsigned char)*buff;
+   }
+   return sum;
+}
+
+#ifdef FIX_UTILS_HAS_X86_SIMD
+/*-----------------------------------------------------------------------------------------------------------------------*/
+__attribute__((target("sse2")))
+static uint32_t sum_bytes_sse2(char const* buff, uint32_t buffLen)
+{
+   __m128i const zero = _mm_setzero_si128();
+   __m128i acc = zero;
+   for(; buffLen >= 16; buffLen -= 16, buff += 16)
+   {
+      acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_loadu_si128((__m128i const*)buff), zero));
+   }
+   uint32_t const sum = (uint32_t)_mm_cvtsi128_si32(acc) + (uint32_t)_mm_cvtsi128_si32(_mm_unpackhi_epi64(acc, acc));
+   return sum + sum_bytes_scalar(buff, buffLen);
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+__attribute__((target("sse2")))
+static char const* find_char_sse2(char const* buff, uint32_t buffLen, char ch)
+{
+   __m128i const pattern = _mm_set1_epi8(ch);
+   for(; buffLen >= 16; buffLen -= 16, buff += 16)
+   {
+      __m128i const chunk = _mm_loadu_si128((__m128i const*)buff);
+      uint32_t const mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, pattern));
+      if (mask)
+      {
+         return buff + __builtin_ctz(mask);
+      }
+   }
+   return find_char_scalar(buff, buffLen, ch);
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+__attribute__((target("avx2")))
+static char const* find_char_avx2(char const* buff, uint32_t buffLen, char ch)
+{
+   __m256i const pattern = _mm256_set1_epi8(ch);
+   for(; buffLen >= 32; buffLen -= 32, buff += 32)
+   {
+      __m256i const chunk = _mm256_loadu_si256((__m256i const*)buff);
+      uint32_t const mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, pattern));
+      if (mask)
+      {
+         return buff + __builtin_ctz(mask);
+      }
+   }
+   return find_char_sse2(buff, buffLen, ch);
+}
+#endif
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static int32_t detect_simd_level(void)
+{
+   int32_t level = cpu_simd_level;
+   if (level >= 0) // CPU features are detected only once
+   {
+      return level;
+   }
+   level = FIX_SIMD_NONE;
+#ifdef FIX_UTILS_HAS_X86_SIMD
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2"))
+   {
+      level = FIX_SIMD_AVX2;
+   }
+   else if (__builtin_cpu_supports("sse2"))
+   {
+      level = FIX_SIMD_SSE2;
+   }
+#endif
+   fix_atomic_cas(&cpu_simd_level, -1, level);
+   return level;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static char const* find_char_resolve(char const* buff, uint32_t buffLen, char ch)
+{
+   fix_utils_simd_level();
+   return ((FindCharFunc)find_char)(buff, buffLen, ch);
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static uint32_t sum_bytes_resolve(char const* buff, uint32_t buffLen)
+{
+   fix_utils_simd_level();
+   return ((SumBytesFunc)sum_bytes)(buff, buffLen);
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+int32_t fix_utils_simd_level(void)
+{
+   if (simd_level < 0)
+   {
+      fix_utils_set_simd_level(detect_simd_level());
+   }
+   return simd_level;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+int32_t fix_utils_set_simd_level(int32_t level)
+{
+   int32_t const supported = detect_simd_level();
+   if (level > supported)
+   {
+      level = supported;
+   }
+   FindCharFunc findChar = &find_char_scalar;
+   SumBytesFunc sumBytes = &sum_bytes_scalar;
+#ifdef FIX_UTILS_HAS_X86_SIMD
+   if (level == FIX_SIMD_AVX2)
+   {
+      findChar = &find_char_avx2;
+      sumBytes = &sum_bytes_sse2;
+   }
+   else if (level == FIX_SIMD_SSE2)
+   {
+      findChar = &find_char_sse2;
+      sumBytes = &sum_bytes_sse2;
+   }
+   else
+#endif
+   {
+      level = FIX_SIMD_NONE;
+   }
+   fix_atomic_xchg_ptr(&find_char, (void*)findChar);
+   fix_atomic_xchg_ptr(&sum_bytes, (void*)sumBytes);
+   int32_t old = 0;
+   do // level is published after functions, so caller of fix_utils_simd_level never sees unresolved ones
+   {
+      old = simd_level;
+   }
+   while(!fix_atomic_cas(&simd_level, old, level));
+   return level;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+char const* fix_utils_find_char(char const* buff, uint32_t buffLen, char ch)
+{
+   return ((FindCharFunc)find_char)(buff, buffLen, ch);
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+uint32_t fix_utils_sum_bytes(char const* buff, uint32_t buffLen)
+{
+   return ((SumBytesFunc)sum_bytes)(buff, buffLen);
+}
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
 uint32_t fix_utils_hash_string(char const* s, uint32_t len)
@@ -72,120 +286,255 @@ int64_t fix_utils_lpow10(int32_t n)
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
-int32_t fix_utils_i64toa(int64_t val, char* buff, uint32_t buffLen, char padSym)
+static uint32_t u64toa_rev(uint64_t val, char* end)
 {
-   int32_t i = 0;
-   if (val < 0)
+   char* it = end;
+   while(val >= 100)
    {
-      buff[i++] = '-';
-      val = -val;
-      --buffLen;
+      uint32_t const idx = (uint32_t)(val % 100) * 2;
+      val /= 100;
+      it -= 2;
+      it[0] = digit_pairs[idx];
+      it[1] = digit_pairs[idx + 1];
    }
-   int32_t nd = fix_utils_numdigits(val);
-   for(uint32_t len = buffLen - nd; len > 0 && padSym; --len)
+   if (val >= 10)
    {
-      buff[i++] = padSym;
+      it -= 2;
+      it[0] = digit_pairs[val * 2];
+      it[1] = digit_pairs[val * 2 + 1];
    }
-   for(; buffLen && nd; ++i, --nd, --buffLen)
+   else
    {
-      int64_t pow = fix_utils_lpow10(nd - 1);
-      int64_t digit = val/pow;
-      buff[i] = digit + 48;
-      val -= (pow * digit);
+      *--it = '0' + (char)val;
    }
-   return i + nd;
+   return end - it;
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
-int32_t fix_utils_dtoa(double val, char* buff, uint32_t buffLen)
+static inline uint64_t round_u64(double val)
 {
-   int32_t i = 0;
+   uint64_t const m = (uint64_t)val;
+   return (val - (double)m >= 0.5) ? m + 1 : m; // val + 0.5 itself can be rounded up to the next even integer
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static uint32_t fixed_to_str(uint64_t m, uint32_t precision, char* buff)
+{
+   char digits[20];
+   uint32_t const nd = u64toa_rev(m, digits + sizeof(digits));
+   char const* it = digits + sizeof(digits) - nd;
+   if (!precision)
+   {
+      memcpy(buff, it, nd);
+      return nd;
+   }
+   if (nd > precision)
+   {
+      memcpy(buff, it, nd - precision);
+      buff[nd - precision] = '.';
+      memcpy(buff + nd - precision + 1, it + nd - precision, precision);
+      return nd + 1;
+   }
+   buff[0] = '0';
+   buff[1] = '.';
+   memset(buff + 2, '0', precision - nd);
+   memcpy(buff + 2 + precision - nd, it, nd);
+   return precision + 2;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static uint32_t dtoa_slow(double val, char* buff, uint32_t precision)
+{
+   // value is too large or too small for fast path, so look for shortest round-trip precision with libc
+   for(;; ++precision)
+   {
+      uint32_t const len = snprintf(buff, DTOA_BUFF_LEN, "%.*f", precision, val);
+      if (strtod(buff, NULL) == val || len >= DTOA_BUFF_LEN - 1)
+      {
+         return len;
+      }
+   }
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static uint32_t dtoa_shortest(double val, char* buff)
+{
+   if (val == 0)
+   {
+      buff[0] = '0';
+      return 1;
+   }
+   if (val != val || val - val != 0) // NaN and infinity have no FIX representation
+   {
+      return snprintf(buff, DTOA_BUFF_LEN, "%f", val);
+   }
+   uint32_t i = 0;
    if (val < 0)
    {
       buff[i++] = '-';
       val = -val;
-      --buffLen;
    }
-   int64_t m = (int64_t)val;
-   int32_t nd = fix_utils_numdigits(val);
-   int32_t j = nd;
-   for(; buffLen && j; ++i, --j, --buffLen)
+   if (val >= DOUBLE_EXACT_INT)
    {
-      int64_t pow = fix_utils_lpow10(j - 1);
-      int32_t digit = (int32_t)m/pow;
-      buff[i] = digit + 48;
-      m -= (pow * digit);
+      if (val < DOUBLE_INT64_LIMIT)
+      {
+         return i + fixed_to_str((uint64_t)val, 0, buff + i);
+      }
+      return i + dtoa_slow(val, buff + i, 0);
    }
-   i += j;
-   m = (int64_t)(val * fix_utils_lpow10(DOUBLE_MAX_DIGITS - nd)) - (int64_t)val * fix_utils_lpow10(DOUBLE_MAX_DIGITS - nd);
-   if (m)
+   // m and 10^k are exact, so m / 10^k is correctly rounded and equality means that decimal m * 10^-k is read back
+   // as the same double. The first such k gives the shortest fixed notation
+   uint32_t k = 0;
+   for(; k <= DOUBLE_MAX_PRECISION; ++k)
    {
-      if (buffLen)
+      double const scaled = val * pow10d[k];
+      if (scaled >= DOUBLE_EXACT_INT)
+      {
+         break;
+      }
+      uint64_t const m = round_u64(scaled);
+      double const diff = (scaled > (double)m) ? scaled - (double)m : (double)m - scaled;
+      if (diff > scaled * DOUBLE_ROUND_TOLERANCE) // k digits are not enough, product is far from integer
       {
-         buff[i] = '.';
-		 --buffLen;
+         continue;
+      }
+      // scaled is rounded product, so decimal mantissa can be its neighbour
+      uint64_t const candidates[3] = {m, m + 1, m ? m - 1 : m};
+      for(uint32_t c = 0; c < 3; ++c)
+      {
+         if ((double)candidates[c] / pow10d[k] == val)
+         {
+            return i + fixed_to_str(candidates[c], k, buff + i);
+         }
       }
-      ++i;
    }
-   j = DOUBLE_MAX_DIGITS - nd;
-   for(; buffLen && m && j; ++i, --j, --buffLen)
+   return i + dtoa_slow(val, buff + i, k);
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+int32_t fix_utils_i64toa(int64_t val, char* buff, uint32_t buffLen, char padSym)
+{
+   char digits[20];
+   int32_t i = 0;
+   uint64_t uval = (uint64_t)val;
+   if (val < 0)
    {
-      int64_t pow = fix_utils_lpow10(j - 1);
-      int64_t digit = m/pow;
-      buff[i] = digit + 48;
-      m -= (pow * digit);
+      buff[i++] = '-';
+      uval = 0 - uval;
+      buffLen = buffLen ? buffLen - 1 : 0;
    }
-   for(; m && j; ++i, --j)
+   uint32_t const nd = u64toa_rev(uval, digits + sizeof(digits));
+   for(uint32_t len = (buffLen > nd) ? buffLen - nd : 0; len > 0 && padSym; --len)
    {
-      int64_t pow = fix_utils_lpow10(j - 1);
-      int64_t digit = m/pow;
-      m -= (pow * digit);
+      buff[i++] = padSym;
    }
-   return i;
+   memcpy(buff + i, digits + sizeof(digits) - nd, (buffLen < nd) ? buffLen : nd);
+   return i + nd;
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
-FIXErrCode fix_utils_atoi32(char const* buff, uint32_t buffLen, char stopChar, int32_t* val, int32_t* cnt)
+int32_t fix_utils_dtoa(double val, char* buff, uint32_t buffLen)
 {
-   if (stopChar && !buffLen)
-   {
-      return FIX_ERROR_NO_MORE_DATA;
-   }
-   else if (!buff || !buffLen || !val)
+   char tmp[DTOA_BUFF_LEN];
+   uint32_t const len = dtoa_shortest(val, tmp);
+   memcpy(buff, tmp, (buffLen < len) ? buffLen : len);
+   return len;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+int32_t fix_utils_dtoa_fixed(double val, uint32_t precision, char* buff, uint32_t buffLen)
+{
+   char tmp[DTOA_BUFF_LEN];
+   uint32_t len = 0;
+   double const abs_val = (val < 0) ? -val : val;
+   // above 2^53 scaled value is already rounded, so its digits are wrong
+   if (precision <= DOUBLE_MAX_PRECISION && abs_val * pow10d[precision] < DOUBLE_EXACT_INT)
    {
-      return FIX_ERROR_INVALID_ARGUMENT;
+      uint64_t const m = round_u64(abs_val * pow10d[precision]);
+      if (val < 0 && m)
+      {
+         tmp[len++] = '-';
+      }
+      len += fixed_to_str(m, precision, tmp + len);
    }
-   *val = 0;
-   *cnt = 0;
-   int32_t sign = 1;
-   if (buff[*cnt] == '-')
+   else
    {
-      sign = -1;
-      ++(*cnt);
+      len = snprintf(tmp, sizeof(tmp), "%.*f", precision > DTOA_BUFF_LEN / 2 ? DTOA_BUFF_LEN / 2 : precision, val);
    }
-   for(;*cnt < buffLen; ++(*cnt))
+   memcpy(buff, tmp, (buffLen < len) ? buffLen : len);
+   return len;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+uint32_t fix_utils_ctz64(uint64_t val)
+{
+#ifdef _MSC_VER
+   unsigned long idx = 0;
+   _BitScanForward64(&idx, val);
+   return idx;
+#else
+   return __builtin_ctzll(val);
+#endif
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+// parses digits up to first non-digit, 8 bytes per step while they are available. Value is accumulated modulo 2^64, as digit by digit parsing does
+static inline uint32_t parse_digits(char const* buff, uint32_t pos, uint32_t end, uint64_t* val, uint32_t* nd)
+{
+#ifdef FIX_UTILS_SWAR
+   while(end - pos >= 8)
    {
-      if (stopChar && stopChar == buff[*cnt])
+      uint64_t x = 0;
+      memcpy(&x, buff + pos, 8);
+      x ^= 0x3030303030303030ULL; // digits become 0..9
+      uint64_t const non_digits = ((((x & 0x7F7F7F7F7F7F7F7FULL) + 0x7676767676767676ULL) | x) & 0x8080808080808080ULL);
+      uint32_t const d = non_digits ? fix_utils_ctz64(non_digits) / 8 : 8;
+      if (d)
       {
-         break;
+         x <<= (8 - d) * 8; // drop non-digits, missing leading digits become zeros
+         x = (x * 10) + (x >> 8);
+         x = (((x & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+              (((x >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+         *val = *val * pow10u[d] + x;
+         *nd += d;
+         pos += d;
       }
-      if (buff[*cnt] < '0' || buff[*cnt] > '9')
+      if (d < 8)
       {
-         return FIX_ERROR_INVALID_ARGUMENT;
+         return pos;
       }
-      *val = *val * 10 + (buff[*cnt] - 48);
    }
-   if (stopChar && *cnt == buffLen)
+#endif
+   for(; pos < end && buff[pos] >= '0' && buff[pos] <= '9'; ++pos, ++(*nd)) // less than 8 bytes left
+   {
+      *val = *val * 10 + (buff[pos] - '0');
+   }
+   return pos;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static inline FIXErrCode parse_integer(char const* buff, uint32_t buffLen, char stopChar, uint64_t* val, int32_t* neg, int32_t* cnt)
+{
+   uint32_t pos = 0;
+   uint32_t nd = 0;
+   *neg = (buff[0] == '-');
+   *val = 0;
+   pos = parse_digits(buff, *neg, buffLen, val, &nd);
+   *cnt = pos;
+   if (pos < buffLen && (!stopChar || buff[pos] != stopChar))
+   {
+      return FIX_ERROR_INVALID_ARGUMENT;
+   }
+   if (stopChar && pos == buffLen)
    {
       *val = 0;
       return FIX_ERROR_NO_MORE_DATA;
    }
-   *val *= sign;
    return FIX_SUCCESS;
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
-FIXErrCode fix_utils_atoi64(char const* buff, uint32_t buffLen, char stopChar, int64_t* val, int32_t* cnt)
+FIXErrCode fix_utils_atoi32(char const* buff, uint32_t buffLen, char stopChar, int32_t* val, int32_t* cnt)
 {
    if (stopChar && !buffLen)
    {
@@ -195,32 +544,48 @@ FIXErrCode fix_utils_atoi64(char const* buff, uint32_t buffLen, char stopChar, i
    {
       return FIX_ERROR_INVALID_ARGUMENT;
    }
-   *val = 0;
-   *cnt = 0;
-   int64_t sign = 1;
-   if (buff[*cnt] == '-')
+   uint64_t res = 0;
+   int32_t neg = 0;
+   FIXErrCode const err = parse_integer(buff, buffLen, stopChar, &res, &neg, cnt);
+   *val = (int32_t)(uint32_t)((err == FIX_SUCCESS && neg) ? 0 - res : res);
+   return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+FIXErrCode fix_utils_atoi64(char const* buff, uint32_t buffLen, char stopChar, int64_t* val, int32_t* cnt)
+{
+   if (stopChar && !buffLen)
    {
-      sign = -1;
-      ++(*cnt);
+      return FIX_ERROR_NO_MORE_DATA;
    }
-   for(;*cnt < buffLen; ++(*cnt))
+   else if (!buff || !buffLen || !val)
    {
-      if (stopChar && stopChar == buff[*cnt])
-      {
-         break;
-      }
-      if (buff[*cnt] < '0' || buff[*cnt] > '9')
-      {
-         return FIX_ERROR_INVALID_ARGUMENT;
-      }
-      *val = *val * 10 + (buff[*cnt] - 48);
+      return FIX_ERROR_INVALID_ARGUMENT;
    }
-   if (stopChar && *cnt == buffLen)
+   uint64_t res = 0;
+   int32_t neg = 0;
+   FIXErrCode const err = parse_integer(buff, buffLen, stopChar, &res, &neg, cnt);
+   *val = (int64_t)((err == FIX_SUCCESS && neg) ? 0 - res : res);
+   return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+// correctly rounded conversion of long mantissa with libc. Digits are copied, because buffer isn't zero-terminated
+static FIXErrCode atod_slow(char const* buff, uint32_t len, double* val)
+{
+   char tmp[DTOA_BUFF_LEN];
+   char* str = (len < sizeof(tmp)) ? tmp : (char*)malloc(len + 1);
+   if (!str)
    {
-      *val = 0;
-      return FIX_ERROR_NO_MORE_DATA;
+      return FIX_FAILED;
+   }
+   memcpy(str, buff, len);
+   str[len] = 0;
+   *val = strtod(str, NULL);
+   if (str != tmp)
+   {
+      free(str);
    }
-   *val *= sign;
    return FIX_SUCCESS;
 }
 
@@ -235,50 +600,41 @@ FIXErrCode fix_utils_atod(char const* buff, uint32_t buffLen, char stopChar, dou
    {
       return FIX_ERROR_INVALID_ARGUMENT;
    }
-   *val = 0.0;
-   *cnt = 0;
-   int32_t sign = 1;
-   if (buff[*cnt] == '-')
+   int32_t const neg = (buff[0] == '-');
+   uint64_t m = 0; // integer and fraction digits together
+   uint32_t int_digits = 0;
+   uint32_t frac_digits = 0;
+   uint32_t const int_begin = neg;
+   uint32_t pos = parse_digits(buff, int_begin, buffLen, &m, &int_digits);
+   uint32_t const frac_begin = pos + 1;
+   if (pos < buffLen && buff[pos] == '.')
    {
-      sign = -1;
-      ++(*cnt);
+      pos = parse_digits(buff, frac_begin, buffLen, &m, &frac_digits);
    }
-   for(; *cnt < buffLen; ++(*cnt))
+   *cnt = pos;
+   if (pos < buffLen && (!stopChar || buff[pos] != stopChar))
    {
-      if (stopChar && stopChar == buff[*cnt])
-      {
-         break;
-      }
-      if (buff[*cnt] == '.')
-      {
-         ++(*cnt);
-         break;
-      }
-      if ((buff[*cnt] < '0' || buff[*cnt] > '9'))
-      {
-         return FIX_FAILED;
-      }
-      *val = *val * 10 + (buff[*cnt] - 48);
+      *val = 0.0;
+      return FIX_FAILED;
    }
-   double exp = 0.0;
-   for(int32_t j = 1;*cnt < buffLen; ++(*cnt), ++j)
-   {
-      if (stopChar && stopChar == buff[*cnt])
-      {
-         break;
-      }
-      if ((buff[*cnt] < '0' || buff[*cnt] > '9'))
-      {
-         return FIX_FAILED;
-      }
-      exp += (double)(buff[*cnt] - 48) / fix_utils_lpow10(j);
-   }
-   if (stopChar && *cnt == buffLen)
+   if (stopChar && pos == buffLen)
    {
       *val = 0;
       return FIX_ERROR_NO_MORE_DATA;
    }
-   *val += exp;
-   *val *= sign;
+   // both operands are exact, so single division is correctly rounded. 19 digits never overflow m
+   if (LIKE(int_digits + frac_digits <= 19 && m < (uint64_t)DOUBLE_EXACT_INT && frac_digits <= DOUBLE_EXACT_POW10))
+   {
+      *val = (double)m / pow10d[frac_digits];
+   }
+   else if (atod_slow(buff + int_begin, pos - int_begin, val) == FIX_FAILED)
+   {
+      *val = 0.0;
+      return FIX_ERROR_MALLOC;
+   }
+   if (neg)
+   {
+      *val = -*val;
+   }
    return FIX_SUCCESS;
 }
@@ -19,11 +19,49 @@
 #  define PATH_MAX 4096
 #endif
 
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#  define FIX_UTILS_HAS_X86_SIMD 1 ///< SSE2/AVX2 kernels are compiled in and selected at runtime
+#endif
+
+#define FIX_SIMD_NONE 0 ///< scalar byte-by-byte scanning
+#define FIX_SIMD_SSE2 1 ///< 16 bytes per iteration
+#define FIX_SIMD_AVX2 2 ///< 32 bytes per iteration
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+/**
+ * return SIMD level used by scanning functions. On first call level is detected by CPU features
+ * @return one of FIX_SIMD_* values
+ */
+int32_t fix_utils_simd_level(void);
+
+/**
+ * force SIMD level used by scanning functions. Used by benchmarks and tests to compare kernels
+ * @param[in] level - one of FIX_SIMD_* values
+ * @return level actually set. It can be less than requested, if CPU doesn't support requested level
+ */
+int32_t fix_utils_set_simd_level(int32_t level);
+
+/**
+ * find first occurrence of char in buffer
+ * @param[in] buff - buffer for search
+ * @param[in] buffLen - length of buffer
+ * @param[in] ch - char to find
+ * @return pointer to found char, NULL - char not found
+ */
+char const* fix_utils_find_char(char const* buff, uint32_t buffLen, char ch);
+
+/**
+ * calculate sum of unsigned bytes. Used for FIX CheckSum calculation
+ * @param[in] buff - data
+ * @param[in] buffLen - length of data
+ * @return sum of bytes
+ */
+uint32_t fix_utils_sum_bytes(char const* buff, uint32_t buffLen);
+
 /**
  * calculate string hash value
  * @param[in] s - string for hash calculation
@@ -32,6 +70,13 @@ extern "C"
  */
 uint32_t fix_utils_hash_string(char const* s, uint32_t len);
 
+/**
+ * return number of trailing zero bits
+ * @param[in] val - value, must not be 0
+ * @return index of lowest set bit
+ */
+uint32_t fix_utils_ctz64(uint64_t val);
+
 /**
  * return number of digits. E.g. 10221 -> 5
  * @param[in] val - numeric value
@@ -56,7 +101,7 @@ int64_t fix_utils_lpow10(int32_t n);
 int32_t fix_utils_i64toa(int64_t val, char* buff, uint32_t buffLen, char padSym);
 
 /**
- * convert double to string
+ * convert double to string. Shortest fixed notation, which is read back as the same double
  * @param[in] val - converted value
  * @param[out] buff - buffer with converted value
  * @param[in] buffLen - length of buffer
@@ -65,6 +110,18 @@ int32_t fix_utils_i64toa(int64_t val, char* buff, uint32_t buffLen, char padSym)
  */
 int32_t fix_utils_dtoa(double val, char* buff, uint32_t buffLen);
 
+/**
+ * convert double to string with fixed count of fraction digits, e.g. price with known tick precision. Value is rounded
+ * half away from zero, trailing zeros are kept: 135155.5 with precision 2 -> "135155.50"
+ * @param[in] val - converted value
+ * @param[in] precision - count of fraction digits
+ * @param[out] buff - buffer with converted value
+ * @param[in] buffLen - length of buffer
+ * @return how many characters written (can be written). If this value greater than buffLen, value converted
+ * incompletely
+ */
+int32_t fix_utils_dtoa_fixed(double val, uint32_t precision, char* buff, uint32_t buffLen);
+
 /**
  * convert string to 32-bit number
  * @param[in] buff - string value
@@ -109,6 +166,21 @@ FIXErrCode fix_utils_atod(char const* buff, uint32_t buffLen, char stopChar, dou
  */
 FIXErrCode fix_utils_make_path(char const* protocolFile, char const* transpFile, char* path, uint32_t buffLen);
 
+/**
+ * map whole file into memory read-only. Mapped pages are shared by all processes, which map the same file
+ * @param[in] file - path to file
+ * @param[out] size - size of mapped file
+ * @return pointer to mapped file, NULL - file can't be opened or mapped
+ */
+void const* fix_utils_map_file(char const* file, uint32_t* size);
+
+/**
+ * unmap file, mapped by fix_utils_map_file
+ * @param[in] data - pointer to mapped file
+ * @param[in] size - size of mapped file
+ */
+void fix_utils_unmap_file(void const* data, uint32_t size);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,166 @@
+/* @file   fix_thread_lin.c
+   @author Dmitry S. Melnikov, dmitryme@gmail.com
+   @date   Created on: 10/16/2026 02:12:40 PM
+*/
+
+#include "fix_thread.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+struct FIXThread_
+{
+   pthread_t thread;
+   FIXThreadFunc func;
+   void* arg;
+};
+
+struct FIXMutex_
+{
+   pthread_mutex_t mutex;
+};
+
+struct FIXCond_
+{
+   pthread_cond_t cond;
+};
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void* fix_thread_routine(void* arg)
+{
+   FIXThread* thread = (FIXThread*)arg;
+   thread->func(thread->arg);
+   return NULL;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXThread* fix_thread_create(FIXThreadFunc func, void* arg)
+{
+   FIXThread* thread = (FIXThread*)calloc(1, sizeof(FIXThread));
+   thread->func = func;
+   thread->arg = arg;
+   if (pthread_create(&thread->thread, NULL, &fix_thread_routine, thread))
+   {
+      free(thread);
+      return NULL;
+   }
+   return thread;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_thread_join(FIXThread* thread)
+{
+   pthread_join(thread->thread, NULL);
+   free(thread);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+uint32_t fix_thread_cpu_count(void)
+{
+   long const count = sysconf(_SC_NPROCESSORS_ONLN);
+   return count > 0 ? count : 1;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+uint32_t fix_thread_index(void)
+{
+   static uint32_t volatile last_index = 0;
+   static __thread uint32_t index = 0;
+   if (!index)
+   {
+      index = __sync_add_and_fetch(&last_index, 1);
+   }
+   return index - 1;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXMutex* fix_mutex_create(void)
+{
+   FIXMutex* mutex = (FIXMutex*)calloc(1, sizeof(FIXMutex));
+   pthread_mutex_init(&mutex->mutex, NULL);
+   return mutex;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_mutex_free(FIXMutex* mutex)
+{
+   pthread_mutex_destroy(&mutex->mutex);
+   free(mutex);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_mutex_lock(FIXMutex* mutex)
+{
+   pthread_mutex_lock(&mutex->mutex);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_mutex_unlock(FIXMutex* mutex)
+{
+   pthread_mutex_unlock(&mutex->mutex);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXCond* fix_cond_create(void)
+{
+   FIXCond* cond = (FIXCond*)calloc(1, sizeof(FIXCond));
+   pthread_cond_init(&cond->cond, NULL);
+   return cond;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_cond_free(FIXCond* cond)
+{
+   pthread_cond_destroy(&cond->cond);
+   free(cond);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_cond_wait(FIXCond* cond, FIXMutex* mutex)
+{
+   pthread_cond_wait(&cond->cond, &mutex->mutex);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_cond_broadcast(FIXCond* cond)
+{
+   pthread_cond_broadcast(&cond->cond);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+int32_t fix_atomic_inc(int32_t volatile* val)
+{
+   return __sync_add_and_fetch(val, 1);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+int32_t fix_atomic_dec(int32_t volatile* val)
+{
+   return __sync_sub_and_fetch(val, 1);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+int32_t fix_atomic_cas(int32_t volatile* val, int32_t oldVal, int32_t newVal)
+{
+   return __sync_bool_compare_and_swap(val, oldVal, newVal);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_atomic_release(int32_t volatile* val)
+{
+   __sync_lock_release(val);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+int32_t fix_atomic_cas_ptr(void* volatile* ptr, void* oldVal, void* newVal)
+{
+   return __sync_bool_compare_and_swap(ptr, oldVal, newVal);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void* fix_atomic_xchg_ptr(void* volatile* ptr, void* val)
+{
+   __sync_synchronize(); // __sync_lock_test_and_set is only an acquire barrier
+   return __sync_lock_test_and_set(ptr, val);
+}
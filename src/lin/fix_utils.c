@@ -9,6 +9,10 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIXErrCode fix_utils_make_path(char const* protocolFile, char const* transpFile, char* path, uint32_t buffLen)
@@ -35,3 +39,32 @@ FIXErrCode fix_utils_make_path(char const* protocolFile, char const* transpFile,
    free(protocolFileDup);
    return ret;
 }
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void const* fix_utils_map_file(char const* file, uint32_t* size)
+{
+   int fd = open(file, O_RDONLY);
+   if (fd < 0)
+   {
+      return NULL;
+   }
+   struct stat st;
+   void* data = NULL;
+   if (!fstat(fd, &st) && st.st_size > 0 && (uint64_t)st.st_size <= UINT32_MAX)
+   {
+      data = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+      if (data == MAP_FAILED)
+      {
+         data = NULL;
+      }
+      *size = st.st_size;
+   }
+   close(fd); // mapping holds its own reference to file
+   return data;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_utils_unmap_file(void const* data, uint32_t size)
+{
+   munmap((void*)data, size);
+}
@@ -0,0 +1,166 @@
+/* @file   fix_thread_win.c
+   @author Dmitry S. Melnikov, dmitryme@gmail.com
+   @date   Created on: 10/16/2026 02:12:40 PM
+*/
+
+#include "fix_thread.h"
+
+#include <windows.h>
+#include <stdlib.h>
+
+struct FIXThread_
+{
+   HANDLE thread;
+   FIXThreadFunc func;
+   void* arg;
+};
+
+struct FIXMutex_
+{
+   CRITICAL_SECTION mutex;
+};
+
+struct FIXCond_
+{
+   CONDITION_VARIABLE cond;
+};
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static DWORD WINAPI fix_thread_routine(LPVOID arg)
+{
+   FIXThread* thread = (FIXThread*)arg;
+   thread->func(thread->arg);
+   return 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXThread* fix_thread_create(FIXThreadFunc func, void* arg)
+{
+   FIXThread* thread = (FIXThread*)calloc(1, sizeof(FIXThread));
+   thread->func = func;
+   thread->arg = arg;
+   thread->thread = CreateThread(NULL, 0, &fix_thread_routine, thread, 0, NULL);
+   if (!thread->thread)
+   {
+      free(thread);
+      return NULL;
+   }
+   return thread;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_thread_join(FIXThread* thread)
+{
+   WaitForSingleObject(thread->thread, INFINITE);
+   CloseHandle(thread->thread);
+   free(thread);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+uint32_t fix_thread_cpu_count(void)
+{
+   SYSTEM_INFO info;
+   GetSystemInfo(&info);
+   return info.dwNumberOfProcessors > 0 ? info.dwNumberOfProcessors : 1;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+uint32_t fix_thread_index(void)
+{
+   static LONG volatile last_index = 0;
+   static __declspec(thread) uint32_t index = 0;
+   if (!index)
+   {
+      index = InterlockedIncrement(&last_index);
+   }
+   return index - 1;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXMutex* fix_mutex_create(void)
+{
+   FIXMutex* mutex = (FIXMutex*)calloc(1, sizeof(FIXMutex));
+   InitializeCriticalSection(&mutex->mutex);
+   return mutex;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_mutex_free(FIXMutex* mutex)
+{
+   DeleteCriticalSection(&mutex->mutex);
+   free(mutex);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_mutex_lock(FIXMutex* mutex)
+{
+   EnterCriticalSection(&mutex->mutex);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_mutex_unlock(FIXMutex* mutex)
+{
+   LeaveCriticalSection(&mutex->mutex);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXCond* fix_cond_create(void)
+{
+   FIXCond* cond = (FIXCond*)calloc(1, sizeof(FIXCond));
+   InitializeConditionVariable(&cond->cond);
+   return cond;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_cond_free(FIXCond* cond)
+{
+   free(cond);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_cond_wait(FIXCond* cond, FIXMutex* mutex)
+{
+   SleepConditionVariableCS(&cond->cond, &mutex->mutex, INFINITE);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_cond_broadcast(FIXCond* cond)
+{
+   WakeAllConditionVariable(&cond->cond);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+int32_t fix_atomic_inc(int32_t volatile* val)
+{
+   return InterlockedIncrement((LONG volatile*)val);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+int32_t fix_atomic_dec(int32_t volatile* val)
+{
+   return InterlockedDecrement((LONG volatile*)val);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+int32_t fix_atomic_cas(int32_t volatile* val, int32_t oldVal, int32_t newVal)
+{
+   return InterlockedCompareExchange((LONG volatile*)val, newVal, oldVal) == oldVal;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_atomic_release(int32_t volatile* val)
+{
+   InterlockedExchange((LONG volatile*)val, 0);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+int32_t fix_atomic_cas_ptr(void* volatile* ptr, void* oldVal, void* newVal)
+{
+   return InterlockedCompareExchangePointer(ptr, newVal, oldVal) == oldVal;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void* fix_atomic_xchg_ptr(void* volatile* ptr, void* val)
+{
+   return InterlockedExchangePointer(ptr, val);
+}
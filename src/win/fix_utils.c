@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <memory.h>
+#include <windows.h>
 
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIXErrCode fix_utils_make_path(char const* protocolFile, char const* transpFile, char* path, uint32_t buffLen)
@@ -54,3 +55,33 @@ FIXErrCode fix_utils_make_path(char const* protocolFile, char const* transpFile,
    }
    return FIX_SUCCESS;
 }
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void const* fix_utils_map_file(char const* file, uint32_t* size)
+{
+   HANDLE hfile = CreateFileA(file, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+   if (hfile == INVALID_HANDLE_VALUE)
+   {
+      return NULL;
+   }
+   void const* data = NULL;
+   LARGE_INTEGER fsize;
+   if (GetFileSizeEx(hfile, &fsize) && fsize.QuadPart > 0 && fsize.QuadPart <= UINT32_MAX)
+   {
+      HANDLE hmap = CreateFileMappingA(hfile, NULL, PAGE_READONLY, 0, 0, NULL);
+      if (hmap)
+      {
+         data = MapViewOfFile(hmap, FILE_MAP_READ, 0, 0, 0);
+         CloseHandle(hmap); // view holds its own reference to mapping
+      }
+      *size = (uint32_t)fsize.QuadPart;
+   }
+   CloseHandle(hfile);
+   return data;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_utils_unmap_file(void const* data, uint32_t size)
+{
+   UnmapViewOfFile(data);
+}
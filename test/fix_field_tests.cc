@@ -10,6 +10,7 @@
 #include  <fix_field.h>
 #include  <fix_types.h>
 #include  <fix_protocol_descr.h>
+#include  <fix_thread.h>
 
 #include <gtest/gtest.h>
 #include <stdlib.h>
@@ -29,6 +30,7 @@ FIXFieldDescr* new_fdescr(int tag, FIXFieldCategoryEnum category, FIXFieldValueT
    // it will be leaks, but who cares...
    FIXFieldType* type = (FIXFieldType*)calloc(sizeof(FIXFieldType), 1);
    type->tag = tag;
+   type->prefix_len = sprintf(type->prefix, "%d=", tag);
    type->valueType = valueType;
    FIXFieldDescr* fdescr = (FIXFieldDescr*)calloc(sizeof(FIXFieldDescr), 1);
    fdescr->type = type;
@@ -44,37 +46,38 @@ TEST(FixFieldTests, SetTagTest)
    ASSERT_TRUE(parser != NULL);
 
    FIXMsg* msg = new_fake_message(parser);
+   uint32_t const fieldsLen = 4 + GROUP_FIELDS_INIT * sizeof(FIXField); // fields array is allocated with first field
 
    char const val[] = {"1000"};
    FIXField* field = fix_field_set(msg, NULL, new_fdescr(1, FIXFieldCategory_Value, FIXFieldValueType_String),
          (unsigned char const*)val, strlen(val), &error);
-   ASSERT_EQ(msg->fields->fields[1], field);
+   ASSERT_EQ(&msg->fields->fields[0], field);
+   ASSERT_EQ(msg->fields->field_count, 1U);
+   ASSERT_EQ(msg->fields->field_size, (uint32_t)GROUP_FIELDS_INIT);
    ASSERT_TRUE(field->descr != NULL);
+   ASSERT_EQ(field->tag, 1);
    ASSERT_EQ(field->descr->type->tag, 1);
    ASSERT_EQ(field->descr->category, FIXFieldCategory_Value);
-   ASSERT_TRUE(field->next == NULL);
    ASSERT_TRUE(!strncmp((char const*)field->data, val, strlen(val)));
    ASSERT_EQ(field->size, strlen(val));
 
    ASSERT_EQ(msg->curr_page->size, 512U);
-   ASSERT_EQ(msg->curr_page->offset, 4 + sizeof(FIXField) + 4 + strlen(val));
+   ASSERT_EQ(msg->curr_page->offset, fieldsLen + 4 + strlen(val));
    ASSERT_TRUE(msg->curr_page->next == NULL);
 
    FIXField* field11 = fix_field_set(msg, NULL, new_fdescr(2, FIXFieldCategory_Value, FIXFieldValueType_String),
          (unsigned char const*)val, strlen(val), &error);
-   ASSERT_EQ(msg->fields->fields[2], field11);
+   ASSERT_EQ(&msg->fields->fields[1], field11);
    ASSERT_EQ(field11->descr->type->tag, 2);
    ASSERT_EQ(field11->descr->category, FIXFieldCategory_Value);
-   ASSERT_TRUE(field11->next == NULL);
    ASSERT_TRUE(!strncmp((char const*)field11->data, val, strlen(val)));
    ASSERT_EQ(field11->size, strlen(val));
 
    FIXField* field12 = fix_field_set(msg, NULL, new_fdescr(30, FIXFieldCategory_Value, FIXFieldValueType_String),
          (unsigned char const*)val, strlen(val), &error);
-   ASSERT_EQ(msg->fields->fields[30], field12);
+   ASSERT_EQ(&msg->fields->fields[2], field12);
    ASSERT_EQ(field12->descr->type->tag, 30);
    ASSERT_EQ(field12->descr->category, FIXFieldCategory_Value);
-   ASSERT_TRUE(field12->next == NULL);
    ASSERT_TRUE(!strncmp((char const*)field12->data, val, strlen(val)));
    ASSERT_EQ(field12->size, strlen(val));
 
@@ -82,14 +85,14 @@ TEST(FixFieldTests, SetTagTest)
    FIXField* field1 = fix_field_set(msg, NULL, new_fdescr(1, FIXFieldCategory_Value, FIXFieldValueType_String),
          (unsigned char const*)val1, strlen(val1), &error);
    ASSERT_EQ(field, field1);
+   ASSERT_EQ(msg->fields->field_count, 3U);
    ASSERT_EQ(field1->descr->type->tag, 1);
    ASSERT_EQ(field1->descr->category, FIXFieldCategory_Value);
-   ASSERT_TRUE(field1->next == NULL);
    ASSERT_TRUE(!strncmp((char const*)field1->data, val1, strlen(val1)));
    ASSERT_EQ(field1->size, strlen(val1));
 
    ASSERT_EQ(msg->curr_page->size, 512U);
-   ASSERT_EQ(msg->curr_page->offset, 3 * (4 + sizeof(FIXField)) + 4 + strlen(val1) + 4 + strlen(val) + 4 + strlen(val));
+   ASSERT_EQ(msg->curr_page->offset, fieldsLen + 4 + strlen(val1) + 4 + strlen(val) + 4 + strlen(val));
    ASSERT_TRUE(msg->curr_page->next == NULL);
 
    char const val2[] = {"64"};
@@ -98,12 +101,11 @@ TEST(FixFieldTests, SetTagTest)
    ASSERT_EQ(field2, field);
    ASSERT_EQ(field2->descr->type->tag, 1);
    ASSERT_EQ(field2->descr->category, FIXFieldCategory_Value);
-   ASSERT_TRUE(field2->next == NULL);
    ASSERT_TRUE(!strncmp((char const*)field2->data, val2, strlen(val2)));
    ASSERT_EQ(field1->size, strlen(val2));
 
    ASSERT_EQ(msg->curr_page->size, 512U);
-   ASSERT_EQ(msg->curr_page->offset, 3 * (4 + sizeof(FIXField)) + 4 + strlen(val1) + 4 + strlen(val) + 4 + strlen(val));
+   ASSERT_EQ(msg->curr_page->offset, fieldsLen + 4 + strlen(val1) + 4 + strlen(val) + 4 + strlen(val));
    ASSERT_TRUE(msg->curr_page->next == NULL);
 
    char const txt[] = "Hello world!";
@@ -112,12 +114,11 @@ TEST(FixFieldTests, SetTagTest)
    ASSERT_EQ(field3, field);
    ASSERT_EQ(field3->descr->type->tag, 1);
    ASSERT_EQ(field3->descr->category, FIXFieldCategory_Value);
-   ASSERT_TRUE(field3->next == NULL);
    ASSERT_TRUE(!strncmp((char const*)field3->data, txt, strlen(txt)));
    ASSERT_EQ(field3->size, strlen(txt));
 
    ASSERT_EQ(msg->curr_page->size, 512U);
-   ASSERT_EQ(msg->curr_page->offset, 3 * (4 + sizeof(FIXField)) + 4 + strlen(val1) + 4 + strlen(val) + 4 + strlen(val) + 4 + strlen(txt));
+   ASSERT_EQ(msg->curr_page->offset, fieldsLen + 4 + strlen(val1) + 4 + strlen(val) + 4 + strlen(val) + 4 + strlen(txt));
    ASSERT_TRUE(msg->curr_page->next == NULL);
 
    fix_parser_free(parser);
@@ -132,85 +133,75 @@ TEST(FixFieldTests, DelTagTest)
    ASSERT_TRUE(parser != NULL);
 
    FIXMsg* msg = new_fake_message(parser);
+   uint32_t const fieldsLen = 4 + GROUP_FIELDS_INIT * sizeof(FIXField);
 
    int val = 1000;
    FIXField* field = fix_field_set(msg, NULL, new_fdescr(1, FIXFieldCategory_Value, FIXFieldValueType_Int),
          (unsigned char const*)&val, sizeof(val), &error);
-   ASSERT_EQ(msg->fields->fields[1], field);
+   ASSERT_EQ(&msg->fields->fields[0], field);
    ASSERT_EQ(field->descr->type->tag, 1);
    ASSERT_EQ(field->descr->category, FIXFieldCategory_Value);
-   ASSERT_TRUE(field->next == NULL);
    ASSERT_EQ(*(long*)field->data, val);
 
    ASSERT_EQ(msg->curr_page->size, 512U);
-   ASSERT_EQ(msg->curr_page->offset, 4 + sizeof(FIXField) + 4 + sizeof(val));
+   ASSERT_EQ(msg->curr_page->offset, fieldsLen + 4 + sizeof(val));
    ASSERT_TRUE(msg->curr_page->next == NULL);
 
    uint32_t val1 = 2000;
    FIXField* field1 = fix_field_set(msg, NULL, new_fdescr(65, FIXFieldCategory_Value, FIXFieldValueType_Int),
          (unsigned char const*)&val1, sizeof(val1), &error);
-   ASSERT_EQ(msg->fields->fields[1], field1);
+   ASSERT_EQ(&msg->fields->fields[1], field1);
    ASSERT_EQ(field1->descr->type->tag, 65);
    ASSERT_EQ(field1->descr->category, FIXFieldCategory_Value);
-   ASSERT_EQ(field1->next, field);
    ASSERT_EQ(*(uint64_t*)field1->data, val1);
 
-   ASSERT_EQ(msg->curr_page->size, 512U);
-   ASSERT_EQ(msg->curr_page->offset, 2 * (4 + sizeof(FIXField)) + 4 + sizeof(val) + 4 + sizeof(val1));
-   ASSERT_TRUE(msg->curr_page->next == NULL);
-
    uint32_t val2 = 3000;
    FIXField* field2 = fix_field_set(msg, NULL, new_fdescr(129, FIXFieldCategory_Value, FIXFieldValueType_Int),
          (unsigned char const*)&val2, sizeof(val2), &error);
-   ASSERT_EQ(msg->fields->fields[1], field2);
-   ASSERT_EQ(field2->descr->type->tag, 129);
-   ASSERT_EQ(field2->descr->category, FIXFieldCategory_Value);
-   ASSERT_EQ(field2->next, field1);
-   ASSERT_EQ(*(uint64_t*)field2->data, val2);
-
-   ASSERT_EQ(msg->curr_page->size, 512U);
-   ASSERT_EQ(msg->curr_page->offset, 3 * (4 + sizeof(FIXField)) + 4 + sizeof(val) + 4 + sizeof(val1) + 4 + sizeof(val));
-   ASSERT_TRUE(msg->curr_page->next == NULL);
+   ASSERT_EQ(&msg->fields->fields[2], field2);
 
    int val3 = 4000;
    FIXField* field3 = fix_field_set(msg, NULL, new_fdescr(193, FIXFieldCategory_Value, FIXFieldValueType_Int),
          (unsigned char const*)&val3, sizeof(val3), &error);
-
-   ASSERT_EQ(msg->fields->fields[1], field3);
-   ASSERT_EQ(field3->descr->type->tag, 193);
-   ASSERT_EQ(field3->descr->category, FIXFieldCategory_Value);
-   ASSERT_EQ(field3->next, field2);
-   ASSERT_EQ(*(long*)field3->data, val3);
+   ASSERT_EQ(&msg->fields->fields[3], field3);
+   ASSERT_EQ(msg->fields->field_count, 4U);
 
    ASSERT_EQ(msg->curr_page->size, 512U);
-   ASSERT_EQ(msg->curr_page->offset, 4 * (4 + sizeof(FIXField)) + 4 + sizeof(val) + 4 + sizeof(val) + 4 + sizeof(val1) + 4 + sizeof(val3));
+   ASSERT_EQ(msg->curr_page->offset, fieldsLen + 4 + sizeof(val) + 4 + sizeof(val1) + 4 + sizeof(val2) + 4 + sizeof(val3));
    ASSERT_TRUE(msg->curr_page->next == NULL);
 
    int res = fix_field_del(msg, NULL, 1, &error);
    ASSERT_EQ(res, FIX_SUCCESS);
-   ASSERT_EQ(msg->fields->fields[1], field3);
-   ASSERT_EQ(msg->fields->fields[1]->next, field2);
-   ASSERT_EQ(msg->fields->fields[1]->next->next, field1);
-   ASSERT_TRUE(msg->fields->fields[1]->next->next->next == NULL);
+   ASSERT_EQ(msg->fields->field_count, 3U); // the rest fields keep order of insertion
+   ASSERT_EQ(msg->fields->fields[0].tag, 65);
+   ASSERT_EQ(msg->fields->fields[1].tag, 129);
+   ASSERT_EQ(msg->fields->fields[2].tag, 193);
+   ASSERT_TRUE(fix_field_get(msg, NULL, 1) == NULL);
 
    ASSERT_EQ(msg->curr_page->size, 512U);
-   ASSERT_EQ(msg->curr_page->offset, 4 * (4 + sizeof(FIXField)) + 4 + sizeof(val) + 4 + sizeof(val) + 4 + sizeof(val1) + 4 + sizeof(val3));
+   ASSERT_EQ(msg->curr_page->offset, fieldsLen + 4 + sizeof(val) + 4 + sizeof(val1) + 4 + sizeof(val2) + 4 + sizeof(val3));
    ASSERT_TRUE(msg->curr_page->next == NULL);
 
    res = fix_field_del(msg, msg->fields, 129, &error);
    ASSERT_EQ(res, FIX_SUCCESS);
-   ASSERT_EQ(msg->fields->fields[1], field3);
-   ASSERT_EQ(msg->fields->fields[1]->next, field1);
-   ASSERT_TRUE(msg->fields->fields[1]->next->next == NULL);
+   ASSERT_EQ(msg->fields->field_count, 2U);
+   ASSERT_EQ(msg->fields->fields[0].tag, 65);
+   ASSERT_EQ(msg->fields->fields[1].tag, 193);
 
    res = fix_field_del(msg, msg->fields, 193, &error);
    ASSERT_EQ(res, FIX_SUCCESS);
-   ASSERT_EQ(msg->fields->fields[1], field1);
-   ASSERT_TRUE(msg->fields->fields[1]->next == NULL);
+   ASSERT_EQ(msg->fields->field_count, 1U);
+   ASSERT_EQ(msg->fields->fields[0].tag, 65);
+   ASSERT_EQ(*(uint32_t*)fix_field_get(msg, NULL, 65)->data, val1);
 
    res = fix_field_del(msg, msg->fields, 65, &error);
    ASSERT_EQ(res, FIX_SUCCESS);
-   ASSERT_TRUE(msg->fields->fields[1] == NULL);
+   ASSERT_EQ(msg->fields->field_count, 0U);
+
+   res = fix_field_del(msg, msg->fields, 65, &error);
+   ASSERT_EQ(res, FIX_FAILED);
+   ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_FIELD_NOT_FOUND);
+   fix_error_free(error);
 
    fix_parser_free(parser);
    free(msg);
@@ -225,67 +216,30 @@ TEST(FixFieldTests, GetTagTest)
 
    FIXMsg* msg = new_fake_message(parser);
 
-   long val = 1000;
-   FIXField* field = fix_field_set(msg, NULL, new_fdescr(1, FIXFieldCategory_Value, FIXFieldValueType_String),
-         (unsigned char const*)&val, sizeof(val), &error);
-   ASSERT_EQ(msg->fields->fields[1], field);
-   ASSERT_EQ(field->descr->type->tag, 1);
-   ASSERT_EQ(field->descr->category, FIXFieldCategory_Value);
-   ASSERT_TRUE(field->next == NULL);
-   ASSERT_EQ(*(long*)field->data, val);
-
-   long val1 = 2000;
-   FIXField* field1 = fix_field_set(msg, NULL, new_fdescr(65, FIXFieldCategory_Value, FIXFieldValueType_String),
-         (unsigned char const*)&val1, sizeof(val1), &error);
-   ASSERT_EQ(msg->fields->fields[1], field1);
-   ASSERT_EQ(msg->fields->fields[1]->next, field);
-   ASSERT_EQ(field1->descr->type->tag, 65);
-   ASSERT_EQ(field1->descr->category, FIXFieldCategory_Value);
-   ASSERT_EQ(field1->next, field);
-   ASSERT_EQ(*(long*)field1->data, val1);
-
-   long val2 = 3000;
-   FIXField* field2 = fix_field_set(msg, NULL, new_fdescr(129, FIXFieldCategory_Value, FIXFieldValueType_String),
-         (unsigned char const*)&val2, sizeof(val2), &error);
-   ASSERT_EQ(msg->fields->fields[1], field2);
-   ASSERT_EQ(msg->fields->fields[1]->next, field1);
-   ASSERT_EQ(msg->fields->fields[1]->next->next, field);
-   ASSERT_EQ(field2->descr->type->tag, 129);
-   ASSERT_EQ(field2->descr->category, FIXFieldCategory_Value);
-   ASSERT_EQ(field2->next, field1);
-   ASSERT_EQ(*(long*)field2->data, val2);
-
-   uint64_t val3 = 4000;
-   FIXField* field3 = fix_field_set(msg, NULL, new_fdescr(193, FIXFieldCategory_Value, FIXFieldValueType_String),
-         (unsigned char const*)&val3, sizeof(val3), &error);
-   ASSERT_EQ(msg->fields->fields[1], field3);
-   ASSERT_EQ(msg->fields->fields[1]->next, field2);
-   ASSERT_EQ(msg->fields->fields[1]->next->next, field1);
-   ASSERT_EQ(msg->fields->fields[1]->next->next->next, field);
-   ASSERT_EQ(field3->descr->type->tag, 193);
-   ASSERT_EQ(field3->descr->category, FIXFieldCategory_Value);
-   ASSERT_EQ(field3->next, field2);
-   ASSERT_EQ(*(uint64_t*)field3->data, val3);
-
-   long val4 = 4000;
-   FIXField* field4 = fix_field_set(msg, NULL, new_fdescr(2, FIXFieldCategory_Value, FIXFieldValueType_String),
-         (unsigned char const*)&val4, sizeof(val4), &error);
-   ASSERT_EQ(msg->fields->fields[1], field3);
-   ASSERT_EQ(msg->fields->fields[1]->next, field2);
-   ASSERT_EQ(msg->fields->fields[1]->next->next, field1);
-   ASSERT_EQ(msg->fields->fields[1]->next->next->next, field);
-   ASSERT_EQ(msg->fields->fields[2], field4);
-   ASSERT_EQ(field4->descr->type->tag, 2);
-   ASSERT_EQ(field4->descr->category, FIXFieldCategory_Value);
-   ASSERT_TRUE(field4->next == NULL);
-   ASSERT_EQ(*(long*)field4->data, val4);
-
-   ASSERT_EQ(fix_field_get(msg, msg->fields, 1), field);
-   ASSERT_EQ(fix_field_get(msg, msg->fields, 129), field2);
-   ASSERT_EQ(fix_field_get(msg, msg->fields, 193), field3);
-   ASSERT_EQ(fix_field_get(msg, msg->fields, 2), field4);
-
-   ASSERT_TRUE(fix_field_get(msg, msg->fields, 3) == NULL);
+   FIXTagNum const tags[] = {1, 65, 129, 193, 2, 3, 4, 5, 6, 7, 8}; // more than GROUP_FIELDS_INIT, so fields array grows
+   uint32_t const count = sizeof(tags) / sizeof(tags[0]);
+   for(uint32_t i = 0; i < count; ++i)
+   {
+      long val = 1000 * tags[i];
+      FIXField* field = fix_field_set(msg, NULL, new_fdescr(tags[i], FIXFieldCategory_Value, FIXFieldValueType_String),
+            (unsigned char const*)&val, sizeof(val), &error);
+      ASSERT_TRUE(field != NULL);
+      ASSERT_EQ(field->tag, tags[i]);
+      ASSERT_EQ(field->descr->type->tag, tags[i]);
+      ASSERT_EQ(field->descr->category, FIXFieldCategory_Value);
+      ASSERT_EQ(*(long*)field->data, val);
+   }
+   ASSERT_EQ(msg->fields->field_count, count);
+   ASSERT_EQ(msg->fields->field_size, 2U * GROUP_FIELDS_INIT);
+
+   for(uint32_t i = 0; i < count; ++i)
+   {
+      FIXField* field = fix_field_get(msg, msg->fields, tags[i]);
+      ASSERT_EQ(field, &msg->fields->fields[i]);
+      ASSERT_EQ(*(long*)field->data, 1000 * tags[i]);
+   }
+
+   ASSERT_TRUE(fix_field_get(msg, msg->fields, 9) == NULL);
 
    fix_parser_free(parser);
    free(msg);
@@ -299,6 +253,7 @@ TEST(FixFieldTests, AddGetDelGroupTest)
    ASSERT_TRUE(parser != NULL);
 
    FIXMsg* msg = new_fake_message(parser);
+   FIXPoolCache* cache = &parser->cache[fix_thread_index() % POOL_CACHE_COUNT].cache; // free groups of this thread
 
    FIXField* field = NULL;
    FIXGroup* grp = fix_group_add(msg, NULL, new_fdescr(1, FIXFieldCategory_Group, FIXFieldValueType_NumInGroup), &field, &error);
@@ -323,7 +278,7 @@ TEST(FixFieldTests, AddGetDelGroupTest)
    ASSERT_EQ(msg->used_groups, grp1);
    ASSERT_EQ(msg->used_groups->next, grp);
    ASSERT_EQ(parser->used_groups, 3U);
-   ASSERT_TRUE(parser->group == NULL);
+   ASSERT_TRUE(cache->group == NULL);
 
    FIXField* field2 = NULL;
    FIXGroup* grp2 = fix_group_add(msg, NULL, new_fdescr(1, FIXFieldCategory_Group, FIXFieldValueType_NumInGroup), &field2, &error);
@@ -334,7 +289,7 @@ TEST(FixFieldTests, AddGetDelGroupTest)
    ASSERT_EQ(msg->used_groups->next, grp1);
    ASSERT_EQ(msg->used_groups->next->next, grp);
    ASSERT_EQ(parser->used_groups, 4U);
-   ASSERT_TRUE(parser->group == NULL);
+   ASSERT_TRUE(cache->group == NULL);
 
    FIXField* field3 = NULL;
    FIXGroup* grp3 = fix_group_add(msg, NULL, new_fdescr(1, FIXFieldCategory_Group, FIXFieldValueType_NumInGroup), &field3, &error);
@@ -345,7 +300,7 @@ TEST(FixFieldTests, AddGetDelGroupTest)
    ASSERT_EQ(msg->used_groups->next->next, grp1);
    ASSERT_EQ(msg->used_groups->next->next->next, grp);
    ASSERT_EQ(parser->used_groups, 5U);
-   ASSERT_TRUE(parser->group == NULL);
+   ASSERT_TRUE(cache->group == NULL);
 
    FIXGroup* grp4 = fix_group_get(msg, NULL, 1, 4, &error);
    ASSERT_TRUE(grp4 == NULL);
@@ -364,12 +319,12 @@ TEST(FixFieldTests, AddGetDelGroupTest)
    ASSERT_EQ(grps->group[2], grp2);
    ASSERT_EQ(grps->group[3], grp3);
 
-   ASSERT_TRUE(parser->group == NULL);
+   ASSERT_TRUE(cache->group == NULL);
    ASSERT_EQ(msg->used_groups, grp3);
 
    ASSERT_EQ(fix_group_del(msg, NULL, 1, 3, &error), FIX_SUCCESS);
-   ASSERT_EQ(parser->group, grp3);
-   ASSERT_TRUE(parser->group->next == NULL);
+   ASSERT_EQ(cache->group, grp3);
+   ASSERT_TRUE(cache->group->next == NULL);
    ASSERT_EQ(msg->used_groups, grp2);
    ASSERT_EQ(msg->used_groups->next, grp1);
    ASSERT_EQ(msg->used_groups->next->next, grp);
@@ -382,9 +337,9 @@ TEST(FixFieldTests, AddGetDelGroupTest)
    ASSERT_TRUE(grps->group[3] == NULL);
 
    ASSERT_EQ(fix_group_del(msg, NULL, 1, 1, &error), FIX_SUCCESS);
-   ASSERT_EQ(parser->group, grp1);
-   ASSERT_EQ(parser->group->next, grp3);
-   ASSERT_TRUE(parser->group->next->next == NULL);
+   ASSERT_EQ(cache->group, grp1);
+   ASSERT_EQ(cache->group->next, grp3);
+   ASSERT_TRUE(cache->group->next->next == NULL);
    ASSERT_EQ(msg->used_groups, grp2);
    ASSERT_EQ(msg->used_groups->next, grp);
    ASSERT_TRUE(msg->used_groups->next->next == NULL);
@@ -396,9 +351,9 @@ TEST(FixFieldTests, AddGetDelGroupTest)
    ASSERT_TRUE(grps->group[3] == NULL);
 
    ASSERT_EQ(fix_group_del(msg, NULL, 1, 0, &error), FIX_SUCCESS);
-   ASSERT_EQ(parser->group, grp);
-   ASSERT_EQ(parser->group->next, grp1);
-   ASSERT_EQ(parser->group->next->next, grp3);
+   ASSERT_EQ(cache->group, grp);
+   ASSERT_EQ(cache->group->next, grp1);
+   ASSERT_EQ(cache->group->next->next, grp3);
    ASSERT_EQ(msg->used_groups, grp2);
    ASSERT_TRUE(msg->used_groups->next == NULL);
 
@@ -410,10 +365,10 @@ TEST(FixFieldTests, AddGetDelGroupTest)
 
    ASSERT_EQ(fix_group_del(msg, NULL, 1, 0, &error), FIX_SUCCESS);
    ASSERT_TRUE(fix_field_get(msg, NULL, 1) == NULL);
-   ASSERT_EQ(parser->group, grp2);
-   ASSERT_EQ(parser->group->next, grp);
-   ASSERT_EQ(parser->group->next->next, grp1);
-   ASSERT_EQ(parser->group->next->next->next, grp3);
+   ASSERT_EQ(cache->group, grp2);
+   ASSERT_EQ(cache->group->next, grp);
+   ASSERT_EQ(cache->group->next->next, grp1);
+   ASSERT_EQ(cache->group->next->next->next, grp3);
    ASSERT_TRUE(msg->used_groups == NULL);
 
    fix_parser_free(parser);
@@ -428,6 +383,7 @@ TEST(FixFieldTests, NestedGroupsTest)
    ASSERT_TRUE(parser != NULL);
 
    FIXMsg* msg = new_fake_message(parser);
+   FIXPoolCache* cache = &parser->cache[fix_thread_index() % POOL_CACHE_COUNT].cache; // free groups of this thread
 
    FIXField* field = NULL;
    FIXGroup* grp = fix_group_add(msg, NULL, new_fdescr(1, FIXFieldCategory_Group, FIXFieldValueType_NumInGroup), &field, &error);
@@ -465,15 +421,162 @@ TEST(FixFieldTests, NestedGroupsTest)
    ASSERT_EQ(msg->used_groups, nested_grp);
    ASSERT_EQ(msg->used_groups->next, grp);
    ASSERT_TRUE(msg->used_groups->next->next == NULL);
-   ASSERT_EQ(parser->group, nested_grp1);
+   ASSERT_EQ(cache->group, nested_grp1);
 
    ASSERT_EQ(fix_group_del(msg, NULL, 1, 0, &error), FIX_SUCCESS);
    ASSERT_TRUE(msg->used_groups == NULL);
-   ASSERT_EQ(parser->group, grp);
-   ASSERT_EQ(parser->group->next, nested_grp);
-   ASSERT_EQ(parser->group->next->next, nested_grp1);
-   ASSERT_TRUE(parser->group->next->next->next == NULL);
+   ASSERT_EQ(cache->group, grp);
+   ASSERT_EQ(cache->group->next, nested_grp);
+   ASSERT_EQ(cache->group->next->next, nested_grp1);
+   ASSERT_TRUE(cache->group->next->next->next == NULL);
 
    fix_parser_free(parser);
    free(msg);
 }
+
+TEST(FixFieldTests, SlotTest)
+{
+   FIXError* error = NULL;
+   FIXParserAttrs attrs = {512, 0, 2, 0, 2, 0};
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+
+   FIXMsg* msg = fix_msg_create(parser, "D", &error);
+   ASSERT_TRUE(msg != NULL);
+
+   int32_t slot = fix_field_get_slot(msg, NULL, FIXFieldTag_ClOrdID);
+   ASSERT_GE(slot, 0);
+   ASSERT_EQ(msg->descr->fields[slot].type->tag, FIXFieldTag_ClOrdID);
+   ASSERT_EQ(fix_field_get_slot(msg, NULL, 9999), -1);
+   ASSERT_TRUE(fix_field_get_by_slot(msg, NULL, slot) == NULL);
+
+   char const val[] = "CL_ORD_ID_1";
+   FIXField* field = fix_field_set_by_slot(msg, NULL, slot, (unsigned char const*)val, strlen(val), &error);
+   ASSERT_TRUE(field != NULL);
+   ASSERT_EQ(field, fix_field_get_by_slot(msg, NULL, slot));
+   ASSERT_EQ(field, fix_field_get(msg, NULL, FIXFieldTag_ClOrdID));
+   ASSERT_TRUE(!strncmp(field->data, val, strlen(val)));
+
+   ASSERT_TRUE(fix_field_set_by_slot(msg, NULL, msg->descr->field_count, (unsigned char const*)val, strlen(val), &error) == NULL);
+   ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_INVALID_ARGUMENT);
+   fix_error_free(error);
+   error = NULL;
+
+   // fields after deleted one are shifted, but still available by their slots
+   int32_t const typeSlot = fix_field_get_slot(msg, NULL, FIXFieldTag_MsgType);
+   ASSERT_EQ(fix_field_del(msg, NULL, FIXFieldTag_BeginString, &error), FIX_SUCCESS);
+   ASSERT_EQ(fix_field_get_by_slot(msg, NULL, typeSlot)->tag, FIXFieldTag_MsgType);
+   ASSERT_EQ(fix_field_get_by_slot(msg, NULL, slot)->tag, FIXFieldTag_ClOrdID);
+   ASSERT_TRUE(fix_field_get(msg, NULL, FIXFieldTag_BeginString) == NULL);
+
+   FIXGroup* grp = fix_msg_add_group(msg, NULL, 453, &error);
+   ASSERT_TRUE(grp != NULL);
+   int32_t const partySlot = fix_field_get_slot(msg, grp, 448);
+   ASSERT_GE(partySlot, 0);
+   ASSERT_EQ(grp->parent_fdescr->group[partySlot].type->tag, 448);
+   ASSERT_TRUE(fix_field_set_by_slot(msg, grp, partySlot, (unsigned char const*)val, strlen(val), &error) != NULL);
+   ASSERT_EQ(fix_field_get(msg, grp, 448), fix_field_get_by_slot(msg, grp, partySlot));
+
+   fix_msg_free(msg);
+   fix_parser_free(parser);
+}
+
+static void check_missing(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* fields, uint32_t count)
+{
+   int32_t missing = fix_field_get_missing(msg, grp, 0);
+   for(uint32_t i = 0; i < count; ++i)
+   {
+      if ((fields[i].flags & FIELD_FLAG_REQUIRED) && !fix_field_get_by_slot(msg, grp, i))
+      {
+         ASSERT_EQ(missing, (int32_t)i);
+         missing = fix_field_get_missing(msg, grp, i + 1);
+      }
+   }
+   ASSERT_EQ(missing, -1);
+}
+
+TEST(FixFieldTests, RequiredTest)
+{
+   FIXError* error = NULL;
+   FIXParserAttrs attrs = {512, 0, 2, 0, 2, 0};
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+
+   FIXMsg* msg = fix_msg_create(parser, "V", &error);
+   ASSERT_TRUE(msg != NULL);
+   check_missing(msg, NULL, msg->descr->fields, msg->descr->field_count);
+   int32_t const reqIdSlot = fix_field_get_slot(msg, NULL, 262);
+   ASSERT_LE(fix_field_get_missing(msg, NULL, 0), reqIdSlot);
+
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, NULL, 49, "CLIENT", &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, NULL, 56, "SERVER", &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_int32(msg, NULL, 34, 1, &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, NULL, 52, "20121009-13:44:49.421", &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, NULL, 262, "REQ_1", &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_char(msg, NULL, 263, '0', &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_int32(msg, NULL, 264, 0, &error));
+   FIXGroup* entry = fix_msg_add_group(msg, NULL, 267, &error);
+   ASSERT_TRUE(entry != NULL);
+   FIXGroup* sym = fix_msg_add_group(msg, NULL, 146, &error);
+   ASSERT_TRUE(sym != NULL);
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, sym, 55, "USD/JPY", &error));
+   check_missing(msg, NULL, msg->descr->fields, msg->descr->field_count);
+   check_missing(msg, sym, sym->parent_fdescr->group, sym->parent_fdescr->group_count);
+
+   // BodyLength and CheckSum are never set, they are calculated on conversion
+   for(int32_t i = fix_field_get_missing(msg, NULL, 0); i >= 0; i = fix_field_get_missing(msg, NULL, i + 1))
+   {
+      ASSERT_TRUE(msg->descr->fields[i].type->tag == FIXFieldTag_BodyLength || msg->descr->fields[i].type->tag == FIXFieldTag_CheckSum);
+   }
+
+   // required field of group is missing
+   int32_t const typeSlot = fix_field_get_slot(msg, entry, 269);
+   ASSERT_EQ(fix_field_get_missing(msg, entry, 0), typeSlot);
+   char buff[1024];
+   uint32_t reqBuffLen = 0;
+   ASSERT_EQ(FIX_FAILED, fix_msg_to_str(msg, FIX_SOH, buff, sizeof(buff), &reqBuffLen, &error));
+   ASSERT_EQ(FIX_ERROR_FIELD_NOT_FOUND, fix_error_get_code(error));
+   ASSERT_STREQ("Field '269' is required", fix_error_get_text(error));
+   fix_error_free(error);
+   error = NULL;
+
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_char(msg, entry, 269, '0', &error));
+   ASSERT_EQ(fix_field_get_missing(msg, entry, 0), -1);
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_to_str(msg, FIX_SOH, buff, sizeof(buff), &reqBuffLen, &error));
+
+   // deleted field is missing again
+   ASSERT_GT(fix_field_get_missing(msg, NULL, reqIdSlot), reqIdSlot);
+   ASSERT_EQ(FIX_SUCCESS, fix_field_del(msg, NULL, 262, &error));
+   ASSERT_EQ(fix_field_get_missing(msg, NULL, reqIdSlot), reqIdSlot);
+   check_missing(msg, NULL, msg->descr->fields, msg->descr->field_count);
+   ASSERT_EQ(FIX_FAILED, fix_msg_to_str(msg, FIX_SOH, buff, sizeof(buff), &reqBuffLen, &error));
+   ASSERT_STREQ("Tag '262' is required", fix_error_get_text(error));
+   fix_error_free(error);
+   error = NULL;
+
+   // message without required field is parsed only if it isn't checked
+   FIXParser* noCheckParser = fix_parser_create("fix_descr/fix.4.4.xml", &attrs,
+         PARSER_FLAG_CHECK_ALL & ~PARSER_FLAG_CHECK_REQUIRED, &error);
+   ASSERT_TRUE(noCheckParser != NULL);
+   FIXMsg* noCheckMsg = fix_msg_create(noCheckParser, "V", &error);
+   ASSERT_TRUE(noCheckMsg != NULL);
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(noCheckMsg, NULL, 49, "CLIENT", &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(noCheckMsg, NULL, 56, "SERVER", &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_int32(noCheckMsg, NULL, 34, 1, &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(noCheckMsg, NULL, 52, "20121009-13:44:49.421", &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_to_str(noCheckMsg, FIX_SOH, buff, sizeof(buff), &reqBuffLen, &error));
+   char const* stop = NULL;
+   FIXMsg* parsed = fix_parser_str_to_msg(noCheckParser, buff, reqBuffLen, FIX_SOH, &stop, &error);
+   ASSERT_TRUE(parsed != NULL);
+   fix_msg_free(parsed);
+   ASSERT_TRUE(fix_parser_str_to_msg(parser, buff, reqBuffLen, FIX_SOH, &stop, &error) == NULL);
+   ASSERT_EQ(FIX_ERROR_UNKNOWN_FIELD, fix_error_get_code(error));
+   ASSERT_STREQ("Required field 'MDReqID' not found.", fix_error_get_text(error));
+   fix_error_free(error);
+   error = NULL;
+
+   fix_msg_free(noCheckMsg);
+   fix_parser_free(noCheckParser);
+   fix_msg_free(msg);
+   fix_parser_free(parser);
+}
@@ -248,6 +248,11 @@ TEST(FixMsgTests, ToStringTest)
    ASSERT_STREQ(buff, "8=FIX.4.4|9=228|35=8|49=QWERTY_12345678|56=ABCQWE_XYZ|34=34|57=srv-ivanov_ii1|52=20120716-06:00:16.230|37=1|11=CL_ORD_ID_1234567|"
          "17=FE_1_9494_1|150=0|39=1|1=ZUM|55=RTS-12.12|54=1|38=25|44=135155|59=0|32=0|31=0|151=25|14=0|6=0|21=1|58=COMMENT12|10=110|");
 
+   ASSERT_EQ(FIX_ERROR_NO_MORE_SPACE, fix_msg_to_str(msg, '|', buff, 250, &reqBuffLen, &error));
+   ASSERT_EQ(reqBuffLen, 251U);
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_to_str(msg, '|', buff, 251, &reqBuffLen, &error));
+   ASSERT_EQ(reqBuffLen, 251U);
+
    fix_msg_free(msg);
    fix_parser_free(p);
 }
@@ -368,3 +373,291 @@ TEST(FixMsgTests, ToStringGroupTest2)
    ASSERT_TRUE(msg1 != NULL);
 }
 
+
+TEST(FixMsgTests, FieldHandleTest)
+{
+   FIXError* error = NULL;
+   FIXParser* p = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(p != NULL);
+
+   FIXFieldHandle clOrdID, qty, side, seqNum, price;
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_resolve_field(p, "D", FIXFieldTag_ClOrdID, &clOrdID, &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_resolve_field(p, "D", FIXFieldTag_OrderQty, &qty, &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_resolve_field(p, "D", FIXFieldTag_Side, &side, &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_resolve_field(p, "D", FIXFieldTag_MsgSeqNum, &seqNum, &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_resolve_field(p, "D", FIXFieldTag_Price, &price, &error));
+   ASSERT_EQ(clOrdID.tag, FIXFieldTag_ClOrdID);
+
+   ASSERT_EQ(FIX_FAILED, fix_msg_resolve_field(p, "D", FIXFieldTag_ExecID, &clOrdID, &error));
+   ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_UNKNOWN_FIELD);
+   fix_error_free(error);
+   error = NULL;
+
+   FIXMsg* msg = fix_msg_create(p, "D", &error);
+   ASSERT_TRUE(msg != NULL);
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string_h(msg, &clOrdID, "CL_ORD_ID_1", &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_double_h(msg, &qty, 25, &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_char_h(msg, &side, '1', &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_int32_h(msg, &seqNum, 34, &error));
+
+   ASSERT_EQ(FIX_FAILED, fix_msg_set_char_h(msg, &clOrdID, '1', &error));
+   ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_FIELD_HAS_WRONG_TYPE);
+   fix_error_free(error);
+   error = NULL;
+
+   char const* val = NULL;
+   uint32_t len = 0;
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_get_string_h(msg, &clOrdID, &val, &len, &error));
+   ASSERT_EQ(0, strncmp(val, "CL_ORD_ID_1", len));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_get_string(msg, NULL, FIXFieldTag_ClOrdID, &val, &len, &error));
+   ASSERT_EQ(0, strncmp(val, "CL_ORD_ID_1", len));
+   double dval = 0.0;
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_get_double_h(msg, &qty, &dval, &error));
+   ASSERT_EQ(dval, 25.0);
+   char cval = 0;
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_get_char_h(msg, &side, &cval, &error));
+   ASSERT_EQ(cval, '1');
+   int64_t ival = 0;
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_get_int64_h(msg, &seqNum, &ival, &error));
+   ASSERT_EQ(ival, 34);
+   ASSERT_EQ(FIX_NO_FIELD, fix_msg_get_double_h(msg, &price, &dval, &error));
+
+   FIXMsg* msg1 = fix_msg_create(p, "8", &error); // handle is resolved for "D" only
+   ASSERT_TRUE(msg1 != NULL);
+   ASSERT_EQ(FIX_FAILED, fix_msg_set_string_h(msg1, &clOrdID, "CL_ORD_ID_1", &error));
+   ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_INVALID_ARGUMENT);
+   fix_error_free(error);
+
+   fix_msg_free(msg);
+   fix_msg_free(msg1);
+   fix_parser_free(p);
+}
+
+TEST(FixMsgTests, MsgTemplateTest)
+{
+   FIXError* error = NULL;
+   FIXParser* p = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(p != NULL);
+
+   FIXFieldHandle h[5];
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_resolve_field(p, "D", FIXFieldTag_Price, &h[0], &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_resolve_field(p, "D", FIXFieldTag_MsgSeqNum, &h[1], &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_resolve_field(p, "D", FIXFieldTag_SendingTime, &h[2], &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_resolve_field(p, "D", FIXFieldTag_ClOrdID, &h[3], &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_resolve_field(p, "D", FIXFieldTag_OrderQty, &h[4], &error));
+
+   FIXMsg* msg = fix_msg_create(p, "D", &error);
+   ASSERT_TRUE(msg != NULL);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_SenderCompID, "QWERTY_12345678", &error);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_TargetCompID, "ABCQWE_XYZ", &error);
+   fix_msg_set_int32(msg, NULL, FIXFieldTag_MsgSeqNum, 1, &error);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_SendingTime, "20120716-06:00:16.230", &error);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_Account, "ZUM", &error);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_ClOrdID, "CL_ORD_ID_1", &error);
+   FIXGroup* grp = fix_msg_add_group(msg, NULL, FIXFieldTag_NoPartyIDs, &error);
+   fix_msg_set_string(msg, grp, FIXFieldTag_PartyID, "PARTY", &error);
+   fix_msg_set_char(msg, NULL, FIXFieldTag_HandlInst, '1', &error);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_Symbol, "RTS-12.12", &error);
+   fix_msg_set_char(msg, NULL, FIXFieldTag_Side, '1', &error);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_TransactTime, "20120716-06:00:16.230", &error);
+   fix_msg_set_char(msg, NULL, FIXFieldTag_OrdType, '2', &error);
+   fix_msg_set_double(msg, NULL, FIXFieldTag_OrderQty, 25, &error);
+
+   FIXMsgTemplate* tmpl = fix_msg_template_create(msg, '|', h, 5, &error); // price is not set yet
+   ASSERT_TRUE(tmpl != NULL);
+
+   char buff[1024] = {};
+   char expected[1024] = {};
+   uint32_t reqBuffLen = 0;
+   uint32_t expectedLen = 0;
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_template_to_str(tmpl, buff, sizeof(buff), &reqBuffLen, &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_to_str(msg, '|', expected, sizeof(expected), &expectedLen, &error));
+   ASSERT_EQ(std::string(expected, strlen(expected)), std::string(buff, reqBuffLen));
+
+   for(int32_t i = 2; i < 1000; i += 97)
+   {
+      char clOrdID[32] = {};
+      sprintf(clOrdID, "CL_ORD_ID_%d", i * 1000);
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_template_set_double(tmpl, 0, 135155.5 + i, &error));
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_template_set_int64(tmpl, 1, i, &error));
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_template_set_string(tmpl, 2, "20120716-06:00:17.000", &error));
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_template_set_string(tmpl, 3, clOrdID, &error));
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_template_set_double(tmpl, 4, i, &error));
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_template_to_str(tmpl, buff, sizeof(buff), &reqBuffLen, &error));
+
+      fix_msg_set_double_h(msg, &h[0], 135155.5 + i, &error);
+      fix_msg_set_int32_h(msg, &h[1], i, &error);
+      fix_msg_set_string_h(msg, &h[2], "20120716-06:00:17.000", &error);
+      fix_msg_set_string_h(msg, &h[3], clOrdID, &error);
+      fix_msg_set_double_h(msg, &h[4], i, &error);
+      memset(expected, 0, sizeof(expected));
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_to_str(msg, '|', expected, sizeof(expected), &expectedLen, &error));
+      ASSERT_EQ(std::string(expected, strlen(expected)), std::string(buff, reqBuffLen));
+   }
+
+   char const* stop = NULL;
+   FIXMsg* msg1 = fix_parser_str_to_msg(p, buff, reqBuffLen, '|', &stop, &error);
+   ASSERT_TRUE(msg1 != NULL);
+   fix_msg_free(msg1);
+
+   ASSERT_EQ(FIX_ERROR_NO_MORE_SPACE, fix_msg_template_to_str(tmpl, buff, 10, &reqBuffLen, &error));
+   ASSERT_EQ(FIX_FAILED, fix_msg_template_set_char(tmpl, 3, '1', &error));
+   ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_FIELD_HAS_WRONG_TYPE);
+   fix_error_free(error);
+   ASSERT_EQ(FIX_FAILED, fix_msg_template_set_string(tmpl, 5, "1", &error));
+   ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_INVALID_ARGUMENT);
+   fix_error_free(error);
+   fix_msg_template_free(tmpl);
+
+   FIXFieldHandle dup[2] = {h[1], h[1]};
+   ASSERT_TRUE(fix_msg_template_create(msg, '|', dup, 2, &error) == NULL);
+   ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_INVALID_ARGUMENT);
+   fix_error_free(error);
+
+   fix_msg_free(msg);
+   fix_parser_free(p);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+static void check_sum(FIXMsg* msg)
+{
+   FIXError* error = NULL;
+   char buff[1024] = {};
+   char ref[1024] = {};
+   uint32_t reqBuffLen = 0;
+   uint32_t refLen = 0;
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_to_str(msg, FIX_SOH, buff, sizeof(buff), &reqBuffLen, &error)) << fix_error_get_text(error);
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_to_str(msg, '|', ref, sizeof(ref), &refLen, &error));
+   ASSERT_EQ(reqBuffLen, refLen);
+   uint32_t crc = 0;
+   for(uint32_t i = 0; i < reqBuffLen - 7; ++i)
+   {
+      crc += (unsigned char)buff[i];
+   }
+   char expected[8] = {};
+   sprintf(expected, "10=%03u\001", crc % 256);
+   ASSERT_EQ(std::string(expected), std::string(buff + reqBuffLen - 7, 7));
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixMsgTests, IncrementalCheckSumTest)
+{
+   FIXError* error = NULL;
+   FIXParser* p = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(p != NULL);
+
+   FIXMsg* msg = fix_msg_create(p, "D", &error);
+   ASSERT_TRUE(msg != NULL);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_SenderCompID, "QWERTY_12345678", &error);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_TargetCompID, "ABCQWE_XYZ", &error);
+   fix_msg_set_int32(msg, NULL, FIXFieldTag_MsgSeqNum, 1, &error);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_SendingTime, "20120716-06:00:16.230", &error);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_Account, "ZUM", &error);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_ClOrdID, "CL_ORD_ID_1", &error);
+   fix_msg_set_char(msg, NULL, FIXFieldTag_HandlInst, '1', &error);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_Symbol, "RTS-12.12", &error);
+   fix_msg_set_char(msg, NULL, FIXFieldTag_Side, '1', &error);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_TransactTime, "20120716-06:00:16.230", &error);
+   fix_msg_set_char(msg, NULL, FIXFieldTag_OrdType, '2', &error);
+   fix_msg_set_double(msg, NULL, FIXFieldTag_OrderQty, 25, &error);
+   check_sum(msg);
+
+   fix_msg_set_int32(msg, NULL, FIXFieldTag_MsgSeqNum, 123456, &error);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_ClOrdID, "ID", &error);
+   check_sum(msg);
+
+   FIXGroup* grp = fix_msg_add_group(msg, NULL, FIXFieldTag_NoPartyIDs, &error);
+   fix_msg_set_string(msg, grp, FIXFieldTag_PartyID, "PARTY", &error);
+   check_sum(msg);
+   for(int32_t i = 0; i < 10; ++i)
+   {
+      char partyID[32] = {};
+      sprintf(partyID, "PARTY_%d", i * 1000);
+      grp = fix_msg_add_group(msg, NULL, FIXFieldTag_NoPartyIDs, &error);
+      fix_msg_set_string(msg, grp, FIXFieldTag_PartyID, partyID, &error);
+   }
+   check_sum(msg);
+
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_del_group(msg, NULL, FIXFieldTag_NoPartyIDs, 3, &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_del_field(msg, NULL, FIXFieldTag_Account, &error));
+   check_sum(msg);
+
+   for(int32_t i = 0; i < 10; ++i)
+   {
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_del_group(msg, NULL, FIXFieldTag_NoPartyIDs, 0, &error));
+   }
+   check_sum(msg);
+
+   fix_msg_free(msg);
+   fix_parser_free(p);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+static std::string iovec_to_string(struct iovec const* iov, uint32_t count)
+{
+   std::string res;
+   for(uint32_t i = 0; i < count; ++i)
+   {
+      res.append((char const*)iov[i].iov_base, iov[i].iov_len);
+   }
+   return res;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixMsgTests, ToIovecTest)
+{
+   FIXError* error = NULL;
+   FIXParser* p = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(p != NULL);
+
+   FIXMsg* msg = fix_msg_create(p, "D", &error);
+   ASSERT_TRUE(msg != NULL);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_SenderCompID, "QWERTY_12345678", &error);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_TargetCompID, "ABCQWE_XYZ", &error);
+   fix_msg_set_int32(msg, NULL, FIXFieldTag_MsgSeqNum, 1, &error);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_SendingTime, "20120716-06:00:16.230", &error);
+   std::string xml = "<data>" + std::string(200, 'x') + "</data>";
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_data(msg, NULL, FIXFieldTag_XmlData, xml.c_str(), xml.size(), &error));
+   fix_msg_set_string(msg, NULL, FIXFieldTag_ClOrdID, "CL_ORD_ID_1", &error);
+   for(int32_t i = 0; i < 3; ++i)
+   {
+      FIXGroup* grp = fix_msg_add_group(msg, NULL, FIXFieldTag_NoPartyIDs, &error);
+      fix_msg_set_string(msg, grp, FIXFieldTag_PartyID, "PARTY", &error);
+   }
+   fix_msg_set_char(msg, NULL, FIXFieldTag_HandlInst, '1', &error);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_Symbol, "RTS-12.12", &error);
+   fix_msg_set_char(msg, NULL, FIXFieldTag_Side, '1', &error);
+   fix_msg_set_string(msg, NULL, FIXFieldTag_TransactTime, "20120716-06:00:16.230", &error);
+   fix_msg_set_char(msg, NULL, FIXFieldTag_OrdType, '2', &error);
+   fix_msg_set_double(msg, NULL, FIXFieldTag_OrderQty, 25, &error);
+
+   char const delimiters[] = {FIX_SOH, '|'};
+   for(uint32_t d = 0; d < sizeof(delimiters); ++d)
+   {
+      char expected[1024] = {};
+      uint32_t expectedLen = 0;
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_to_str(msg, delimiters[d], expected, sizeof(expected), &expectedLen, &error));
+
+      struct iovec iov[16] = {};
+      char buff[1024] = {};
+      uint32_t reqIovCount = 0;
+      uint32_t reqBuffLen = 0;
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_to_iovec(msg, delimiters[d], iov, 16, &reqIovCount, buff, sizeof(buff), &reqBuffLen, &error));
+      ASSERT_EQ(3U, reqIovCount);
+      ASSERT_EQ(expectedLen - xml.size(), reqBuffLen);
+      ASSERT_EQ(std::string(expected, expectedLen), iovec_to_string(iov, reqIovCount));
+
+      char const* xmlData = NULL;
+      uint32_t xmlLen = 0;
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_get_data(msg, NULL, FIXFieldTag_XmlData, &xmlData, &xmlLen, &error));
+      ASSERT_EQ(iov[1].iov_base, (void*)xmlData); // data field is not copied
+      ASSERT_EQ(iov[1].iov_len, xmlLen);
+
+      ASSERT_EQ(FIX_ERROR_NO_MORE_SPACE, fix_msg_to_iovec(msg, delimiters[d], iov, 2, &reqIovCount, buff, 10, &reqBuffLen, &error));
+      ASSERT_EQ(3U, reqIovCount);
+      ASSERT_EQ(expectedLen - xml.size(), reqBuffLen);
+   }
+
+   fix_msg_free(msg);
+   fix_parser_free(p);
+}
@@ -6,6 +6,9 @@
 
 #include <fix_parser.h>
 #include <fix_parser_priv.h>
+#include <fix_thread.h>
+#include <fix_msg.h>
+#include <fix_field_tag.h>
 
 #include <gtest/gtest.h>
 
@@ -48,10 +51,11 @@ TEST(FixParserPrivTests, GetFreePageTest)
    ASSERT_TRUE(parser != NULL);
 
    FIXPage* nextp = parser->page->next;
+   FIXPoolCache* cache = &parser->cache[fix_thread_index() % POOL_CACHE_COUNT].cache; // free pages of this thread
    FIXPage* p = fix_parser_alloc_page(parser, 0, &error);
 
    ASSERT_TRUE(p->next == NULL);
-   ASSERT_EQ(parser->page, nextp);
+   ASSERT_EQ(cache->page, nextp);
    ASSERT_EQ(parser->used_pages, 1U);
 
    FIXPage* p1 = fix_parser_alloc_page(parser, 0, &error);
@@ -60,22 +64,22 @@ TEST(FixParserPrivTests, GetFreePageTest)
    ASSERT_EQ(parser->used_pages, 2U);
 
    FIXPage* p2 = fix_parser_alloc_page(parser, 0, &error);
-   ASSERT_TRUE(parser->page == NULL);
+   ASSERT_TRUE(cache->page == NULL);
    ASSERT_NE(p2, nextp);
    ASSERT_TRUE(p1->next == NULL);
    ASSERT_EQ(parser->used_pages, 3U);
 
    fix_parser_free_page(parser, p);
 
-   ASSERT_EQ(parser->page, p);
+   ASSERT_EQ(cache->page, p);
 
    fix_parser_free_page(parser, p2);
-   ASSERT_EQ(parser->page, p2);
-   ASSERT_EQ(parser->page->next, p);
+   ASSERT_EQ(cache->page, p2);
+   ASSERT_EQ(cache->page->next, p);
 
    fix_parser_free_page(parser, p1);
-   ASSERT_EQ(parser->page, p1);
-   ASSERT_EQ(parser->page->next, p2);
+   ASSERT_EQ(cache->page, p1);
+   ASSERT_EQ(cache->page->next, p2);
 
    ASSERT_EQ(parser->used_pages, 0U);
 
@@ -92,9 +96,10 @@ TEST(FixParserPrivTests, MaxPagesTest)
    FIXPage* nextp = parser->page->next;
    ASSERT_TRUE(parser->page != NULL);
 
+   FIXPoolCache* cache = &parser->cache[fix_thread_index() % POOL_CACHE_COUNT].cache; // free pages of this thread
    FIXPage* p = fix_parser_alloc_page(parser, 0, &error);
    ASSERT_TRUE(p->next == NULL);
-   ASSERT_EQ(parser->page, nextp);
+   ASSERT_EQ(cache->page, nextp);
    ASSERT_EQ(parser->used_pages, 1U);
 
    FIXPage* p1 = fix_parser_alloc_page(parser, 0, &error);
@@ -105,23 +110,75 @@ TEST(FixParserPrivTests, MaxPagesTest)
    FIXPage* p2 = fix_parser_alloc_page(parser, 0, &error);
    ASSERT_TRUE(p2 == NULL);
    ASSERT_EQ(error->code, FIX_ERROR_NO_MORE_PAGES);
-   ASSERT_TRUE(parser->page == NULL);
+   ASSERT_TRUE(cache->page == NULL);
    ASSERT_EQ(parser->used_pages, 2U);
 
    fix_parser_free_page(parser, p);
 
-   ASSERT_EQ(parser->page, p);
+   ASSERT_EQ(cache->page, p);
    ASSERT_EQ(parser->used_pages, 1U);
 
    p = fix_parser_alloc_page(parser, 0, &error);
 
    ASSERT_TRUE(p->next == NULL);
-   ASSERT_TRUE(parser->page == NULL);
+   ASSERT_TRUE(cache->page == NULL);
    ASSERT_EQ(parser->used_pages, 2U);
 
    fix_parser_free(parser);
 }
 
+TEST(FixParserPrivTests, PoolCacheTest)
+{
+   FIXError* error = NULL;
+   FIXParserAttrs attrs = {512, 0, POOL_CACHE_LIMIT + 10, 0, POOL_CACHE_LIMIT + 10, 0};
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+
+   FIXPoolCache* cache = &parser->cache[fix_thread_index() % POOL_CACHE_COUNT].cache;
+   ASSERT_EQ((uintptr_t)cache % CACHE_LINE_SIZE, 0U);
+
+   FIXPage* p = fix_parser_alloc_page(parser, 0, &error); // cache takes no more than POOL_CACHE_LIMIT pages
+   ASSERT_TRUE(p != NULL);
+   ASSERT_EQ(cache->page_count, POOL_CACHE_LIMIT - 1U);
+   uint32_t count = 0;
+   for(FIXPage* it = parser->page; it; it = it->next)
+   {
+      ++count;
+   }
+   ASSERT_EQ(count, 10U);
+
+   FIXGroup* g = fix_parser_alloc_group(parser, &error);
+   ASSERT_TRUE(g != NULL);
+   ASSERT_EQ(cache->group_count, POOL_CACHE_LIMIT - 1U);
+
+   cache->lock = 1; // cache is busy, parser pool is used instead of new allocation
+   FIXPage* nextp = parser->page->next;
+   FIXPage* p1 = fix_parser_alloc_page(parser, 0, &error);
+   ASSERT_TRUE(p1 != NULL);
+   ASSERT_TRUE(p1->next == NULL);
+   ASSERT_EQ(parser->page, nextp);
+   ASSERT_EQ(cache->page_count, POOL_CACHE_LIMIT - 1U);
+
+   FIXGroup* nextg = parser->group->next;
+   FIXGroup* g1 = fix_parser_alloc_group(parser, &error);
+   ASSERT_TRUE(g1 != NULL);
+   ASSERT_TRUE(g1->next == NULL);
+   ASSERT_EQ(parser->group, nextg);
+
+   fix_parser_free_page(parser, p1);
+   ASSERT_EQ(parser->page, p1);
+   fix_parser_free_group(parser, g1);
+   ASSERT_EQ(parser->group, g1);
+   cache->lock = 0;
+
+   fix_parser_free_page(parser, p);
+   fix_parser_free_group(parser, g);
+   ASSERT_EQ(parser->used_pages, 0U);
+   ASSERT_EQ(parser->used_groups, 0U);
+
+   fix_parser_free(parser);
+}
+
 TEST(FixParserPrivTests, MaxGroupsTest)
 {
    FIXError* error = NULL;
@@ -132,9 +189,10 @@ TEST(FixParserPrivTests, MaxGroupsTest)
    FIXGroup* nextg = parser->group->next;
    ASSERT_TRUE(parser->group != NULL);
 
+   FIXPoolCache* cache = &parser->cache[fix_thread_index() % POOL_CACHE_COUNT].cache; // free groups of this thread
    FIXGroup* g = fix_parser_alloc_group(parser, &error);
    ASSERT_TRUE(g->next == NULL);
-   ASSERT_EQ(parser->group, nextg);
+   ASSERT_EQ(cache->group, nextg);
    ASSERT_EQ(parser->used_groups, 1U);
 
    FIXGroup* g1 = fix_parser_alloc_group(parser, &error);
@@ -145,14 +203,14 @@ TEST(FixParserPrivTests, MaxGroupsTest)
    FIXGroup* p2 = fix_parser_alloc_group(parser, &error);
    ASSERT_TRUE(p2 == NULL);
    ASSERT_EQ(error->code, FIX_ERROR_NO_MORE_GROUPS);
-   ASSERT_TRUE(parser->group == NULL);
+   ASSERT_TRUE(cache->group == NULL);
    ASSERT_EQ(parser->used_groups, 2U);
 
    fix_parser_free_group(parser, g);
 
    g = fix_parser_alloc_group(parser, &error);
    ASSERT_TRUE(g->next == NULL);
-   ASSERT_TRUE(parser->group == NULL);
+   ASSERT_TRUE(cache->group == NULL);
    ASSERT_EQ(parser->used_groups, 2U);
 
    fix_parser_free(parser);
@@ -254,3 +312,76 @@ TEST(FixParserPrivTests, ParseMandatoryField)
 
    fix_parser_free(parser);
 }
+
+//-------------------------------------------------------------------------------------------------------------------//
+#define POOL_TEST_THREADS 4
+#define POOL_TEST_MSGS 5000
+
+struct PoolTestData
+{
+   FIXParser* parser;
+   FIXMsg** create;        // messages to create
+   FIXMsg** free;          // messages to free, they were created by another thread
+   int32_t volatile failed;
+};
+
+static void pool_test_routine(void* arg)
+{
+   PoolTestData* data = (PoolTestData*)arg;
+   FIXError* error = NULL;
+   for(int32_t i = 0; i < POOL_TEST_MSGS; ++i)
+   {
+      if (data->free)
+      {
+         fix_msg_free(data->free[i]);
+      }
+      FIXMsg* msg = fix_msg_create(data->parser, "D", &error);
+      FIXGroup* grp = msg ? fix_msg_add_group(msg, NULL, FIXFieldTag_NoPartyIDs, &error) : NULL;
+      if (!grp || fix_msg_set_string(msg, grp, FIXFieldTag_PartyID, "PARTY_ID_1234567890", &error) != FIX_SUCCESS)
+      {
+         data->failed = 1;
+      }
+      data->create[i] = msg;
+   }
+}
+
+TEST(FixParserPrivTests, ConcurrentPoolTest)
+{
+   FIXError* error = NULL;
+   FIXParserAttrs attrs = {64, 0, 10, 0, 10, 0}; // small pages, so every message uses several of them
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+
+   FIXMsg* msgs[2][POOL_TEST_THREADS][POOL_TEST_MSGS] = {};
+   PoolTestData data[POOL_TEST_THREADS] = {};
+   FIXThread* threads[POOL_TEST_THREADS] = {};
+   for(int32_t pass = 0; pass < 2; ++pass) // on second pass each thread frees messages, created by its neighbour
+   {
+      for(int32_t i = 0; i < POOL_TEST_THREADS; ++i)
+      {
+         data[i].parser = parser;
+         data[i].create = msgs[pass][i];
+         data[i].free = pass ? msgs[0][(i + 1) % POOL_TEST_THREADS] : NULL;
+         threads[i] = fix_thread_create(&pool_test_routine, &data[i]);
+         ASSERT_TRUE(threads[i] != NULL);
+      }
+      for(int32_t i = 0; i < POOL_TEST_THREADS; ++i)
+      {
+         fix_thread_join(threads[i]);
+         ASSERT_EQ(data[i].failed, 0);
+      }
+   }
+   ASSERT_EQ(parser->used_groups, 2U * POOL_TEST_THREADS * POOL_TEST_MSGS);
+
+   for(int32_t i = 0; i < POOL_TEST_THREADS; ++i)
+   {
+      for(int32_t j = 0; j < POOL_TEST_MSGS; ++j)
+      {
+         fix_msg_free(msgs[1][i][j]);
+      }
+   }
+   ASSERT_EQ(parser->used_pages, 0U);
+   ASSERT_EQ(parser->used_groups, 0U);
+
+   fix_parser_free(parser);
+}
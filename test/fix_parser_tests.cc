@@ -7,6 +7,7 @@
 #include <fix_parser.h>
 #include <fix_parser_priv.h>
 #include <fix_msg.h>
+#include <fix_msg_priv.h>
 
 #include <gtest/gtest.h>
 
@@ -405,6 +406,106 @@ TEST(FixParserTests, ParseStringTest)
    ASSERT_STREQ(buff, buff1); // Bingo!
 }
 
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixParserTests, IndexStringTest)
+{
+   FIXError* error = NULL;
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   char buff[] = "8=FIX.4.4\0019=228\00135=8\00149=QWERTY_12345678\00156=ABCQWE_XYZ\00134=34\00157=srv-ivanov_ii1\00152=20120716-06:00:16.230\00137=1\001"
+      "11=CL_ORD_ID_1234567\00117=FE_1_9494_1\001150=0\00139=1\0011=ZUM\00155=RTS-12.12\00154=1\00138=25\00144=135155\00159=0\00132=0\00131=0\001151=25\001"
+      "14=0\0016=0\00121=1\00158=COMMENT12\00110=240\001";
+   char const* stop = NULL;
+   uint32_t count = 0;
+   int32_t checkSum = 0;
+   FIXFieldIndex index[32];
+
+   ASSERT_EQ(FIX_ERROR_NO_MORE_SPACE, fix_parser_index(parser, buff, strlen(buff), FIX_SOH, index, 4, &count, &checkSum, &stop, &error));
+   ASSERT_EQ(count, 27U);
+   ASSERT_EQ(index[3].tag, FIXFieldTag_SenderCompID);
+
+   ASSERT_EQ(FIX_SUCCESS, fix_parser_index(parser, buff, strlen(buff), FIX_SOH, index, 32, &count, &checkSum, &stop, &error));
+   ASSERT_EQ(count, 27U);
+   ASSERT_EQ(checkSum, 240);
+   ASSERT_EQ(stop, buff + strlen(buff) - 1);
+   ASSERT_EQ(index[0].tag, FIXFieldTag_BeginString);
+   ASSERT_EQ(index[1].tag, FIXFieldTag_BodyLength);
+   ASSERT_EQ(index[2].tag, FIXFieldTag_MsgType);
+   ASSERT_EQ(index[25].tag, FIXFieldTag_Text);
+   ASSERT_EQ(0, strncmp(buff + index[25].offset, "COMMENT12", index[25].len));
+   ASSERT_EQ(index[25].len, 9U);
+   ASSERT_EQ(index[26].tag, FIXFieldTag_CheckSum);
+   ASSERT_EQ(0, strncmp(buff + index[26].offset, "240", index[26].len));
+
+   fix_parser_free(parser);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixParserTests, IndexDataFieldTest)
+{
+   FIXError* error = NULL;
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   // EncodedText is bounded by EncodedTextLen, which is not the previous field
+   char body[] = "35=D\00149=QWERTY_12345678\00156=ABCQWE_XYZ\00134=34\00152=20120716-06:00:16.230\001"
+      "354=5\00158=TEXT\001355=a\001b=c\00111=CL_ORD_ID_1234567\001";
+   char buff[512];
+   int32_t len = snprintf(buff, sizeof(buff), "8=FIX.4.4\0019=%d\001%s10=000\001", (int32_t)strlen(body), body);
+   char const* stop = NULL;
+   uint32_t count = 0;
+   int32_t checkSum = 0;
+   FIXFieldIndex index[32];
+
+   ASSERT_EQ(FIX_ERROR_NO_MORE_SPACE, fix_parser_index(parser, buff, len, FIX_SOH, index, 4, &count, &checkSum, &stop, &error));
+   ASSERT_EQ(count, 12U);
+
+   ASSERT_EQ(FIX_SUCCESS, fix_parser_index(parser, buff, len, FIX_SOH, index, 32, &count, &checkSum, &stop, &error));
+   ASSERT_EQ(count, 12U);
+   ASSERT_EQ(stop, buff + len - 1);
+   ASSERT_EQ(index[9].tag, FIXFieldTag_EncodedText);
+   ASSERT_EQ(index[9].len, 5U);
+   ASSERT_EQ(0, strncmp(buff + index[9].offset, "a\001b=c", index[9].len));
+   ASSERT_EQ(index[10].tag, FIXFieldTag_ClOrdID);
+
+   fix_parser_free(parser);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixParserTests, ParseStringZeroCopyTest)
+{
+   FIXError* error = NULL;
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL | PARSER_FLAG_ZERO_COPY, &error);
+   ASSERT_TRUE(parser != NULL);
+   char buff[] = "8=FIX.4.4\0019=228\00135=8\00149=QWERTY_12345678\00156=ABCQWE_XYZ\00134=34\00157=srv-ivanov_ii1\00152=20120716-06:00:16.230\00137=1\001"
+      "11=CL_ORD_ID_1234567\00117=FE_1_9494_1\001150=0\00139=1\0011=ZUM\00155=RTS-12.12\00154=1\00138=25\00144=135155\00159=0\00132=0\00131=0\001151=25\001"
+      "14=0\0016=0\00121=1\00158=COMMENT12\00110=240\001";
+   char const* stop = NULL;
+   FIXMsg* msg = fix_parser_str_to_msg(parser, buff, strlen(buff), FIX_SOH, &stop, &error);
+   ASSERT_TRUE(msg != NULL);
+
+   char const* val = NULL;
+   uint32_t len = 0;
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_get_string(msg, NULL, FIXFieldTag_Text, &val, &len, &error));
+   ASSERT_TRUE(val >= buff && val < buff + sizeof(buff)); // value refers to parsed string
+   ASSERT_EQ(0, strncmp(val, "COMMENT12", len));
+
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, NULL, FIXFieldTag_Text, "NEW", &error));
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_get_string(msg, NULL, FIXFieldTag_Text, &val, &len, &error));
+   ASSERT_TRUE(val < buff || val >= buff + sizeof(buff)); // value is copied on change
+   ASSERT_EQ(0, strncmp(val, "NEW", len));
+   ASSERT_TRUE(strstr(buff, "COMMENT12") != NULL); // parsed string is untouched
+
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, NULL, FIXFieldTag_Text, "COMMENT12", &error));
+   char buff1[1024];
+   uint32_t reqBuffLen = 0;
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_to_str(msg, FIX_SOH, buff1, sizeof(buff1), &reqBuffLen, &error));
+   buff1[reqBuffLen] = 0;
+   ASSERT_STREQ(buff, buff1);
+
+   fix_msg_free(msg);
+   fix_parser_free(parser);
+}
+
 //-------------------------------------------------------------------------------------------------------------------//
 TEST(FixParserTests, ParseMultipleStringTest)
 {
@@ -541,6 +642,64 @@ TEST(FixParserTests, ParseStringGroupTest)
    ASSERT_STREQ(buff, buff1); // Bingo!
 }
 
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixParserTests, ParseStringLazyTest)
+{
+   FIXError* error = NULL;
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL | PARSER_FLAG_LAZY, &error);
+   ASSERT_TRUE(parser != NULL);
+   ASSERT_TRUE(error == NULL);
+   char buff[] = "8=FIX.4.4\0019=190\00135=D\00149=QWERTY_12345678\00156=ABCQWE_XYZ\00134=34\00152=20120716-06:00:16.230\001"
+            "11=CL_ORD_ID_1234567\001453=2\001448=ID1\001447=A\001452=1\001448=ID2\001447=B\001452=2\00155=RTS-12.12\001"
+            "54=1\00160=20120716-06:00:16.230\00138=25\00140=2\00110=088\001";
+   char const* stop = NULL;
+   FIXMsg* msg = fix_parser_str_to_msg(parser, buff, strlen(buff), FIX_SOH, &stop, &error);
+   ASSERT_TRUE(msg != NULL);
+   ASSERT_TRUE(error == NULL);
+   ASSERT_TRUE(msg->lazy != NULL);
+   ASSERT_TRUE(fix_field_get(msg, NULL, FIXFieldTag_Symbol) == NULL);   // not parsed yet
+   ASSERT_TRUE(fix_field_get(msg, NULL, FIXFieldTag_NoPartyIDs) == NULL);
+
+   CHECK_STRING(msg, NULL, FIXFieldTag_Symbol,       "RTS-12.12");
+   CHECK_CHAR(msg,   NULL, FIXFieldTag_Side,         '1');
+   CHECK_DOUBLE(msg, NULL, FIXFieldTag_OrderQty,     25);
+   ASSERT_TRUE(fix_field_get(msg, NULL, FIXFieldTag_NoPartyIDs) == NULL);
+
+   FIXGroup* group = fix_msg_get_group(msg, NULL, FIXFieldTag_NoPartyIDs, 1, &error);
+   ASSERT_TRUE(group != NULL);
+   CHECK_STRING(msg, group, FIXFieldTag_PartyID, "ID2");
+   CHECK_CHAR(msg, group, FIXFieldTag_PartyIDSource, 'B');
+   CHECK_INT32(msg, group, FIXFieldTag_PartyRole, 2);
+   ASSERT_TRUE(msg->lazy != NULL);
+
+   char buff1[1024];
+   uint32_t reqBuffLen = 0;
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_to_str(msg, FIX_SOH, buff1, sizeof(buff1), &reqBuffLen, &error));
+   ASSERT_TRUE(msg->lazy == NULL);
+   buff1[reqBuffLen] = 0;
+   ASSERT_STREQ(buff, buff1);
+   fix_msg_free(msg);
+
+   msg = fix_parser_str_to_msg(parser, buff, strlen(buff), FIX_SOH, &stop, &error);
+   ASSERT_TRUE(msg != NULL);
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_del_field(msg, NULL, FIXFieldTag_Symbol, &error)); // change parses whole message
+   ASSERT_TRUE(msg->lazy == NULL);
+   ASSERT_EQ(FIX_NO_FIELD, fix_msg_get_string(msg, NULL, FIXFieldTag_Symbol, NULL, NULL, &error));
+   CHECK_STRING(msg, NULL, FIXFieldTag_ClOrdID, "CL_ORD_ID_1234567");
+   fix_msg_free(msg);
+
+   char buff2[] = "8=FIX.4.4\0019=169\00135=D\00149=QWERTY_12345678\00156=ABCQWE_XYZ\00134=34\00152=20120716-06:00:16.230\001"
+            "453=2\001448=ID1\001447=A\001452=1\001448=ID2\001447=B\001452=2\00155=RTS-12.12\001"
+            "54=1\00160=20120716-06:00:16.230\00138=25\00140=2\00110=052\001"; // required ClOrdID is missing
+   msg = fix_parser_str_to_msg(parser, buff2, strlen(buff2), FIX_SOH, &stop, &error);
+   ASSERT_TRUE(msg == NULL);
+   ASSERT_TRUE(error != NULL);
+   ASSERT_STREQ("Required field 'ClOrdID' not found.", fix_error_get_text(error));
+   fix_error_free(error);
+
+   fix_parser_free(parser);
+}
+
 //-------------------------------------------------------------------------------------------------------------------//
 TEST(FixParserTests, ParseStringGroupTest2)
 {
@@ -557,3 +716,271 @@ TEST(FixParserTests, ParseStringGroupTest2)
    ASSERT_TRUE(msg != NULL);
    ASSERT_TRUE(error == NULL);
 }
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixParserTests, StreamParserTest)
+{
+   FIXError* error = NULL;
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   FIXStreamParser* sparser = fix_stream_parser_create(parser, FIX_SOH, &error);
+   ASSERT_TRUE(sparser != NULL);
+   char buff[] = "8=FIX.4.4\0019=228\00135=8\00149=QWERTY_12345678\00156=ABCQWE_XYZ\00134=34\00157=srv-ivanov_ii1\00152=20120716-06:00:16.230\00137=1\001"
+      "11=CL_ORD_ID_1234567\00117=FE_1_9494_1\001150=0\00139=1\0011=ZUM\00155=RTS-12.12\00154=1\00138=25\00144=135155\00159=0\00132=0\00131=0\001151=25\001"
+      "14=0\0016=0\00121=1\00158=COMMENT12\00110=240\001"
+      "8=FIX.4.4\0019=228\00135=8\00149=QWERTY_22345679\00156=BBCQWE_123\00134=34\00157=srv-ivanov_ii1\00152=20120716-06:00:16.230\00137=1\001"
+      "11=CL_ORD_ID_1234567\00117=FE_1_9494_2\001150=0\00139=1\0011=ZUN\00155=RTS-03.13\00154=1\00138=25\00144=135155\00159=0\00132=0\00131=0\001151=35\001"
+      "14=0\0016=0\00121=1\00158=COMMENT15\00110=133\001";
+   uint32_t const len = strlen(buff);
+
+   for(uint32_t chunkSize = 1; chunkSize <= len; ++chunkSize) // every possible split of messages between chunks
+   {
+      uint32_t count = 0;
+      for(uint32_t pos = 0; pos < len; pos += chunkSize)
+      {
+         ASSERT_EQ(FIX_SUCCESS, fix_stream_parser_feed(sparser, buff + pos, (len - pos < chunkSize ? len - pos : chunkSize), &error));
+         FIXMsg* msg = NULL;
+         while((msg = fix_stream_parser_next(sparser, &error)))
+         {
+            ASSERT_TRUE(error == NULL);
+            CHECK_STRING(msg, NULL, FIXFieldTag_SenderCompID, count == 0 ? "QWERTY_12345678" : "QWERTY_22345679");
+            CHECK_STRING(msg, NULL, FIXFieldTag_Text, count == 0 ? "COMMENT12" : "COMMENT15");
+            fix_msg_free(msg);
+            ++count;
+         }
+         ASSERT_TRUE(error == NULL);
+      }
+      ASSERT_EQ(count, 2U);
+   }
+
+   char broken[] = "garbage\0018=FIX.4.4\0019=5\00135=0\00110=000\001";
+   ASSERT_EQ(FIX_SUCCESS, fix_stream_parser_feed(sparser, broken, strlen(broken), &error));
+   ASSERT_TRUE(fix_stream_parser_next(sparser, &error) == NULL);
+   ASSERT_EQ(error->code, FIX_ERROR_WRONG_FIELD);
+   fix_error_free(error);
+   error = NULL;
+   ASSERT_TRUE(fix_stream_parser_next(sparser, &error) == NULL);
+   ASSERT_EQ(error->code, FIX_ERROR_INTEGRITY_CHECK); // framed correctly, but CheckSum is wrong
+   fix_error_free(error);
+   error = NULL;
+   ASSERT_TRUE(fix_stream_parser_next(sparser, &error) == NULL);
+   ASSERT_TRUE(error == NULL);
+
+   char huge[] = "8=FIX.4.4\0019=400000000\00135=0\001"; // message is not buffered, stream resyncs at next BeginString
+   ASSERT_EQ(FIX_SUCCESS, fix_stream_parser_feed(sparser, huge, strlen(huge), &error));
+   ASSERT_TRUE(fix_stream_parser_next(sparser, &error) == NULL);
+   ASSERT_EQ(error->code, FIX_ERROR_TOO_BIG_MSG);
+   fix_error_free(error);
+   error = NULL;
+   ASSERT_TRUE(fix_stream_parser_next(sparser, &error) == NULL);
+   ASSERT_EQ(error->code, FIX_ERROR_WRONG_FIELD);
+   fix_error_free(error);
+   error = NULL;
+   ASSERT_TRUE(fix_stream_parser_next(sparser, &error) == NULL);
+   ASSERT_TRUE(error == NULL);
+   ASSERT_EQ(FIX_SUCCESS, fix_stream_parser_feed(sparser, buff, len, &error));
+   FIXMsg* msg = fix_stream_parser_next(sparser, &error);
+   ASSERT_TRUE(msg != NULL);
+   CHECK_STRING(msg, NULL, FIXFieldTag_Text, "COMMENT12");
+   fix_msg_free(msg);
+   msg = fix_stream_parser_next(sparser, &error);
+   ASSERT_TRUE(msg != NULL);
+   fix_msg_free(msg);
+   ASSERT_TRUE(fix_stream_parser_next(sparser, &error) == NULL);
+   ASSERT_TRUE(error == NULL);
+
+   ASSERT_EQ(FIX_SUCCESS, fix_stream_parser_feed(sparser, buff, len, &error));
+   ASSERT_EQ(FIX_FAILED, fix_stream_parser_feed(sparser, buff, len, &error));
+   fix_error_free(error);
+   error = NULL;
+
+   fix_stream_parser_free(sparser);
+   fix_parser_free(parser);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixParserTests, ParseMultipleMsgsTest)
+{
+   FIXError* error = NULL;
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   char buff[] = "8=FIX.4.4\0019=228\00135=8\00149=QWERTY_12345678\00156=ABCQWE_XYZ\00134=34\00157=srv-ivanov_ii1\00152=20120716-06:00:16.230\00137=1\001"
+      "11=CL_ORD_ID_1234567\00117=FE_1_9494_1\001150=0\00139=1\0011=ZUM\00155=RTS-12.12\00154=1\00138=25\00144=135155\00159=0\00132=0\00131=0\001151=25\001"
+      "14=0\0016=0\00121=1\00158=COMMENT12\00110=240\001"
+      "8=FIX.4.4\0019=5\00135=0\00110=000\001"    // wrong CheckSum
+      "8=FIX.4.4\0019=XYZ\00135=0\00110=000\001"  // broken message structure
+      "8=FIX.4.4\0019=228\00135=8\00149=QWERTY_22345679\00156=BBCQWE_123\00134=34\00157=srv-ivanov_ii1\00152=20120716-06:00:16.230\00137=1\001"
+      "11=CL_ORD_ID_1234567\00117=FE_1_9494_2\001150=0\00139=1\0011=ZUN\00155=RTS-03.13\00154=1\00138=25\00144=135155\00159=0\00132=0\00131=0\001151=35\001"
+      "14=0\0016=0\00121=1\00158=COMMENT15\00110=133\001"
+      "8=FIX.4.4\0019=228\00135=8\00149=QWE"; // incomplete message
+   FIXMsg* msgs[10] = {};
+   FIXError* errors[10] = {};
+   char const* stop = NULL;
+   uint32_t count = fix_parser_str_to_msgs(parser, buff, strlen(buff), FIX_SOH, msgs, errors, 10, &stop);
+   ASSERT_EQ(count, 4U);
+   ASSERT_TRUE(msgs[0] != NULL);
+   CHECK_STRING(msgs[0], NULL, FIXFieldTag_Text, "COMMENT12");
+   ASSERT_TRUE(msgs[1] == NULL);
+   ASSERT_EQ(errors[1]->code, FIX_ERROR_INTEGRITY_CHECK);
+   ASSERT_TRUE(msgs[2] == NULL);
+   ASSERT_TRUE(errors[2] != NULL);
+   ASSERT_TRUE(msgs[3] != NULL);
+   ASSERT_TRUE(errors[3] == NULL);
+   CHECK_STRING(msgs[3], NULL, FIXFieldTag_Text, "COMMENT15");
+   ASSERT_EQ(0, strcmp(stop, "8=FIX.4.4\0019=228\00135=8\00149=QWE"));
+   for(uint32_t i = 0; i < count; ++i)
+   {
+      fix_msg_free(msgs[i]);
+      fix_error_free(errors[i]);
+   }
+
+   count = fix_parser_str_to_msgs(parser, buff, strlen(buff), FIX_SOH, msgs, NULL, 2, &stop);
+   ASSERT_EQ(count, 2U);
+   ASSERT_EQ(0, strncmp(stop, "8=FIX.4.4\0019=XYZ", 15));
+   fix_msg_free(msgs[0]);
+
+   fix_parser_free(parser);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+struct LogStat
+{
+   int64_t count;
+   int64_t failed;
+   int64_t seqNumSum;
+   int64_t lastSeqNum;
+   int32_t inOrder;
+   int32_t ordered;
+};
+
+static void log_callback(FIXMsg* msg, FIXError* error, void* userData)
+{
+   LogStat* stat = (LogStat*)userData;
+   __sync_fetch_and_add(&stat->count, 1);
+   if (!msg)
+   {
+      __sync_fetch_and_add(&stat->failed, 1);
+      return;
+   }
+   int64_t seqNum = 0;
+   fix_msg_get_int64(msg, NULL, FIXFieldTag_MsgSeqNum, &seqNum, &error);
+   __sync_fetch_and_add(&stat->seqNumSum, seqNum);
+   if (stat->ordered) // callback is called from one thread at a time only in ordered mode
+   {
+      if (seqNum != stat->lastSeqNum + 1)
+      {
+         stat->inOrder = 0;
+      }
+      stat->lastSeqNum = seqNum;
+   }
+}
+
+TEST(FixParserTests, ParseLogTest)
+{
+   FIXError* error = NULL;
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+
+   int64_t const count = 40000; // about 10Mb, so data is split by several chunks
+   uint32_t const size = count * 256;
+   char* buff = (char*)malloc(size);
+   uint32_t len = 0;
+   uint32_t brokenPos = 0;
+   for(int64_t i = 1; i <= count; ++i)
+   {
+      brokenPos = (i == 100) ? len : brokenPos;
+      FIXMsg* msg = fix_msg_create(parser, "D", &error);
+      ASSERT_TRUE(msg != NULL);
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, NULL, FIXFieldTag_SenderCompID, "QWERTY_12345678", &error));
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, NULL, FIXFieldTag_TargetCompID, "ABCQWE_XYZ", &error));
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_set_int64(msg, NULL, FIXFieldTag_MsgSeqNum, i, &error));
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, NULL, FIXFieldTag_SendingTime, "20120716-06:00:16.230", &error));
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, NULL, FIXFieldTag_ClOrdID, "CL_ORD_ID_1234567", &error));
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_set_char(msg, NULL, FIXFieldTag_HandlInst, '1', &error));
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, NULL, FIXFieldTag_Symbol, "RTS-12.12", &error));
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_set_char(msg, NULL, FIXFieldTag_Side, '1', &error));
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, NULL, FIXFieldTag_TransactTime, "20120716-06:00:16.230", &error));
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_set_double(msg, NULL, FIXFieldTag_OrderQty, 25, &error));
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_set_char(msg, NULL, FIXFieldTag_OrdType, '2', &error));
+      uint32_t reqBuffLen = 0;
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_to_str(msg, FIX_SOH, buff + len, size - len, &reqBuffLen, &error));
+      len += reqBuffLen;
+      fix_msg_free(msg);
+   }
+   int64_t const seqNumSum = count * (count + 1) / 2;
+
+   LogStat stat = {0, 0, 0, 0, 1, 1};
+   ASSERT_EQ(FIX_SUCCESS, fix_parser_parse_log(parser, buff, len, FIX_SOH, 4, 1, &log_callback, &stat, &error));
+   ASSERT_EQ(stat.count, count);
+   ASSERT_EQ(stat.failed, 0);
+   ASSERT_EQ(stat.seqNumSum, seqNumSum);
+   ASSERT_EQ(stat.inOrder, 1);
+
+   LogStat stat1 = {0, 0, 0, 0, 1, 0};
+   ASSERT_EQ(FIX_SUCCESS, fix_parser_parse_log(parser, buff, len - 10, FIX_SOH, 4, 0, &log_callback, &stat1, &error));
+   ASSERT_EQ(stat1.count, count);
+   ASSERT_EQ(stat1.failed, 1); // last message is incomplete
+   ASSERT_EQ(stat1.seqNumSum, seqNumSum - count);
+
+   // BodyLength of message in the middle of chunk exceeds the chunk, only this message is lost
+   char* broken = (char*)malloc(size + 16);
+   char const* body = (char const*)memchr(buff + brokenPos, '\001', len - brokenPos) + 1; // BodyLength
+   body = (char const*)memchr(body, '\001', buff + len - body); // delimiter after BodyLength
+   char const brokenHeader[] = "8=FIX.4.4\0019=99999999";
+   memcpy(broken, buff, brokenPos);
+   memcpy(broken + brokenPos, brokenHeader, sizeof(brokenHeader) - 1);
+   uint32_t const tail = buff + len - body;
+   memcpy(broken + brokenPos + sizeof(brokenHeader) - 1, body, tail);
+   uint32_t const brokenLen = brokenPos + sizeof(brokenHeader) - 1 + tail;
+   LogStat stat2 = {0, 0, 0, 0, 1, 0};
+   ASSERT_EQ(FIX_SUCCESS, fix_parser_parse_log(parser, broken, brokenLen, FIX_SOH, 4, 0, &log_callback, &stat2, &error));
+   ASSERT_EQ(stat2.count, count);
+   ASSERT_EQ(stat2.failed, 1);
+   ASSERT_EQ(stat2.seqNumSum, seqNumSum - 100);
+   free(broken);
+
+   free(buff);
+   fix_parser_free(parser);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixParserTests, SharedProtocolTest)
+{
+   FIXError* error = NULL;
+   FIXProtocolDescr const* protocol = fix_protocol_create("fix_descr/fix.4.4.xml", &error);
+   ASSERT_TRUE(protocol != NULL);
+   ASSERT_EQ(protocol->ref_count, 1);
+
+   FIXParser* parser1 = fix_parser_create_from_protocol(protocol, NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser1 != NULL);
+   FIXParser* parser2 = fix_parser_create_from_protocol(fix_parser_get_protocol(parser1), NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser2 != NULL);
+   ASSERT_EQ(fix_parser_get_protocol(parser1), protocol);
+   ASSERT_EQ(fix_parser_get_protocol(parser2), protocol);
+   ASSERT_EQ(protocol->ref_count, 3);
+   ASSERT_STREQ(fix_parser_get_protocol_ver(parser2), "FIX.4.4");
+
+   fix_protocol_free(protocol); // parsers still hold the protocol
+   ASSERT_EQ(protocol->ref_count, 2);
+
+   char buff[] = "8=FIX.4.4|9=228|35=8|49=QWERTY_12345678|56=ABCQWE_XYZ|34=34|57=srv-ivanov_ii1|52=20120716-06:00:16.230|"
+      "37=1|11=CL_ORD_ID_1234567|17=FE_1_9494_1|150=0|39=1|1=ZUM|55=RTS-12.12|54=1|38=25|44=135155|59=0|32=0|31=0|151=25|"
+      "14=0|6=0|21=1|58=COMMENT12|10=110|";
+   char const* stop = NULL;
+   FIXMsg* msg1 = fix_parser_str_to_msg(parser1, buff, strlen(buff), '|', &stop, &error);
+   ASSERT_TRUE(msg1 != NULL);
+   FIXMsg* msg2 = fix_parser_str_to_msg(parser2, buff, strlen(buff), '|', &stop, &error);
+   ASSERT_TRUE(msg2 != NULL);
+   ASSERT_EQ(parser1->used_pages, 1U);
+   ASSERT_EQ(parser2->used_pages, 1U);
+   fix_msg_free(msg1);
+   fix_msg_free(msg2);
+
+   fix_parser_free(parser1);
+   ASSERT_EQ(protocol->ref_count, 1);
+   fix_parser_free(parser2);
+
+   ASSERT_TRUE(fix_parser_create_from_protocol(NULL, NULL, 0, &error) == NULL);
+   ASSERT_EQ(error->code, FIX_ERROR_INVALID_ARGUMENT);
+   fix_error_free(error);
+}
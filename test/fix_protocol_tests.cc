@@ -8,8 +8,10 @@
 #include  <fix_parser_priv.h>
 #include  <fix_protocol_descr.h>
 #include  <fix_field_tag.h>
+#include  <fix44_protocol.h>
 
 #include  <gtest/gtest.h>
+#include  <vector>
 
 TEST(FIXProtocolTests, FIXProtocolTest1)
 {
@@ -99,12 +101,20 @@ TEST(FIXProtocolTests, FIXProtocolTest1)
    ASSERT_TRUE(field != NULL);
    ASSERT_EQ(1, fix_protocol_check_field_value(field, "10", 2));
    ASSERT_EQ(0, fix_protocol_check_field_value(field, "100", 3));
+   ASSERT_EQ(1, fix_protocol_check_field_value(field, "1", 1));
+   ASSERT_EQ(0, fix_protocol_check_field_value(field, "A", 1));
+   ASSERT_EQ(0, fix_protocol_check_field_value(field, "", 0));
 
    field = fix_protocol_get_field_descr(msg, FIXFieldTag_SecurityType);
    ASSERT_TRUE(field != NULL);
    ASSERT_EQ(0, fix_protocol_check_field_value(field, "FAKE", 4));
    ASSERT_EQ(1, fix_protocol_check_field_value(field, "DEFLTED", 7));
    ASSERT_EQ(1, fix_protocol_check_field_value(field, "YANK", 4));
+   for(uint32_t len = 1; len < 7; ++len) // prefix of correct value is not correct
+   {
+      ASSERT_EQ(0, fix_protocol_check_field_value(field, "DEFLTED", len)) << len;
+   }
+   ASSERT_EQ(0, fix_protocol_check_field_value(field, "YANKS", 5));
 
    fix_parser_free(p);
 }
@@ -144,7 +154,7 @@ TEST(FIXProtocolTests, FIXProtocolTest2)
 TEST(FIXProtocolTests, FIXProtocolTest3)
 {
    FIXError* error = NULL;
-   FIXParser* p = fix_parser_create("./test_data/fix2.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   FIXParser* p = fix_parser_create("test/test_data/fix2.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
    ASSERT_TRUE(p != NULL);
    ASSERT_TRUE(fix_protocol_get_msg_descr(p, "8", &error) != NULL);
    ASSERT_TRUE(error == NULL);
@@ -217,3 +227,288 @@ TEST(FIXProtocolTests, FIXProtocolTest3)
 
    fix_parser_free(p);
 }
+
+TEST(FIXProtocolTests, ComponentTest)
+{
+   FIXError* error = NULL;
+   FIXProtocolDescr const* prot = fix_protocol_create("test/test_data/fix4.xml", &error); // component includes itself
+   ASSERT_TRUE(prot == NULL);
+   ASSERT_TRUE(error != NULL);
+   ASSERT_EQ(error->code, FIX_ERROR_WRONG_FIELD);
+   fix_error_free(error);
+   error = NULL;
+
+   FIXParser* p = fix_parser_create("test/test_data/fix3.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(p != NULL);
+   FIXMsgDescr const* msg = fix_protocol_get_msg_descr(p, "D", &error);
+   ASSERT_TRUE(msg != NULL);
+
+   // nested components are flattened in XML order
+   FIXTagNum const tags[] = {
+      FIXFieldTag_BeginString, FIXFieldTag_BodyLength, FIXFieldTag_MsgType, FIXFieldTag_ClOrdID, FIXFieldTag_Symbol,
+      FIXFieldTag_UnderlyingSymbol, FIXFieldTag_UnderlyingSecurityID, FIXFieldTag_NoSecurityAltID, FIXFieldTag_SecurityID,
+      FIXFieldTag_SignatureLength, FIXFieldTag_Signature, FIXFieldTag_CheckSum};
+   ASSERT_EQ(msg->field_count, sizeof(tags) / sizeof(tags[0]));
+   for(uint32_t i = 0; i < msg->field_count; ++i)
+   {
+      ASSERT_EQ(msg->fields[i].type->tag, tags[i]) << i;
+      ASSERT_EQ(fix_protocol_get_field_descr(msg, tags[i]), &msg->fields[i]);
+   }
+   ASSERT_EQ(msg->fields[4].flags, FIELD_FLAG_REQUIRED);
+   ASSERT_EQ(msg->fields[5].flags, 0);
+
+   // Data field is linked with Length field, which precedes component
+   FIXFieldDescr const* field = fix_protocol_get_field_descr(msg, FIXFieldTag_Signature);
+   ASSERT_TRUE(field != NULL);
+   ASSERT_EQ(field->dataLenField, fix_protocol_get_field_descr(msg, FIXFieldTag_SignatureLength));
+
+   FIXFieldDescr const* group = fix_protocol_get_field_descr(msg, FIXFieldTag_NoSecurityAltID);
+   ASSERT_TRUE(group != NULL);
+   ASSERT_EQ(group->category, FIXFieldCategory_Group);
+   ASSERT_EQ(group->group_count, 3U);
+   ASSERT_EQ(group->group[0].type->tag, FIXFieldTag_SecurityAltID);
+   ASSERT_EQ(group->group[1].type->tag, FIXFieldTag_RawDataLength);
+   ASSERT_EQ(group->group[2].type->tag, FIXFieldTag_RawData);
+   ASSERT_EQ(group->group[2].dataLenField, &group->group[1]);
+   ASSERT_EQ(fix_protocol_get_group_descr(group, FIXFieldTag_RawData), &group->group[2]);
+
+   fix_parser_free(p);
+}
+
+static void scan_fields(FIXFieldDescr const* fields, uint32_t count, std::vector<FIXFieldDescr const*>& byTag)
+{
+   byTag.assign(byTag.size(), NULL);
+   for(uint32_t i = count; i > 0; --i) // first description of tag wins
+   {
+      byTag[fields[i - 1].type->tag] = &fields[i - 1];
+   }
+}
+
+static void check_group_index(FIXFieldDescr const* group, uint32_t tagCount)
+{
+   std::vector<FIXFieldDescr const*> byTag(tagCount + 1);
+   scan_fields(group->group, group->group_count, byTag);
+   for(uint32_t tag = 0; tag <= tagCount; ++tag) // tagCount is not described by protocol
+   {
+      ASSERT_EQ(fix_protocol_get_group_descr(group, tag), byTag[tag]) << group->type->name << " " << tag;
+   }
+   for(uint32_t i = 0; i < group->group_count; ++i)
+   {
+      if (group->group[i].group_count)
+      {
+         check_group_index(&group->group[i], tagCount);
+      }
+   }
+}
+
+static void check_field_index(char const* protFile)
+{
+   FIXError* error = NULL;
+   FIXProtocolDescr const* prot = fix_protocol_create(protFile, &error);
+   ASSERT_TRUE(prot != NULL);
+   std::vector<FIXFieldDescr const*> byTag(prot->tag_types_count + 1);
+   for(uint32_t i = 0; i < MSG_CNT; ++i)
+   {
+      for(FIXMsgDescr const* msg = prot->messages[i]; msg; msg = msg->next)
+      {
+         scan_fields(msg->fields, msg->field_count, byTag);
+         for(uint32_t tag = 0; tag <= prot->tag_types_count; ++tag)
+         {
+            ASSERT_EQ(fix_protocol_get_field_descr(msg, tag), byTag[tag]) << protFile << " " << msg->name << " " << tag;
+         }
+         for(uint32_t j = 0; j < msg->field_count; ++j)
+         {
+            if (msg->fields[j].group_count)
+            {
+               check_group_index(&msg->fields[j], prot->tag_types_count);
+            }
+         }
+      }
+   }
+   fix_protocol_free(prot);
+}
+
+TEST(FIXProtocolTests, FieldIndexTest)
+{
+   check_field_index("fix_descr/fix.4.2.xml");
+   check_field_index("fix_descr/fix.4.3.xml");
+   check_field_index("fix_descr/fix.4.4.xml");
+   check_field_index("fix_descr/fix.5.0.xml");
+   check_field_index("fix_descr/fix.5.0.sp1.xml");
+   check_field_index("fix_descr/fix.5.0.sp2.xml");
+   check_field_index("fix_descr/fixt.1.1.xml");
+}
+
+static void check_fields(FIXFieldDescr const* fields, FIXFieldDescr const* ifields, uint32_t count)
+{
+   for(uint32_t i = 0; i < count; ++i)
+   {
+      FIXFieldDescr const* fld = &fields[i];
+      FIXFieldDescr const* ifld = &ifields[i];
+      ASSERT_EQ(fld->type->tag, ifld->type->tag);
+      ASSERT_STREQ(fld->type->name, ifld->type->name);
+      ASSERT_EQ(fld->type->valueType, ifld->type->valueType);
+      ASSERT_EQ(fld->type->prefix_crc, ifld->type->prefix_crc);
+      ASSERT_EQ(fld->category, ifld->category);
+      ASSERT_EQ(fld->flags, ifld->flags);
+      ASSERT_EQ(fld->dataLenField ? fld->dataLenField - fields : -1, ifld->dataLenField ? ifld->dataLenField - ifields : -1);
+      ASSERT_EQ(fld->type->values == NULL, ifld->type->values == NULL);
+      for(uint32_t j = 0; fld->type->values && j < fld->type->values->count; ++j)
+      {
+         char const* val = fld->type->values->values[j];
+         ASSERT_EQ(1, fix_protocol_check_field_value(ifld, val, strlen(val))) << val;
+      }
+      ASSERT_EQ(fld->group_count, ifld->group_count);
+      if (fld->group_count)
+      {
+         ASSERT_EQ(fld->group_index_size, ifld->group_index_size);
+         for(uint32_t j = 0; j < REQUIRED_WORDS(fld->group_count); ++j)
+         {
+            ASSERT_EQ(fld->group_required[j], ifld->group_required[j]);
+         }
+         for(uint32_t j = 0; j < fld->group_count; ++j)
+         {
+            ASSERT_EQ(&ifld->group[j] - ifld->group,
+                  fix_protocol_get_group_descr(ifld, fld->group[j].type->tag) - ifld->group) << fld->group[j].type->name;
+         }
+         check_fields(fld->group, ifld->group, fld->group_count);
+      }
+   }
+}
+
+static void check_protocols(FIXProtocolDescr const* prot, FIXProtocolDescr const* iprot)
+{
+   ASSERT_STREQ(prot->version, iprot->version);
+   ASSERT_STREQ(prot->transportVersion, iprot->transportVersion);
+   ASSERT_EQ(prot->tag_types_count, iprot->tag_types_count);
+   for(uint32_t i = 0; i < prot->tag_types_count; ++i)
+   {
+      ASSERT_EQ(prot->tag_types[i] == NULL, iprot->tag_types[i] == NULL);
+      if (prot->tag_types[i])
+      {
+         ASSERT_STREQ(prot->tag_types[i]->name, iprot->tag_types[i]->name);
+      }
+   }
+   for(uint32_t i = 0; i < MSG_CNT; ++i)
+   {
+      FIXMsgDescr const* imsg = iprot->messages[i];
+      for(FIXMsgDescr const* msg = prot->messages[i]; msg; msg = msg->next, imsg = imsg->next)
+      {
+         ASSERT_TRUE(imsg != NULL);
+         ASSERT_STREQ(msg->type, imsg->type);
+         ASSERT_STREQ(msg->name, imsg->name);
+         ASSERT_EQ(msg->field_count, imsg->field_count);
+         ASSERT_EQ(msg->field_index_size, imsg->field_index_size);
+         for(uint32_t j = 0; j < REQUIRED_WORDS(msg->field_count); ++j)
+         {
+            ASSERT_EQ(msg->required[j], imsg->required[j]);
+         }
+         ASSERT_EQ(msg->data_len_count, imsg->data_len_count);
+         for(uint32_t j = 0; j < msg->data_len_count * 2; ++j)
+         {
+            ASSERT_EQ(msg->data_lens[j], imsg->data_lens[j]);
+         }
+         for(uint32_t j = 0; j < msg->field_count; ++j)
+         {
+            ASSERT_EQ(fix_protocol_get_field_descr(msg, msg->fields[j].type->tag) - msg->fields,
+                  fix_protocol_get_field_descr(imsg, msg->fields[j].type->tag) - imsg->fields);
+         }
+         check_fields(msg->fields, imsg->fields, msg->field_count);
+      }
+      ASSERT_TRUE(imsg == NULL);
+   }
+}
+
+static void check_image(char const* protFile)
+{
+   FIXError* error = NULL;
+   FIXProtocolDescr const* prot = fix_protocol_create(protFile, &error);
+   ASSERT_TRUE(prot != NULL);
+   ASSERT_EQ(FIX_SUCCESS, fix_protocol_save_image(prot, "fix_protocol_tests.img", &error));
+   FIXProtocolDescr const* iprot = fix_protocol_create_from_image("fix_protocol_tests.img", &error);
+   ASSERT_TRUE(iprot != NULL);
+   check_protocols(prot, iprot);
+   fix_protocol_free(iprot);
+   fix_protocol_free(prot);
+   remove("fix_protocol_tests.img");
+}
+
+TEST(FIXProtocolTests, ImageTest)
+{
+   check_image("fix_descr/fix.4.4.xml");
+   check_image("fix_descr/fix.5.0.sp2.xml");
+}
+
+TEST(FIXProtocolTests, ImageParserTest)
+{
+   FIXError* error = NULL;
+   FIXProtocolDescr const* prot = fix_protocol_create("fix_descr/fix.4.4.xml", &error);
+   ASSERT_TRUE(prot != NULL);
+   ASSERT_EQ(FIX_SUCCESS, fix_protocol_save_image(prot, "fix_protocol_tests.img", &error));
+   fix_protocol_free(prot);
+
+   FIXParser* parser = fix_parser_create_from_image("fix_protocol_tests.img", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   ASSERT_STREQ("FIX.4.4", fix_parser_get_protocol_ver(parser));
+   char buff[] = "8=FIX.4.4\0019=228\00135=8\00149=QWERTY_12345678\00156=ABCQWE_XYZ\00134=34\00157=srv-ivanov_ii1\00152=20120716-06:00:16.230\00137=1\001"
+      "11=CL_ORD_ID_1234567\00117=FE_1_9494_1\001150=0\00139=1\0011=ZUM\00155=RTS-12.12\00154=1\00138=25\00144=135155\00159=0\00132=0\00131=0\001151=25\001"
+      "14=0\0016=0\00121=1\00158=COMMENT12\00110=240\001";
+   char const* stop = NULL;
+   FIXMsg* msg = fix_parser_str_to_msg(parser, buff, strlen(buff), FIX_SOH, &stop, &error);
+   ASSERT_TRUE(msg != NULL);
+   char buff1[1024];
+   uint32_t reqBuffLen = 0;
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_to_str(msg, FIX_SOH, buff1, sizeof(buff1), &reqBuffLen, &error));
+   buff1[reqBuffLen] = 0;
+   ASSERT_STREQ(buff, buff1);
+   fix_msg_free(msg);
+   fix_parser_free(parser);
+
+   FILE* f = fopen("fix_protocol_tests.img", "r+b"); // broken image is rejected
+   ASSERT_TRUE(f != NULL);
+   fputc('X', f);
+   fclose(f);
+   ASSERT_TRUE(fix_parser_create_from_image("fix_protocol_tests.img", NULL, PARSER_FLAG_CHECK_ALL, &error) == NULL);
+   ASSERT_EQ(FIX_ERROR_PROTOCOL_IMAGE_LOAD_FAILED, fix_error_get_code(error));
+   fix_error_free(error);
+   remove("fix_protocol_tests.img");
+
+   error = NULL;
+   ASSERT_TRUE(fix_parser_create_from_image("no_such_file.img", NULL, PARSER_FLAG_CHECK_ALL, &error) == NULL);
+   ASSERT_EQ(FIX_ERROR_PROTOCOL_IMAGE_LOAD_FAILED, fix_error_get_code(error));
+   fix_error_free(error);
+}
+
+TEST(FIXProtocolTests, StaticProtocolTest)
+{
+   FIXError* error = NULL;
+   FIXProtocolDescr const* prot = fix_protocol_create("fix_descr/fix.4.4.xml", &error);
+   ASSERT_TRUE(prot != NULL);
+   check_protocols(prot, fix44_protocol());
+   fix_protocol_free(prot);
+
+   FIXParser* parser = fix_parser_create_from_protocol(fix44_protocol(), NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   ASSERT_TRUE(fix_protocol_get_msg_descr(parser, "AE", &error) != NULL);
+   ASSERT_TRUE(fix_protocol_get_msg_descr(parser, "A", &error) != NULL);
+   ASSERT_TRUE(fix_protocol_get_msg_descr(parser, "AEX", &error) == NULL);
+   ASSERT_EQ(FIX_ERROR_UNKNOWN_MSG, fix_error_get_code(error));
+   fix_error_free(error);
+   error = NULL;
+   char buff[] = "8=FIX.4.4\0019=228\00135=8\00149=QWERTY_12345678\00156=ABCQWE_XYZ\00134=34\00157=srv-ivanov_ii1\00152=20120716-06:00:16.230\00137=1\001"
+      "11=CL_ORD_ID_1234567\00117=FE_1_9494_1\001150=0\00139=1\0011=ZUM\00155=RTS-12.12\00154=1\00138=25\00144=135155\00159=0\00132=0\00131=0\001151=25\001"
+      "14=0\0016=0\00121=1\00158=COMMENT12\00110=240\001";
+   char const* stop = NULL;
+   FIXMsg* msg = fix_parser_str_to_msg(parser, buff, strlen(buff), FIX_SOH, &stop, &error);
+   ASSERT_TRUE(msg != NULL);
+   char buff1[1024];
+   uint32_t reqBuffLen = 0;
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_to_str(msg, FIX_SOH, buff1, sizeof(buff1), &reqBuffLen, &error));
+   buff1[reqBuffLen] = 0;
+   ASSERT_STREQ(buff, buff1);
+   fix_msg_free(msg);
+   fix_parser_free(parser); // static description survives its last parser
+   parser = fix_parser_create_from_protocol(fix44_protocol(), NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   fix_parser_free(parser);
+}
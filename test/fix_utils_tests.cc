@@ -10,6 +10,8 @@ extern "C"
 #include <fix_types.h>
 }
 #include <gtest/gtest.h>
+#include <math.h>
+#include <stdlib.h>
 
 TEST(FixUtilsTests, i64toa_Test)
 {
@@ -65,6 +67,106 @@ TEST(FixUtilsTests, dtoa_Test)
    ASSERT_STREQ("-AAAAAAAA", buff5);
 }
 
+TEST(FixUtilsTests, i64toa_Range_Test)
+{
+   int64_t const values[] = {0, 1, 9, 10, 99, 100, 101, 12345, -1, -10, -99999, 2147483647LL, -2147483648LL,
+      1000000000000000000LL, 9223372036854775807LL, -9223372036854775807LL - 1};
+   for(uint32_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+   {
+      char expected[32] = {};
+      char buff[32] = {};
+      int32_t const len = sprintf(expected, "%lld", (long long)values[i]);
+      ASSERT_EQ(fix_utils_i64toa(values[i], buff, sizeof(buff), 0), len);
+      ASSERT_STREQ(expected, buff);
+   }
+   char buff[32] = {};
+   ASSERT_EQ(fix_utils_i64toa(7, buff, 3, '0'), 3);
+   ASSERT_STREQ("007", buff);
+}
+
+TEST(FixUtilsTests, dtoa_Shortest_Test)
+{
+   struct { double val; char const* str; } const values[] =
+   {
+      {0.0, "0"}, {-0.0, "0"}, {1.0, "1"}, {0.1, "0.1"}, {0.1 + 0.2, "0.30000000000000004"}, {135155.5, "135155.5"},
+      {-1.25, "-1.25"}, {1e-7, "0.0000001"}, {123456789.123, "123456789.123"}, {1e20, "100000000000000000000"},
+      {9007199254740993.0, "9007199254740992"}, {5e-324, NULL}, {1.7976931348623157e308, NULL}
+   };
+   for(uint32_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+   {
+      char buff[1024] = {};
+      int32_t const len = fix_utils_dtoa(values[i].val, buff, sizeof(buff));
+      ASSERT_EQ(len, (int32_t)strlen(buff));
+      if (values[i].str)
+      {
+         ASSERT_STREQ(values[i].str, buff);
+      }
+      ASSERT_EQ(strtod(buff, NULL), values[i].val) << buff;
+   }
+   srand(1977);
+   for(int32_t i = 0; i < 100000; ++i)
+   {
+      double const val = ((double)rand() / RAND_MAX - 0.5) * pow(10.0, rand() % 20 - 8);
+      char buff[1024] = {};
+      fix_utils_dtoa(val, buff, sizeof(buff));
+      ASSERT_EQ(strtod(buff, NULL), val) << buff;
+      char const* point = strchr(buff, '.');
+      if (point) // one fraction digit less must not be enough
+      {
+         char shorter[1024] = {};
+         sprintf(shorter, "%.*f", (int)(strlen(point + 1) - 1), val);
+         ASSERT_NE(strtod(shorter, NULL), val) << buff;
+      }
+   }
+}
+
+TEST(FixUtilsTests, dtoa_Fixed_Test)
+{
+   char buff[32] = {};
+   ASSERT_EQ(fix_utils_dtoa_fixed(135155.5, 2, buff, sizeof(buff)), 9);
+   ASSERT_STREQ("135155.50", buff);
+
+   char buff1[32] = {};
+   ASSERT_EQ(fix_utils_dtoa_fixed(1.25, 1, buff1, sizeof(buff1)), 3);
+   ASSERT_STREQ("1.3", buff1);
+
+   char buff2[32] = {};
+   ASSERT_EQ(fix_utils_dtoa_fixed(-0.05, 3, buff2, sizeof(buff2)), 6);
+   ASSERT_STREQ("-0.050", buff2);
+
+   char buff3[32] = {};
+   ASSERT_EQ(fix_utils_dtoa_fixed(-0.001, 2, buff3, sizeof(buff3)), 4);
+   ASSERT_STREQ("0.00", buff3);
+
+   char buff4[32] = {};
+   ASSERT_EQ(fix_utils_dtoa_fixed(42.0, 0, buff4, sizeof(buff4)), 2);
+   ASSERT_STREQ("42", buff4);
+
+   char buff5[10] = {"AAAAAAAAA"};
+   ASSERT_EQ(fix_utils_dtoa_fixed(12.5, 4, buff5, 3), 7);
+   ASSERT_STREQ("12.AAAAAA", buff5);
+
+   char buff6[32] = {};
+   ASSERT_EQ(fix_utils_dtoa_fixed(641415230841.57507, 5, buff6, sizeof(buff6)), 18);
+   ASSERT_STREQ("641415230841.57507", buff6);
+
+   srand(19);
+   for(int32_t i = 0; i < 100000; ++i) // scaled value doesn't fit mantissa, digits are the same as printf ones
+   {
+      uint32_t const precision = rand() % 8;
+      double const val = (double)((int64_t)rand() * rand()) / (1 + rand() % 997) * 1000;
+      if (val * pow(10, precision) < 9007199254740992.0) // smaller values are rounded half up
+      {
+         continue;
+      }
+      char expected[64] = {};
+      snprintf(expected, sizeof(expected), "%.*f", precision, val);
+      char str[64] = {};
+      int32_t const len = fix_utils_dtoa_fixed(val, precision, str, sizeof(str));
+      ASSERT_EQ(len, (int32_t)strlen(expected));
+      ASSERT_STREQ(expected, str);
+   }
+}
 
 TEST(FixUtilsTests, atoi32_Test)
 {
@@ -305,6 +407,100 @@ TEST(FixUtilsTests, atod_Test)
    }
 }
 
+TEST(FixUtilsTests, atoi_Lengths_Test)
+{
+   char const digits[] = "1234567890123456789";
+   for(uint32_t len = 1; len < sizeof(digits); ++len)
+   {
+      char str[32] = {};
+      memcpy(str, digits, len);
+      int64_t expected = strtoll(str, NULL, 10);
+      str[len] = '\001';
+      int64_t val = 0;
+      int32_t cnt = 0;
+      ASSERT_EQ(fix_utils_atoi64(str, len + 1, FIX_SOH, &val, &cnt), FIX_SUCCESS);
+      ASSERT_EQ(cnt, (int32_t)len);
+      ASSERT_EQ(val, expected);
+      ASSERT_EQ(fix_utils_atoi64(str, len, FIX_SOH, &val, &cnt), FIX_ERROR_NO_MORE_DATA);
+      ASSERT_EQ(cnt, (int32_t)len);
+      ASSERT_EQ(val, 0);
+      ASSERT_EQ(fix_utils_atoi64(str, len, 0, &val, &cnt), FIX_SUCCESS);
+      ASSERT_EQ(val, expected);
+      if (len < 10)
+      {
+         int32_t val32 = 0;
+         ASSERT_EQ(fix_utils_atoi32(str, len + 1, FIX_SOH, &val32, &cnt), FIX_SUCCESS);
+         ASSERT_EQ(val32, expected);
+      }
+      for(uint32_t bad = 0; bad < len; ++bad)
+      {
+         char tmp[32] = {};
+         memcpy(tmp, str, len + 1);
+         tmp[bad] = 'x';
+         ASSERT_EQ(fix_utils_atoi64(tmp, len + 1, FIX_SOH, &val, &cnt), FIX_ERROR_INVALID_ARGUMENT);
+         ASSERT_EQ(cnt, (int32_t)bad);
+         tmp[bad] = 0;
+         ASSERT_EQ(val, bad ? strtoll(tmp, NULL, 10) : 0);
+      }
+   }
+}
+
+TEST(FixUtilsTests, atod_Exact_Test)
+{
+   srand(17);
+   for(int32_t i = 0; i < 100000; ++i)
+   {
+      char str[64] = {};
+      int32_t len = sprintf(str, "%d.%0*d", rand() % 1000000, 1 + rand() % 8, rand() % 100000000);
+      str[len] = '\001';
+      double val = 0;
+      int32_t cnt = 0;
+      ASSERT_EQ(fix_utils_atod(str, len + 1, FIX_SOH, &val, &cnt), FIX_SUCCESS);
+      ASSERT_EQ(cnt, len);
+      ASSERT_EQ(val, strtod(str, NULL)) << str;
+   }
+   for(int32_t i = 0; i < 1000000; ++i) // values written by dtoa are read back exactly
+   {
+      double const expected = (double)((int64_t)rand() * rand() % 100000000000LL) / (1 + rand() % 997);
+      char str[64] = {};
+      int32_t const len = fix_utils_dtoa(expected, str, sizeof(str));
+      double val = 0;
+      int32_t cnt = 0;
+      ASSERT_EQ(fix_utils_atod(str, len, 0, &val, &cnt), FIX_SUCCESS);
+      ASSERT_EQ(cnt, len);
+      ASSERT_EQ(val, expected) << str;
+   }
+   {
+      char str[] = "9007199254740993.5"; // above 2^53 mantissa isn't exact
+      double val = 0;
+      int32_t cnt = 0;
+      ASSERT_EQ(fix_utils_atod(str, strlen(str), 0, &val, &cnt), FIX_SUCCESS);
+      ASSERT_EQ(val, strtod(str, NULL));
+   }
+   {
+      char str[] = "0.00000000000000000000000123";
+      double val = 0;
+      int32_t cnt = 0;
+      ASSERT_EQ(fix_utils_atod(str, strlen(str), 0, &val, &cnt), FIX_SUCCESS);
+      ASSERT_EQ(val, strtod(str, NULL));
+   }
+   {
+      char str[] = "123456789012345678901.5";
+      double val = 0;
+      int32_t cnt = 0;
+      ASSERT_EQ(fix_utils_atod(str, strlen(str), 0, &val, &cnt), FIX_SUCCESS);
+      ASSERT_EQ(cnt, 23);
+      ASSERT_EQ(val, 123456789012345678901.5);
+   }
+   {
+      char str[] = "12.3x4";
+      double val = 0;
+      int32_t cnt = 0;
+      ASSERT_EQ(fix_utils_atod(str, strlen(str), 0, &val, &cnt), FIX_FAILED);
+      ASSERT_EQ(cnt, 4);
+   }
+}
+
 TEST(FixUtilsTests, MakePath)
 {
    char path[2024];
@@ -328,3 +524,28 @@ TEST(FixUtilsTests, MakePath)
    ASSERT_EQ(fix_utils_make_path("../../test/fix.4.4.xml", "./fixt.1.1.xml", path3, sizeof(path3)), FIX_SUCCESS);
    ASSERT_STREQ(path, "./fixt.1.1.xml");
 }
+
+TEST(FixUtilsTests, FindChar)
+{
+   char str[] = "8=FIX.4.4\0019=228\00135=8\00149=QWERTY_12345678\00156=ABCQWE_XYZ\00134=34\00157=srv-ivanov_ii1\001"
+      "52=20120716-06:00:16.230\00137=1\00111=CL_ORD_ID_1234567\00117=FE_1_9494_1\001150=0\001";
+   uint32_t const len = strlen(str);
+   int32_t const level = fix_utils_simd_level();
+   for(int32_t l = FIX_SIMD_NONE; l <= FIX_SIMD_AVX2; ++l)
+   {
+      if (fix_utils_set_simd_level(l) != l)
+      {
+         continue;
+      }
+      for(uint32_t i = 0; i < len; ++i)
+      {
+         char const* expected = (char const*)memchr(str + i, '\001', len - i);
+         ASSERT_EQ(fix_utils_find_char(str + i, len - i, '\001'), expected);
+         expected = (char const*)memchr(str + i, '=', len - i);
+         ASSERT_EQ(fix_utils_find_char(str + i, len - i, '='), expected);
+      }
+      ASSERT_EQ(fix_utils_find_char(str, len, '|'), (char const*)NULL);
+      ASSERT_EQ(fix_utils_find_char(str, 0, '8'), (char const*)NULL);
+   }
+   ASSERT_EQ(fix_utils_set_simd_level(level), level);
+}